@@ -214,5 +214,7 @@ void TIM6_DAC_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
-
+/* Les vecteurs EXTI (EXTI0..EXTI4, EXTI9_5, EXTI15_10) et ceux des périphériques pilotés par les wrappers
+ * ne sont pas définis ici : ils sont générés côté C++ par WRAPPER_BIND_IRQ (Libs/Wrappers/IrqBinding.hpp).
+ * Les vecteurs partagés EXTI9_5 / EXTI15_10 doivent être liés à Wrapper::GpioExtiDemux. */
 /* USER CODE END 1 */
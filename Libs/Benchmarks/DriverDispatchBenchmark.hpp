@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include "CycleCounter.hpp"
+#include "GpioDriver.hpp"
+#include "PwmDriver.hpp"
+#include "GpioStatic.hpp"
+#include "PwmStatic.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "PwmConfigPolicy.hpp"
+#include "GpioBenchmark.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Benchmark {
+
+	/*
+	 * @brief Coût de la répartition des appels driver, en cycles CPU par opération.
+	 * virtual* : appel via une interface virtuelle identique aux anciens IGpioDriver / IPwmDriver
+	 * static*  : même fonction du driver, appel résolu à la compilation (contrat par concept)
+	 * Les deux chemins exécutent le même code HAL : l'écart est le coût de l'indirection seule
+	 * (chargement vptr + entrée vtable + appel indirect, et perte de l'inlining).
+	 * *Bytes : taille d'un wrapper avec le driver en membre, sans et avec vptr.
+	 **/
+	struct DispatchBenchResult {
+		uint32_t iterations;
+		uint32_t virtualWrite;
+		uint32_t staticWrite;
+		uint32_t virtualToggle;
+		uint32_t staticToggle;
+		uint32_t virtualRead;
+		uint32_t staticRead;
+		uint32_t virtualDuty;
+		uint32_t staticDuty;
+		uint32_t gpioWrapperBytes;
+		uint32_t legacyGpioWrapperBytes;
+		uint32_t pwmWrapperBytes;
+		uint32_t legacyPwmWrapperBytes;
+	};
+
+	namespace Detail {
+		// Reproduction des anciennes interfaces virtuelles, pour la mesure uniquement.
+		struct LegacyGpioInterface {
+			virtual void write(GpioPort, uint16_t, GpioPinState) = 0;
+			virtual GpioPinState read(GpioPort, uint16_t) = 0;
+			virtual void toggle(GpioPort, uint16_t) = 0;
+			virtual ~LegacyGpioInterface() = default;
+		};
+
+		struct LegacyGpioDriver final : LegacyGpioInterface {
+			void write(GpioPort port, uint16_t pinMask, GpioPinState state) override { driver.write(port, pinMask, state); }
+			GpioPinState read(GpioPort port, uint16_t pinMask) override { return driver.read(port, pinMask); }
+			void toggle(GpioPort port, uint16_t pinMask) override { driver.toggle(port, pinMask); }
+			HalGpioDriver driver;
+		};
+
+		struct LegacyPwmInterface {
+			virtual void setDutyCycle(PwmTimerInstance, PwmTimerChannel, uint32_t) = 0;
+			virtual ~LegacyPwmInterface() = default;
+		};
+
+		struct LegacyPwmDriver final : LegacyPwmInterface {
+			void setDutyCycle(PwmTimerInstance timer, PwmTimerChannel channel, uint32_t pulse) override { driver.setDutyCycle(timer, channel, pulse); }
+			HalPwmDriver driver;
+		};
+
+		// Wrapper de même forme qu'avant : driver polymorphe en membre (vptr inclus)
+		template <typename LegacyDriver>
+		struct LegacyWrapper {
+			LegacyDriver driver;
+		};
+
+		// Cache le type dynamique au compilateur : l'appel reste virtuel, comme à travers une référence d'interface
+		template <typename T>
+		inline T* opaque(T* pointer) {
+			__asm volatile("" : "+r"(pointer));
+			return pointer;
+		}
+	}
+
+	/*
+	 * @brief Compare appel virtuel et appel statique sur une broche de sortie et un canal PWM initialisés ici.
+	 * Le chemin registre direct de GpioStatic est mesuré à part par run_gpio_benchmark().
+	 * À exécuter interruptions masquées pour des chiffres stables.
+	 **/
+	template <GpioConfigPolicy GpioConfig, PwmConfigPolicy PwmConfig>
+	DispatchBenchResult run_dispatch_benchmark(uint32_t iterations = 1000) {
+		static_assert(GpioConfig::CanSet && GpioConfig::CanToggle, "Le benchmark nécessite une broche en sortie");
+
+		if (!CycleCounter::is_enabled())
+			CycleCounter::enable();
+
+		Wrapper::GpioStatic<GpioConfig> pin;
+		pin.init();
+		Wrapper::PwmStatic<PwmConfig> pwm;
+		pwm.init();
+
+		HalGpioDriver gpioDriver;
+		HalPwmDriver pwmDriver;
+		Detail::LegacyGpioDriver legacyGpio;
+		Detail::LegacyPwmDriver legacyPwm;
+		Detail::LegacyGpioInterface* gpioInterface = Detail::opaque<Detail::LegacyGpioInterface>(&legacyGpio);
+		Detail::LegacyPwmInterface* pwmInterface = Detail::opaque<Detail::LegacyPwmInterface>(&legacyPwm);
+
+		volatile uint32_t sink = 0;
+		DispatchBenchResult result {};
+		result.iterations = iterations;
+
+		const uint32_t overhead = Detail::measure(iterations, 1, 0, [] {}) * iterations;
+
+		result.virtualWrite = Detail::measure(iterations, 2, overhead, [&] {
+			gpioInterface->write(GpioConfig::Port, GpioConfig::PinMask, GpioPinState::Set);
+			gpioInterface->write(GpioConfig::Port, GpioConfig::PinMask, GpioPinState::Reset);
+		});
+		result.staticWrite = Detail::measure(iterations, 2, overhead, [&] {
+			gpioDriver.write(GpioConfig::Port, GpioConfig::PinMask, GpioPinState::Set);
+			gpioDriver.write(GpioConfig::Port, GpioConfig::PinMask, GpioPinState::Reset);
+		});
+		result.virtualToggle = Detail::measure(iterations, 1, overhead, [&] {
+			gpioInterface->toggle(GpioConfig::Port, GpioConfig::PinMask);
+		});
+		result.staticToggle = Detail::measure(iterations, 1, overhead, [&] {
+			gpioDriver.toggle(GpioConfig::Port, GpioConfig::PinMask);
+		});
+		result.virtualRead = Detail::measure(iterations, 1, overhead, [&] {
+			sink = static_cast<uint32_t>(gpioInterface->read(GpioConfig::Port, GpioConfig::PinMask));
+		});
+		result.staticRead = Detail::measure(iterations, 1, overhead, [&] {
+			sink = static_cast<uint32_t>(gpioDriver.read(GpioConfig::Port, GpioConfig::PinMask));
+		});
+		result.virtualDuty = Detail::measure(iterations, 1, overhead, [&] {
+			pwmInterface->setDutyCycle(PwmConfig::Timer, PwmConfig::Channel, PwmConfig::Period / 2);
+		});
+		result.staticDuty = Detail::measure(iterations, 1, overhead, [&] {
+			pwmDriver.setDutyCycle(PwmConfig::Timer, PwmConfig::Channel, PwmConfig::Period / 2);
+		});
+
+		result.gpioWrapperBytes = sizeof(Wrapper::GpioStatic<GpioConfig>);
+		result.legacyGpioWrapperBytes = sizeof(Detail::LegacyWrapper<Detail::LegacyGpioDriver>);
+		result.pwmWrapperBytes = sizeof(Wrapper::PwmStatic<PwmConfig>);
+		result.legacyPwmWrapperBytes = sizeof(Detail::LegacyWrapper<Detail::LegacyPwmDriver>);
+
+		(void)sink;
+		return result;
+	}
+
+} // namespace Benchmark
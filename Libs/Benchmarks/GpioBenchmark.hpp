@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include "CycleCounter.hpp"
+#include "GpioDriver.hpp"
+#include "GpioStatic.hpp"
+#include "GpioConfigPolicy.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Benchmark {
+
+	/*
+	 * @brief Résultat du benchmark GPIO, en cycles CPU par opération.
+	 * hal*    : HalGpioDriver -> MapPort -> HAL_GPIO_xxx (chemin historique)
+	 * direct* : GpioStatic -> accès registre résolu à la compilation
+	 **/
+	struct GpioBenchResult {
+		uint32_t iterations;
+		uint32_t halWrite;
+		uint32_t halToggle;
+		uint32_t halRead;
+		uint32_t directWrite;
+		uint32_t directToggle;
+		uint32_t directRead;
+	};
+
+	namespace Detail {
+		// Empêche le compilateur de fusionner ou de sortir les accès de la boucle mesurée.
+		inline void barrier() {
+			__asm volatile("" ::: "memory");
+		}
+		
+		template <typename F>
+		uint32_t measure(uint32_t iterations, uint32_t opsPerIteration, uint32_t overhead, F&& body) {
+			const uint32_t start = CycleCounter::now();
+			for (uint32_t i = 0; i < iterations; ++i) {
+				body();
+				barrier();
+			}
+			const uint32_t total = CycleCounter::elapsed(start);
+			const uint32_t ops = iterations * opsPerIteration;
+			return ops ? (total > overhead ? total - overhead : 0) / ops : 0;
+		}
+	}
+
+	/*
+	 * @brief Compare le chemin HAL et le chemin registre direct sur une même broche.
+	 * La broche doit être une sortie (écriture/toggle) ; la lecture est mesurée via IDR
+	 * quel que soit le mode. À exécuter interruptions masquées pour des chiffres stables.
+	 **/
+	template <GpioConfigPolicy config>
+	GpioBenchResult run_gpio_benchmark(uint32_t iterations = 1000) {
+		static_assert(config::CanSet && config::CanToggle, "Le benchmark GPIO nécessite une broche en sortie");
+		
+		if (!CycleCounter::is_enabled())
+			CycleCounter::enable();
+		
+		HalGpioDriver hal;
+		Wrapper::GpioStatic<config> pin;
+		pin.init();
+		
+		volatile uint32_t sink = 0;
+		GpioBenchResult result {};
+		result.iterations = iterations;
+		
+		const uint32_t overhead = Detail::measure(iterations, 1, 0, [] {}) * iterations;
+		
+		result.halWrite = Detail::measure(iterations, 2, overhead, [&] {
+			hal.write(config::Port, config::PinMask, GpioPinState::Set);
+			hal.write(config::Port, config::PinMask, GpioPinState::Reset);
+		});
+		result.halToggle = Detail::measure(iterations, 1, overhead, [&] {
+			hal.toggle(config::Port, config::PinMask);
+		});
+		result.halRead = Detail::measure(iterations, 1, overhead, [&] {
+			sink = static_cast<uint32_t>(hal.read(config::Port, config::PinMask));
+		});
+		
+		result.directWrite = Detail::measure(iterations, 2, overhead, [&] {
+			pin.set_high();
+			pin.set_low();
+		});
+		result.directToggle = Detail::measure(iterations, 1, overhead, [&] {
+			pin.toggle();
+		});
+		result.directRead = Detail::measure(iterations, 1, overhead, [&] {
+			sink = static_cast<uint32_t>(HalGpioDriver::read_direct<config::Port, config::PinMask>());
+		});
+		
+		(void)sink;
+		return result;
+	}
+
+} // namespace Benchmark
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "CycleCounter.hpp"
+#include "PwmDriver.hpp"
+#include "PwmStatic.hpp"
+#include "PwmConfigPolicy.hpp"
+#include "HandleRegistry.hpp"
+#include "GpioBenchmark.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Benchmark {
+
+	/*
+	 * @brief Coût d'accès aux handles HAL, en cycles CPU par appel, et mémoire des registres.
+	 * map*      : std::map<TIM_TypeDef*, TIM_HandleTypeDef> (ancien HalPwmDriver, idem ADC/DAC/CAN)
+	 * vector*   : std::vector indexé par un handleIndex lu à l'exécution (ancien UART/SPI/I2C)
+	 * registry* : HandleRegistry, port constant -> adresse constante
+	 * *Lookup   : obtention de l'adresse du handle seule ; *Duty : setDutyCycle complet
+	 * registryBytes : RAM statique du registre PWM (12 handles, .bss)
+	 * legacyHeapBytes : tas consommé par l'ancienne map pour les timers utilisés (estimation : nœud
+	 *                   rouge-noir 16 o + clé + handle + 8 o d'en-tête malloc, par timer)
+	 **/
+	struct HandleBenchResult {
+		uint32_t iterations;
+		uint32_t mapLookup;
+		uint32_t vectorLookup;
+		uint32_t registryLookup;
+		uint32_t mapDuty;
+		uint32_t registryDuty;
+		uint32_t registryBytes;
+		uint32_t legacyHeapBytes;
+	};
+
+	/*
+	 * @brief Mesure sur le canal PWM de PwmConfig (initialisé ici). usedTimers simule le nombre de
+	 * timers présents dans l'ancienne map (profondeur de recherche).
+	 * À exécuter interruptions masquées pour des chiffres stables.
+	 **/
+	template <PwmConfigPolicy PwmConfig>
+	HandleBenchResult run_handle_benchmark(uint32_t iterations = 1000, uint32_t usedTimers = 4) {
+		if (!CycleCounter::is_enabled())
+			CycleCounter::enable();
+
+		Wrapper::PwmStatic<PwmConfig> pwm;
+		pwm.init();
+		HalPwmDriver pwmDriver;
+		using Handles = HalPwmDriver::Handles;
+
+		// Reproduction des anciens registres, pour la mesure uniquement
+		std::map<TIM_TypeDef*, TIM_HandleTypeDef> legacyMap;
+		static constexpr PwmTimerInstance Timers[] = {
+			PwmTimerInstance::TIM_1, PwmTimerInstance::TIM_2, PwmTimerInstance::TIM_3, PwmTimerInstance::TIM_4,
+			PwmTimerInstance::TIM_5, PwmTimerInstance::TIM_8, PwmTimerInstance::TIM_9, PwmTimerInstance::TIM_12,
+		};
+		for (uint32_t i = 0; i < usedTimers && i < sizeof(Timers) / sizeof(Timers[0]); ++i)
+			legacyMap[HalPwmDriver::MapTimerInstance(Timers[i])].Instance = HalPwmDriver::MapTimerInstance(Timers[i]);
+		legacyMap[HalPwmDriver::MapTimerInstance(PwmConfig::Timer)] = Handles::template at<PwmConfig::Timer>();
+
+		std::vector<TIM_HandleTypeDef> legacyVector(usedTimers ? usedTimers : 1);
+		volatile int8_t runtimeIndex = static_cast<int8_t>(legacyVector.size() - 1);
+
+		volatile uintptr_t sink = 0;
+		HandleBenchResult result {};
+		result.iterations = iterations;
+
+		const uint32_t overhead = Detail::measure(iterations, 1, 0, [] {}) * iterations;
+
+		result.mapLookup = Detail::measure(iterations, 1, overhead, [&] {
+			sink = reinterpret_cast<uintptr_t>(&legacyMap[HalPwmDriver::MapTimerInstance(PwmConfig::Timer)]);
+		});
+		result.vectorLookup = Detail::measure(iterations, 1, overhead, [&] {
+			sink = reinterpret_cast<uintptr_t>(&legacyVector[runtimeIndex]);
+		});
+		result.registryLookup = Detail::measure(iterations, 1, overhead, [&] {
+			sink = reinterpret_cast<uintptr_t>(&Handles::template at<PwmConfig::Timer>());
+		});
+		result.mapDuty = Detail::measure(iterations, 1, overhead, [&] {
+			TIM_HandleTypeDef* htim = &legacyMap[HalPwmDriver::MapTimerInstance(PwmConfig::Timer)];
+			__HAL_TIM_SET_COMPARE(htim, HalPwmDriver::MapTimerChannel(PwmConfig::Channel), PwmConfig::Period / 2);
+		});
+		result.registryDuty = Detail::measure(iterations, 1, overhead, [&] {
+			pwmDriver.setDutyCycle(PwmConfig::Timer, PwmConfig::Channel, PwmConfig::Period / 2);
+		});
+
+		result.registryBytes = sizeof(Handles::handles);
+		result.legacyHeapBytes = static_cast<uint32_t>(legacyMap.size()
+			* (16u + sizeof(TIM_TypeDef*) + sizeof(TIM_HandleTypeDef) + 8u));
+
+		(void)sink;
+		return result;
+	}
+
+} // namespace Benchmark
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include "CycleCounter.hpp"
+#include "Callback.hpp"
+#include "GpioDriver.hpp"
+#include "GpioStatic.hpp"
+#include "GpioConfigPolicy.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Benchmark {
+
+	/*
+	 * @brief Latence déclenchement -> callback utilisateur, en cycles CPU.
+	 * Inclut l'écriture SWIER, l'entrée d'exception (~12 cycles), l'acquittement EXTI et le dispatch.
+	 **/
+	struct IrqLatencyResult {
+		uint32_t iterations;
+		uint32_t minCycles;
+		uint32_t maxCycles;
+		uint32_t avgCycles;
+	};
+
+	/*
+	 * @brief Sonde appelée par l'ISR mesurée : horodate l'arrivée dans le callback.
+	 **/
+	struct IrqLatencyProbe {
+		inline static volatile uint32_t handlerStamp = 0;
+		inline static volatile bool fired = false;
+
+		static void mark() {
+			handlerStamp = CycleCounter::now();
+			fired = true;
+		}
+	};
+
+	/*
+	 * @brief Mesure la latence d'une ligne EXTI déclenchée par logiciel (EXTI->SWIER).
+	 * Le vecteur de la broche doit être lié, au choix :
+	 *   - chemin table  : WRAPPER_BIND_IRQ(EXTIx, Wrapper::GpioIrq<Pin>)
+	 *   - chemin direct : WRAPPER_BIND_IRQ(EXTIx, Wrapper::GpioIrq<Pin, &Benchmark::IrqLatencyProbe::mark>)
+	 * Le callback de la table est attaché ici ; il n'est pas utilisé par le chemin direct.
+	 **/
+	template <GpioConfigPolicy Pin>
+	IrqLatencyResult run_exti_latency(uint32_t iterations = 1000) {
+		static_assert(Pin::Interrupt != GpioInterruptEdge::None, "Le benchmark EXTI nécessite une broche en interruption");
+
+		if (!CycleCounter::is_enabled())
+			CycleCounter::enable();
+
+		Wrapper::GpioStatic<Pin> pin;
+		pin.init();
+		pin.attach_interrupt(Callback<>::from<&IrqLatencyProbe::mark>());
+
+		IrqLatencyResult result { iterations, UINT32_MAX, 0, 0 };
+		uint64_t total = 0;
+
+		for (uint32_t i = 0; i < iterations; ++i) {
+			IrqLatencyProbe::fired = false;
+			const uint32_t start = CycleCounter::now();
+			EXTI->SWIER = Pin::PinMask;
+			while (!IrqLatencyProbe::fired) {
+			}
+			const uint32_t cycles = IrqLatencyProbe::handlerStamp - start;
+			total += cycles;
+			if (cycles < result.minCycles) result.minCycles = cycles;
+			if (cycles > result.maxCycles) result.maxCycles = cycles;
+		}
+
+		result.avgCycles = iterations ? static_cast<uint32_t>(total / iterations) : 0;
+		return result;
+	}
+
+} // namespace Benchmark
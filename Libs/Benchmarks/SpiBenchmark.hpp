@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "CycleCounter.hpp"
+#include "SpiDriver.hpp"
+#include "SpiStatic.hpp"
+#include "SpiConfigPolicy.hpp"
+#include "GpioBenchmark.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Benchmark {
+
+	/*
+	 * @brief Mesure pour une taille de transaction.
+	 * hal*    : SpiStatic::transmit_receive -> HAL_SPI_TransmitReceive (état, verrou, timeout)
+	 * direct* : SpiStatic::exchange -> DR/SR par registres
+	 * *Cycles : cycles CPU par transaction ; *LatencyNs : idem en ns ; *BytesPerSecond : débit utile
+	 **/
+	struct SpiBenchPoint {
+		uint32_t bytes;
+		uint32_t halCycles;
+		uint32_t directCycles;
+		uint32_t halLatencyNs;
+		uint32_t directLatencyNs;
+		uint32_t halBytesPerSecond;
+		uint32_t directBytesPerSecond;
+	};
+
+	/*
+	 * @brief Résultat du benchmark SPI, transactions de 1, 2, 4 et 16 octets.
+	 * wireCycles : durée théorique d'un octet sur la ligne (8 fronts SCK), en cycles CPU.
+	 * errors : échanges directs en erreur (OVR), bloqués (HAL_TIMEOUT) ou refusés (HAL_BUSY) ; doit rester à 0.
+	 **/
+	struct SpiBenchResult {
+		uint32_t iterations;
+		uint32_t coreClockHz;
+		uint32_t wireCycles;
+		uint32_t errors;
+		std::array<SpiBenchPoint, 4> points;
+	};
+
+	/*
+	 * @brief Compare HAL_SPI_TransmitReceive et le chemin registre sur le port de config (initialisé ici).
+	 * MISO peut rester en l'air ou être relié à MOSI : seules les durées sont mesurées.
+	 * À exécuter interruptions masquées pour des chiffres stables.
+	 **/
+	template <SpiConfigPolicy config>
+	SpiBenchResult run_spi_benchmark(uint32_t iterations = 1000) {
+		static_assert(config::DataSize == Wrapper::SpiDataSize::Data8Bit, "Le benchmark SPI mesure des trames de 8 bits");
+
+		if (!CycleCounter::is_enabled())
+			CycleCounter::enable();
+
+		Wrapper::SpiStatic<config> spi;
+		spi.init();
+
+		static constexpr uint32_t Sizes[] = { 1, 2, 4, 16 };
+		uint8_t tx[16] = { 0x9F, 0x00, 0x55, 0xAA, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+		uint8_t rx[16] = { };
+
+		SpiBenchResult result {};
+		result.iterations = iterations;
+		result.coreClockHz = HAL_RCC_GetHCLKFreq();
+		const uint32_t pclk = (config::Port == Wrapper::SpiPort::SPI_1) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+		const uint32_t divider = 2u << static_cast<uint32_t>(config::Prescaler);
+		result.wireCycles = static_cast<uint32_t>(8ull * divider * result.coreClockHz / pclk);
+
+		const uint32_t overhead = Detail::measure(iterations, 1, 0, [] {}) * iterations;
+		volatile uint32_t errors = 0;
+
+		for (size_t p = 0; p < result.points.size(); ++p) {
+			const uint16_t size = static_cast<uint16_t>(Sizes[p]);
+			SpiBenchPoint& point = result.points[p];
+			point.bytes = size;
+			point.halCycles = Detail::measure(iterations, 1, overhead, [&] {
+				spi.transmit_receive(tx, rx, size, 10);
+			});
+			point.directCycles = Detail::measure(iterations, 1, overhead, [&] {
+				if (spi.exchange(tx, rx, size) != HAL_OK)
+					errors = errors + 1;
+			});
+			point.halLatencyNs = static_cast<uint32_t>(1000000000ull * point.halCycles / result.coreClockHz);
+			point.directLatencyNs = static_cast<uint32_t>(1000000000ull * point.directCycles / result.coreClockHz);
+			point.halBytesPerSecond = point.halCycles ? static_cast<uint32_t>(1ull * size * result.coreClockHz / point.halCycles) : 0;
+			point.directBytesPerSecond = point.directCycles ? static_cast<uint32_t>(1ull * size * result.coreClockHz / point.directCycles) : 0;
+		}
+
+		result.errors = errors;
+		return result;
+	}
+
+} // namespace Benchmark
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Devices {
+
+	/*
+	 * @brief Géométrie des EEPROM I2C 24Cxx : capacité, taille de page, octets d'adresse mot.
+	 * Avec un octet d'adresse, les bits au-delà de 256 octets passent dans l'adresse esclave (A0..A2).
+	 **/
+	template <uint32_t capacity, uint16_t pageSize, uint8_t addressBytes>
+	struct EepromGeometry {
+		static constexpr uint32_t Capacity = capacity;
+		static constexpr uint16_t PageSize = pageSize;
+		static constexpr uint8_t AddressBytes = addressBytes;
+	};
+
+	using Eeprom24C02 = EepromGeometry<256, 8, 1>;
+	using Eeprom24C16 = EepromGeometry<2048, 16, 1>;
+	using Eeprom24C32 = EepromGeometry<4096, 32, 2>;
+	using Eeprom24C64 = EepromGeometry<8192, 32, 2>;
+	using Eeprom24C256 = EepromGeometry<32768, 64, 2>;
+	using Eeprom24C512 = EepromGeometry<65536, 128, 2>;
+
+	/*
+	 * @brief Accès bus d'une EEPROM 24Cxx (adresse esclave 7 bits, adresse mot sur wordSize octets).
+	 * write / read renvoient false sur NACK : puce en cycle d'écriture ou absente.
+	 * probe : adresse seule (START, adresse en écriture, STOP), true si acquittée.
+	 * Implémentations : I2cStaticEepromTransport (I2cEepromTransport.hpp), I2cEepromSim (hôte).
+	 **/
+	template <typename T>
+	concept EepromTransport = requires(T transport, uint8_t device, uint16_t word, uint8_t wordSize, const uint8_t* tx, uint8_t* rx, size_t size) {
+		{ transport.write(device, word, wordSize, tx, size) } -> std::same_as<bool>;
+		{ transport.read(device, word, wordSize, rx, size) } -> std::same_as<bool>;
+		{ transport.probe(device) } -> std::same_as<bool>;
+	};
+
+	/*
+	 * @brief Compteurs du driver (cumulés).
+	 * bytesWritten : octets reçus par write() ; pageWrites / bytesProgrammed : cycles d'écriture lancés
+	 * et octets qu'ils portent ; gapReads : lectures pour combler un trou dans une page fusionnée ;
+	 * busyPolls : sondages ACK restés sans réponse (puce encore en cycle).
+	 **/
+	struct EepromStats {
+		uint32_t bytesWritten;
+		uint32_t pageWrites;
+		uint32_t bytesProgrammed;
+		uint32_t gapReads;
+		uint32_t busyPolls;
+		uint32_t errors;
+	};
+
+	/*
+	 * @brief EEPROM I2C 24Cxx avec fusion des écritures par page et détection de fin de cycle par ACK.
+	 *
+	 * write() découpe aux frontières de page et accumule dans un tampon d'une page : des écritures
+	 * voisines dans la même page deviennent une seule écriture de page (un trou entre deux morceaux est
+	 * relu depuis la puce). La page est écrite quand elle est pleine, quand une écriture touche une autre
+	 * page, ou sur flush(). Le cycle d'écriture (tWR) n'est pas attendu à la fin : l'opération suivante
+	 * sonde la puce (adresse seule) jusqu'à son ACK, au lieu d'un délai fixe de 5 ms par octet ou par page.
+	 * read() voit les octets encore dans le tampon.
+	 *
+	 *   I2cStaticEepromTransport<I2c1Config> transport(i2c);
+	 *   I2cEeprom<I2cStaticEepromTransport<I2c1Config>, Eeprom24C256> eeprom(transport);
+	 *   eeprom.write(ParamsAddress, &params, sizeof(params));
+	 *   eeprom.flush();                  // avant coupure d'alimentation
+	 *
+	 * @tparam Transport EepromTransport
+	 * @tparam Geometry EepromGeometry (Eeprom24C02...)
+	 * @tparam DeviceAddress Adresse 7 bits de base (A2..A0 câblées), 0x50 par défaut
+	 * @note Non réentrant : un seul thread (ou sous mutex).
+	 **/
+	template <EepromTransport Transport, typename Geometry, uint8_t DeviceAddress = 0x50>
+	class I2cEeprom {
+	public:
+		static constexpr uint32_t Capacity = Geometry::Capacity;
+		static constexpr uint32_t PageSize = Geometry::PageSize;
+		static constexpr uint8_t AddressBytes = Geometry::AddressBytes;
+
+	private:
+		// Espace adressable par une adresse esclave
+		static constexpr uint32_t BlockSize = 1u << (8u * AddressBytes);
+		static_assert(AddressBytes == 1 || AddressBytes == 2, "I2cEeprom : adresse mot sur 1 ou 2 octets");
+		static_assert(Capacity % PageSize == 0 && BlockSize % PageSize == 0, "I2cEeprom : géométrie incohérente");
+		static_assert((Capacity + BlockSize - 1) / BlockSize <= 8, "I2cEeprom : au plus 8 adresses esclaves");
+
+	public:
+		/*
+		 * @param pollLimit Sondages ACK avant abandon ; à 400 kHz un sondage dure ~25 µs,
+		 * 1000 couvrent largement tWR = 5 ms.
+		 **/
+		explicit I2cEeprom(Transport& transport, uint32_t pollLimit = 1000)
+			: m_transport(transport)
+			, m_pollLimit(pollLimit) {}
+
+		/*
+		 * @brief Écrit size octets à address, par le tampon de page.
+		 * @return false hors capacité ou sur erreur bus (les octets non écrits restent en tampon)
+		 **/
+		bool write(uint32_t address, const void* data, size_t size) {
+			if (address > Capacity || size > Capacity - address) {
+				++m_stats.errors;
+				return false;
+			}
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			m_stats.bytesWritten += static_cast<uint32_t>(size);
+			while (size > 0) {
+				const uint32_t page = address - address % PageSize;
+				const uint32_t begin = address - page;
+				const uint32_t end = begin + static_cast<uint32_t>(std::min<size_t>(size, PageSize - begin));
+
+				if (page != m_page && !commit())
+					return false;
+				m_page = page;
+				if (m_begin == m_end) {
+					m_begin = begin;
+					m_end = end;
+				} else {
+					// Trous entre la partie en tampon et le nouveau morceau : relus pour garder une écriture contiguë
+					if (begin > m_end && !fill(m_end, begin))
+						return false;
+					if (end < m_begin && !fill(end, m_begin))
+						return false;
+					m_begin = std::min(m_begin, begin);
+					m_end = std::max(m_end, end);
+				}
+				std::memcpy(&m_buffer[begin], bytes, end - begin);
+				bytes += end - begin;
+				address += end - begin;
+				size -= end - begin;
+
+				if (m_begin == 0 && m_end == PageSize && !commit())
+					return false;
+			}
+			return true;
+		}
+
+		/*
+		 * @brief Lit size octets à address (attend la fin d'un cycle d'écriture en cours).
+		 **/
+		bool read(uint32_t address, void* data, size_t size) {
+			if (address > Capacity || size > Capacity - address) {
+				++m_stats.errors;
+				return false;
+			}
+			if (!wait_ready())
+				return false;
+			uint8_t* bytes = static_cast<uint8_t*>(data);
+			for (size_t done = 0; done < size;) {
+				const uint32_t at = address + static_cast<uint32_t>(done);
+				const size_t chunk = std::min<size_t>(size - done, BlockSize - at % BlockSize);
+				if (!m_transport.read(device(at), static_cast<uint16_t>(at % BlockSize), AddressBytes, bytes + done, chunk)) {
+					++m_stats.errors;
+					return false;
+				}
+				done += chunk;
+			}
+			// Octets encore en tampon
+			if (m_begin != m_end) {
+				const uint32_t from = std::max(address, m_page + m_begin);
+				const uint32_t to = std::min(address + static_cast<uint32_t>(size), m_page + m_end);
+				if (from < to)
+					std::memcpy(bytes + (from - address), &m_buffer[from - m_page], to - from);
+			}
+			return true;
+		}
+
+		// Écrit la page en tampon et attend la fin du cycle : tout est persistant au retour
+		bool flush() {
+			return commit() && wait_ready();
+		}
+
+		// Octets en tampon, pas encore envoyés à la puce
+		bool pending() const { return m_begin != m_end; }
+
+		const EepromStats& stats() const { return m_stats; }
+
+	private:
+		static constexpr uint8_t device(uint32_t address) {
+			return static_cast<uint8_t>(DeviceAddress | ((address / BlockSize) & 0x07u));
+		}
+
+		// Sondage ACK de la puce tant qu'un cycle d'écriture est en cours
+		bool wait_ready() {
+			if (!m_writing)
+				return true;
+			for (uint32_t poll = 0; poll < m_pollLimit; ++poll) {
+				if (m_transport.probe(m_writingDevice)) {
+					m_writing = false;
+					return true;
+				}
+				++m_stats.busyPolls;
+			}
+			++m_stats.errors;
+			return false;
+		}
+
+		// Lance l'écriture de la partie en tampon ; la fin du cycle est sondée par l'opération suivante
+		bool commit() {
+			if (m_begin == m_end)
+				return true;
+			if (!wait_ready())
+				return false;
+			const uint32_t address = m_page + m_begin;
+			const uint32_t size = m_end - m_begin;
+			if (!m_transport.write(device(address), static_cast<uint16_t>(address % BlockSize), AddressBytes, &m_buffer[m_begin], size)) {
+				++m_stats.errors;
+				return false;
+			}
+			m_writing = true;
+			m_writingDevice = device(address);
+			++m_stats.pageWrites;
+			m_stats.bytesProgrammed += size;
+			m_begin = m_end = 0;
+			return true;
+		}
+
+		bool fill(uint32_t begin, uint32_t end) {
+			if (!wait_ready())
+				return false;
+			const uint32_t address = m_page + begin;
+			if (!m_transport.read(device(address), static_cast<uint16_t>(address % BlockSize), AddressBytes, &m_buffer[begin], end - begin)) {
+				++m_stats.errors;
+				return false;
+			}
+			++m_stats.gapReads;
+			return true;
+		}
+
+		Transport& m_transport;
+		uint32_t m_pollLimit;
+		uint8_t m_buffer[PageSize] = { };
+		uint32_t m_page = 0;
+		uint32_t m_begin = 0; // Partie en tampon : [m_begin, m_end) dans la page m_page
+		uint32_t m_end = 0;
+		bool m_writing = false;
+		uint8_t m_writingDevice = DeviceAddress;
+		EepromStats m_stats {};
+	};
+
+} // namespace Devices
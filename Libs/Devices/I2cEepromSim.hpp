@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "I2cEeprom.hpp"
+
+namespace Devices {
+
+	/*
+	 * @brief Temps de la puce simulée et du bus. writeCycleUs : tWR réel (typiquement 2 à 4 ms, 5 ms max
+	 * en fiche technique) ; transactionOverheadNs : START / STOP et logiciel autour de chaque transaction.
+	 **/
+	struct EepromTiming {
+		uint32_t busHz = 400000;
+		uint32_t transactionOverheadNs = 5000;
+		uint32_t writeCycleUs = 3500;
+	};
+
+	/*
+	 * @brief Compteurs de la puce simulée. nacks : transactions refusées (cycle d'écriture en cours ou
+	 * adresse esclave étrangère) ; pageWraps : écritures qui ont débordé de leur page (rebouclage : octets
+	 * écrasés en début de page, doit rester à 0).
+	 **/
+	struct EepromSimStats {
+		uint64_t elapsedNs;
+		uint32_t transactions;
+		uint32_t nacks;
+		uint32_t writeCycles;
+		uint32_t bytesProgrammed;
+		uint32_t bytesRead;
+		uint32_t pageWraps;
+	};
+
+	/*
+	 * @brief EEPROM 24Cxx simulée, sans HAL : se branche comme transport de I2cEeprom pour mesurer sur PC
+	 * temps d'écriture et nombre de cycles. Le temps est virtuel : chaque transaction coûte ses bits sur
+	 * le bus (9 par octet), un cycle d'écriture rend la puce muette (NACK) pendant tWR.
+	 *
+	 *   I2cEepromSim<Eeprom24C256> sim;
+	 *   I2cEeprom<I2cEepromSim<Eeprom24C256>, Eeprom24C256> eeprom(sim);
+	 *   for (auto& p : params) eeprom.write(p.address, &p.value, sizeof(p.value));
+	 *   eeprom.flush();
+	 *   // durée : sim.stats().elapsedNs ; cycles : sim.stats().writeCycles
+	 *   // référence (octet par octet, 5 ms fixes) : sim.write(...) puis sim.advance_us(5000) par octet
+	 **/
+	template <typename Geometry, uint8_t DeviceAddress = 0x50>
+	class I2cEepromSim {
+		static constexpr uint32_t BlockSize = 1u << (8u * Geometry::AddressBytes);
+
+	public:
+		static constexpr uint32_t Capacity = Geometry::Capacity;
+		static constexpr uint32_t PageSize = Geometry::PageSize;
+
+		explicit I2cEepromSim(EepromTiming timing = {})
+			: m_timing(timing)
+			, m_memory(Capacity, 0xFF) {}
+
+		bool write(uint8_t device, uint16_t word, uint8_t wordSize, const uint8_t* data, size_t size) {
+			if (!start(device, 1 + wordSize + size))
+				return false;
+			const uint32_t address = base(device, word);
+			const uint32_t page = address - address % PageSize;
+			if (size > PageSize - (address - page))
+				++m_stats.pageWraps;
+			for (size_t i = 0; i < size; ++i)
+				m_memory[page + (address - page + i) % PageSize] = data[i];
+			m_busyUntilNs = m_stats.elapsedNs + uint64_t(m_timing.writeCycleUs) * 1000u;
+			++m_stats.writeCycles;
+			m_stats.bytesProgrammed += static_cast<uint32_t>(size);
+			return true;
+		}
+
+		// Écriture de l'adresse mot, START répété, lecture séquentielle (rebouclage en fin de mémoire)
+		bool read(uint8_t device, uint16_t word, uint8_t wordSize, uint8_t* data, size_t size) {
+			if (!start(device, 1 + wordSize + 1 + size))
+				return false;
+			const uint32_t address = base(device, word);
+			for (size_t i = 0; i < size; ++i)
+				data[i] = m_memory[(address + i) % Capacity];
+			m_stats.bytesRead += static_cast<uint32_t>(size);
+			return true;
+		}
+
+		bool probe(uint8_t device) {
+			return start(device, 1);
+		}
+
+		// Temps passé hors bus (délais fixes d'un driver naïf, travail de l'application)
+		void advance_us(uint32_t us) {
+			m_stats.elapsedNs += uint64_t(us) * 1000u;
+		}
+
+		const EepromSimStats& stats() const { return m_stats; }
+
+		// Contenu brut, pour vérification
+		const uint8_t* memory() const { return m_memory.data(); }
+
+	private:
+		// Adresse esclave émise ; false (NACK, transaction réduite à l'adresse) si la puce ne répond pas
+		bool start(uint8_t device, size_t bytes) {
+			++m_stats.transactions;
+			const bool ack = (device & ~0x07u) == (DeviceAddress & ~0x07u) && m_stats.elapsedNs >= m_busyUntilNs
+				&& base(device, 0) < Capacity;
+			if (!ack) {
+				bytes = 1;
+				++m_stats.nacks;
+			}
+			m_stats.elapsedNs += m_timing.transactionOverheadNs + (uint64_t(bytes) * 9u * 1000000000ull) / m_timing.busHz;
+			return ack;
+		}
+
+		static constexpr uint32_t base(uint8_t device, uint16_t word) {
+			return (uint32_t(device) & 0x07u) * BlockSize + word;
+		}
+
+		EepromTiming m_timing;
+		std::vector<uint8_t> m_memory;
+		uint64_t m_busyUntilNs = 0;
+		EepromSimStats m_stats {};
+	};
+
+} // namespace Devices
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include "I2cEeprom.hpp"
+#include "I2cStatic.hpp"
+
+namespace Devices {
+
+	/*
+	 * @brief Transport EEPROM par I2cStatic (mem_write / mem_read bloquants, sonde par is_device_ready).
+	 * Un NACK pendant le cycle d'écriture ressort en HAL_ERROR : false, sans attente.
+	 **/
+	template <I2cConfigPolicy config>
+	class I2cStaticEepromTransport {
+	public:
+		explicit I2cStaticEepromTransport(Wrapper::I2cStatic<config>& i2c, uint32_t timeoutMs = 10)
+			: m_i2c(i2c)
+			, m_timeoutMs(timeoutMs) {}
+
+		bool write(uint8_t device, uint16_t word, uint8_t wordSize, const uint8_t* data, size_t size) {
+			return m_i2c.mem_write(device << 1, word, memory_size(wordSize), data, static_cast<uint16_t>(size), m_timeoutMs) == HAL_OK;
+		}
+
+		bool read(uint8_t device, uint16_t word, uint8_t wordSize, uint8_t* data, size_t size) {
+			return m_i2c.mem_read(device << 1, word, memory_size(wordSize), data, static_cast<uint16_t>(size), m_timeoutMs) == HAL_OK;
+		}
+
+		bool probe(uint8_t device) {
+			return m_i2c.is_device_ready(device << 1, 1, m_timeoutMs) == HAL_OK;
+		}
+
+	private:
+		static constexpr uint16_t memory_size(uint8_t wordSize) {
+			return wordSize == 2 ? I2C_MEMADD_SIZE_16BIT : I2C_MEMADD_SIZE_8BIT;
+		}
+
+		Wrapper::I2cStatic<config>& m_i2c;
+		uint32_t m_timeoutMs;
+	};
+
+} // namespace Devices
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "RegisterMap.hpp"
+#include "Semaphore.hpp"
+#ifdef HAL_I2C_MODULE_ENABLED
+#include "I2cStatic.hpp"
+#include "I2cScheduler.hpp"
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+#include "SpiBus.hpp"
+#endif
+
+namespace Devices {
+
+#ifdef HAL_I2C_MODULE_ENABLED
+	/*
+	 * @brief Registres d'un esclave I2C par I2cStatic (mem_read / mem_write bloquants).
+	 * @tparam Address Adresse 7 bits, non décalée
+	 * @tparam IncrementFlag OU sur le numéro de registre des rafales (ex. 0x80 chez ST) ; 0 si implicite
+	 **/
+	template <I2cConfigPolicy config, uint8_t Address, uint8_t IncrementFlag = 0x00>
+	class I2cRegisterBus {
+	public:
+		explicit I2cRegisterBus(Wrapper::I2cStatic<config>& i2c, uint32_t timeoutMs = 10)
+			: m_i2c(i2c)
+			, m_timeoutMs(timeoutMs) {}
+
+		bool read(uint8_t reg, uint8_t* data, size_t size) {
+			return m_i2c.mem_read(Address << 1, sub_address(reg, size), I2C_MEMADD_SIZE_8BIT, data, static_cast<uint16_t>(size), m_timeoutMs) == HAL_OK;
+		}
+
+		bool write(uint8_t reg, const uint8_t* data, size_t size) {
+			return m_i2c.mem_write(Address << 1, sub_address(reg, size), I2C_MEMADD_SIZE_8BIT, data, static_cast<uint16_t>(size), m_timeoutMs) == HAL_OK;
+		}
+
+	private:
+		static constexpr uint16_t sub_address(uint8_t reg, size_t size) {
+			return size > 1 ? (reg | IncrementFlag) : reg;
+		}
+
+		Wrapper::I2cStatic<config>& m_i2c;
+		uint32_t m_timeoutMs;
+	};
+
+	/*
+	 * @brief Registres d'un esclave I2C par I2cScheduler : DMA, le thread dort pendant le transfert.
+	 * Le travail et son tampon (copie des données) sont des membres : après un délai écoulé, read / write
+	 * renvoient false et le travail finit au planificateur sans toucher les tampons de l'appelant ;
+	 * l'appel suivant l'attend d'abord (I2cScheduler::wait).
+	 * @tparam Address Adresse 7 bits, non décalée
+	 * @tparam IncrementFlag OU sur le numéro de registre des rafales ; 0 si implicite
+	 * @tparam MaxBurst Taille maximale d'une rafale (au moins celle de la RegisterMap)
+	 **/
+	template <I2cConfigPolicy config, uint8_t Address, uint8_t IncrementFlag = 0x00, size_t MaxBurst = 16>
+	class I2cScheduledRegisterBus {
+		using Scheduler = Wrapper::I2cScheduler<config>;
+
+	public:
+		explicit I2cScheduledRegisterBus(Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = 10)
+			: m_semaphore(semaphore)
+			, m_timeoutMs(timeoutMs) {}
+
+		bool read(uint8_t reg, uint8_t* data, size_t size) {
+			if (size > MaxBurst || !Scheduler::wait(m_job, m_semaphore, m_timeoutMs))
+				return false;
+			m_job = { Address, sub_address(reg, size), 1, {}, { m_buffer.data(), size } };
+			if (!Scheduler::transfer(m_job, m_semaphore, m_timeoutMs))
+				return false;
+			std::memcpy(data, m_buffer.data(), size);
+			return true;
+		}
+
+		bool write(uint8_t reg, const uint8_t* data, size_t size) {
+			if (size > MaxBurst || !Scheduler::wait(m_job, m_semaphore, m_timeoutMs))
+				return false;
+			std::memcpy(m_buffer.data(), data, size);
+			m_job = { Address, sub_address(reg, size), 1, { m_buffer.data(), size } };
+			return Scheduler::transfer(m_job, m_semaphore, m_timeoutMs);
+		}
+
+	private:
+		static constexpr uint16_t sub_address(uint8_t reg, size_t size) {
+			return size > 1 ? (reg | IncrementFlag) : reg;
+		}
+
+		Rtos::Abstract::ISemaphore& m_semaphore;
+		uint32_t m_timeoutMs;
+		Wrapper::I2cJob m_job {};
+		std::array<uint8_t, MaxBurst> m_buffer {};
+	};
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+	/*
+	 * @brief Registres d'un composant sur un bus SPI partagé : premier octet = numéro de registre,
+	 * ReadFlag en lecture, IncrementFlag en rafale (ex. ST : 0x80 / 0x40 ; Bosch : 0x80 / 0x00).
+	 * Transaction, header et tampon (copie des données) sont des membres : après un délai écoulé, read / write
+	 * renvoient false et la transaction finit au bus sans toucher les tampons de l'appelant ;
+	 * l'appel suivant l'attend d'abord (SpiBus::wait).
+	 * @tparam Bus Wrapper::SpiBus<...>
+	 * @tparam Device Wrapper::SpiDevice<...>, trames de 8 bits
+	 * @tparam MaxBurst Taille maximale d'une rafale (au moins celle de la RegisterMap)
+	 **/
+	template <typename Bus, typename Device, uint8_t ReadFlag = 0x80, uint8_t IncrementFlag = 0x00, size_t MaxBurst = 16>
+	class SpiRegisterBus {
+	public:
+		explicit SpiRegisterBus(Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = 10)
+			: m_semaphore(semaphore)
+			, m_timeoutMs(timeoutMs) {}
+
+		bool read(uint8_t reg, uint8_t* data, size_t size) {
+			if (size > MaxBurst || !Bus::wait(m_transaction, m_semaphore, m_timeoutMs))
+				return false;
+			if (!transfer(static_cast<uint8_t>(reg | ReadFlag | (size > 1 ? IncrementFlag : 0)), nullptr, m_buffer.data(), size))
+				return false;
+			std::memcpy(data, m_buffer.data(), size);
+			return true;
+		}
+
+		bool write(uint8_t reg, const uint8_t* data, size_t size) {
+			if (size > MaxBurst || !Bus::wait(m_transaction, m_semaphore, m_timeoutMs))
+				return false;
+			std::memcpy(m_buffer.data(), data, size);
+			return transfer(static_cast<uint8_t>(reg | (size > 1 ? IncrementFlag : 0)), m_buffer.data(), nullptr, size);
+		}
+
+	private:
+		bool transfer(uint8_t header, const uint8_t* tx, uint8_t* rx, size_t size) {
+			m_header = header;
+			m_data = { tx, rx, static_cast<uint16_t>(size) };
+			m_head = { &m_header, nullptr, 1, &m_data };
+			m_transaction = { &Device::Info, &m_head };
+			return Bus::transfer(m_transaction, m_semaphore, m_timeoutMs);
+		}
+
+		Rtos::Abstract::ISemaphore& m_semaphore;
+		uint32_t m_timeoutMs;
+		uint8_t m_header = 0;
+		std::array<uint8_t, MaxBurst> m_buffer {};
+		Wrapper::SpiSegment m_data {};
+		Wrapper::SpiSegment m_head {};
+		Wrapper::SpiTransaction m_transaction {};
+	};
+#endif
+
+} // namespace Devices
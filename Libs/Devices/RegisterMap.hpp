@@ -0,0 +1,314 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace Devices {
+
+	/*
+	 * @brief Accès d'un registre :
+	 *  - Cached   : configuration, copie en RAM faisant foi ; lu sans bus, écrit au flush() s'il a changé.
+	 *  - Volatile : état / mesures modifiés par le composant ; toujours lu sur le bus, jamais écrit par flush().
+	 **/
+	enum class RegAccess : uint8_t {
+		Cached,
+		Volatile,
+	};
+
+	/*
+	 * @brief Registre 8 bits de la table : adresse, valeur après reset (fiche technique), accès.
+	 **/
+	template <uint8_t address, uint8_t reset = 0x00, RegAccess access = RegAccess::Cached>
+	struct Reg {
+		static constexpr uint8_t Address = address;
+		static constexpr uint8_t Reset = reset;
+		static constexpr RegAccess Access = access;
+	};
+
+	/*
+	 * @brief Table des registres d'un composant, triée par adresse croissante (vérifié à la compilation).
+	 * Des adresses consécutives occupent des index consécutifs : une rafale d'écriture part directement
+	 * de la copie en RAM, sans tampon intermédiaire.
+	 **/
+	template <typename... Regs>
+	struct RegisterTable {
+		static constexpr size_t Count = sizeof...(Regs);
+		static_assert(Count > 0 && Count <= 64, "RegisterTable : 1 à 64 registres");
+
+		static constexpr std::array<uint8_t, Count> Addresses { Regs::Address... };
+		static constexpr std::array<uint8_t, Count> Resets { Regs::Reset... };
+		static constexpr std::array<bool, Count> IsVolatile { (Regs::Access == RegAccess::Volatile)... };
+
+		static constexpr bool sorted() {
+			for (size_t i = 1; i < Count; ++i)
+				if (Addresses[i] <= Addresses[i - 1])
+					return false;
+			return true;
+		}
+		static_assert(sorted(), "RegisterTable : adresses strictement croissantes requises");
+
+		static constexpr size_t index_of(uint8_t address) {
+			for (size_t i = 0; i < Count; ++i)
+				if (Addresses[i] == address)
+					return i;
+			return Count;
+		}
+
+		static constexpr bool contains(uint8_t address) {
+			return index_of(address) < Count;
+		}
+	};
+
+	/*
+	 * @brief Accès au composant par numéro de registre, en rafale (auto-incrément de l'adresse).
+	 * Voir RegisterBuses.hpp (I2cStatic, I2cScheduler, SpiBus).
+	 **/
+	template <typename B>
+	concept RegisterBus = requires(B bus, uint8_t reg, const uint8_t* tx, uint8_t* rx, size_t size) {
+		{ bus.read(reg, rx, size) } -> std::same_as<bool>;
+		{ bus.write(reg, tx, size) } -> std::same_as<bool>;
+	};
+
+	/*
+	 * @brief Compteurs de trafic. skipped : set() / modify() sans changement de valeur (aucun accès bus).
+	 **/
+	struct RegisterMapStats {
+		uint32_t writeBursts;
+		uint32_t bytesWritten;
+		uint32_t readBursts;
+		uint32_t bytesRead;
+		uint32_t skipped;
+		uint32_t errors;
+	};
+
+	/*
+	 * @brief Carte de registres d'un composant (capteur I2C/SPI) avec copie en RAM des registres Cached.
+	 * Modifier un champ ne coûte plus un aller-retour lecture-modification-écriture : modify() agit sur la
+	 * copie et marque le registre ; flush() regroupe les registres marqués d'adresses consécutives en
+	 * rafales, en comblant les petits trous (MaxGap registres Cached propres, réécrits à l'identique)
+	 * quand c'est moins cher qu'une nouvelle transaction. Les registres Volatile coupent les rafales.
+	 *
+	 *   using Lis3dh = RegisterTable<
+	 *       Reg<0x0F, 0x33, RegAccess::Volatile>,              // WHO_AM_I
+	 *       Reg<0x20, 0x07>, Reg<0x21>, Reg<0x22>, Reg<0x23>,  // CTRL_REG1..4
+	 *       Reg<0x27, 0x00, RegAccess::Volatile>,              // STATUS
+	 *       Reg<0x28, 0x00, RegAccess::Volatile>, ...>;        // OUT_X_L...
+	 *   RegisterMap<I2cRegisterBus<I2c1Config, 0x18, 0x80>, Lis3dh> accel(bus);
+	 *   accel.modify<0x20>(0xF0, 0x50);   // ODR 100 Hz, pas d'accès bus
+	 *   accel.set<0x23>(0x88);
+	 *   accel.flush();                    // une rafale 0x20..0x23
+	 *   uint8_t xyz[6]; accel.read<0x28>(xyz, 6);
+	 *
+	 * La copie part des valeurs de reset : appeler reset_shadow() après un reset logiciel du composant,
+	 * ou load() pour la relire depuis le bus.
+	 * @tparam Bus RegisterBus
+	 * @tparam Table RegisterTable<...>
+	 * @tparam MaxBurst Taille maximale d'une rafale (1 : composant sans auto-incrément)
+	 * @tparam MaxGap Registres propres tolérés dans une rafale
+	 **/
+	template <RegisterBus Bus, typename Table, size_t MaxBurst = 16, size_t MaxGap = 2>
+	class RegisterMap {
+		static_assert(MaxBurst >= 1, "RegisterMap : MaxBurst >= 1");
+		static constexpr size_t Count = Table::Count;
+		using Mask = uint64_t;
+
+		static constexpr Mask bit(size_t index) {
+			return Mask(1) << index;
+		}
+
+		static constexpr Mask VolatileMask = [] {
+			Mask mask = 0;
+			for (size_t i = 0; i < Count; ++i)
+				if (Table::IsVolatile[i])
+					mask |= bit(i);
+			return mask;
+		}();
+
+		template <uint8_t Address>
+		static constexpr size_t Index = Table::index_of(Address);
+
+	public:
+		explicit RegisterMap(Bus& bus)
+			: m_bus(bus) {
+			reset_shadow();
+		}
+
+		/*
+		 * @brief Valeur d'un registre : copie pour Cached, lecture bus pour Volatile.
+		 * ok (optionnel) passe à false sur erreur bus (la dernière valeur connue est alors renvoyée).
+		 **/
+		template <uint8_t Address>
+		uint8_t get(bool* ok = nullptr) {
+			static_assert(Table::contains(Address), "RegisterMap : registre absent de la table");
+			constexpr size_t index = Index<Address>;
+			if constexpr (Table::IsVolatile[index]) {
+				const bool done = bus_read(Address, &m_shadow[index], 1);
+				if (ok)
+					*ok = done;
+			}
+			return m_shadow[index];
+		}
+
+		// Nouvelle valeur d'un registre Cached : copie seulement, écrite au prochain flush()
+		template <uint8_t Address>
+		void set(uint8_t value) {
+			static_assert(Table::contains(Address), "RegisterMap : registre absent de la table");
+			constexpr size_t index = Index<Address>;
+			static_assert(!Table::IsVolatile[index], "RegisterMap : set() sur un registre Volatile, utiliser write()");
+			if (m_shadow[index] == value) {
+				++m_stats.skipped;
+				return;
+			}
+			m_shadow[index] = value;
+			m_dirty |= bit(index);
+		}
+
+		// Modifie les bits de mask d'un registre Cached (champ), sans accès bus
+		template <uint8_t Address>
+		void modify(uint8_t mask, uint8_t value) {
+			static_assert(Table::contains(Address), "RegisterMap : registre absent de la table");
+			set<Address>(static_cast<uint8_t>((m_shadow[Index<Address>] & ~mask) | (value & mask)));
+		}
+
+		/*
+		 * @brief Écrit les registres marqués, en rafales d'adresses consécutives.
+		 * @return false si une rafale a échoué (ses registres restent marqués pour le flush suivant)
+		 **/
+		bool flush() {
+			bool ok = true;
+			Mask pending = m_dirty;
+			while (pending) {
+				const size_t first = static_cast<size_t>(__builtin_ctzll(pending));
+				size_t last = first;
+				size_t next = first + 1;
+				// Étend la rafale tant que les adresses se suivent, en comblant au plus MaxGap registres propres
+				while (next < Count && next - first < MaxBurst) {
+					if (Table::Addresses[next] != Table::Addresses[next - 1] + 1 || (VolatileMask & bit(next)))
+						break;
+					if (pending & bit(next)) {
+						last = next;
+					} else if (next - last > MaxGap) {
+						break;
+					}
+					++next;
+				}
+				const size_t size = last - first + 1;
+				const Mask run = ((last + 1 < 64) ? (bit(last + 1) - 1) : ~Mask(0)) & ~(bit(first) - 1);
+				if (m_bus.write(Table::Addresses[first], &m_shadow[first], size)) {
+					++m_stats.writeBursts;
+					m_stats.bytesWritten += static_cast<uint32_t>(size);
+					m_dirty &= ~run;
+				} else {
+					++m_stats.errors;
+					ok = false;
+				}
+				pending &= ~run;
+			}
+			return ok;
+		}
+
+		/*
+		 * @brief Écriture immédiate d'un registre (commande, registre Volatile), hors copie pour Volatile.
+		 * Un registre Cached est aussi mis à jour dans la copie et démarqué ; sur échec il reste marqué,
+		 * la valeur est retentée au prochain flush().
+		 **/
+		template <uint8_t Address>
+		bool write(uint8_t value) {
+			static_assert(Table::contains(Address), "RegisterMap : registre absent de la table");
+			constexpr size_t index = Index<Address>;
+			m_shadow[index] = value;
+			if (!bus_write(Address, &m_shadow[index], 1)) {
+				if (!(VolatileMask & bit(index)))
+					m_dirty |= bit(index);
+				return false;
+			}
+			m_dirty &= ~bit(index);
+			return true;
+		}
+
+		/*
+		 * @brief Lecture en rafale depuis le bus à partir de Address (ex. OUT_X_L..OUT_Z_H), vers data.
+		 * Ne touche pas la copie : réservé aux blocs de mesures.
+		 **/
+		template <uint8_t Address>
+		bool read(uint8_t* data, size_t size) {
+			static_assert(Table::contains(Address), "RegisterMap : registre absent de la table");
+			return bus_read(Address, data, size);
+		}
+
+		/*
+		 * @brief Relit tous les registres Cached depuis le bus (rafales consécutives), sans écraser
+		 * ceux qui sont marqués. Pour reprendre la main sur un composant déjà configuré.
+		 **/
+		bool load() {
+			bool ok = true;
+			uint8_t buffer[MaxBurst];
+			size_t first = 0;
+			while (first < Count) {
+				if (VolatileMask & bit(first)) {
+					++first;
+					continue;
+				}
+				size_t end = first + 1;
+				while (end < Count && end - first < MaxBurst && !(VolatileMask & bit(end))
+					&& Table::Addresses[end] == Table::Addresses[end - 1] + 1)
+					++end;
+				if (bus_read(Table::Addresses[first], buffer, end - first)) {
+					for (size_t i = first; i < end; ++i)
+						if (!(m_dirty & bit(i)))
+							m_shadow[i] = buffer[i - first];
+				} else {
+					ok = false;
+				}
+				first = end;
+			}
+			return ok;
+		}
+
+		// Composant revenu à ses valeurs de reset (reset logiciel) : copie réinitialisée, rien de marqué
+		void reset_shadow() {
+			m_shadow = Table::Resets;
+			m_dirty = 0;
+		}
+
+		// Valeur en copie sans accès bus (y compris la dernière lecture d'un Volatile)
+		template <uint8_t Address>
+		uint8_t shadow() const {
+			static_assert(Table::contains(Address), "RegisterMap : registre absent de la table");
+			return m_shadow[Index<Address>];
+		}
+
+		bool dirty() const { return m_dirty != 0; }
+
+		const RegisterMapStats& stats() const { return m_stats; }
+
+	private:
+		bool bus_read(uint8_t address, uint8_t* data, size_t size) {
+			if (!m_bus.read(address, data, size)) {
+				++m_stats.errors;
+				return false;
+			}
+			++m_stats.readBursts;
+			m_stats.bytesRead += static_cast<uint32_t>(size);
+			return true;
+		}
+
+		bool bus_write(uint8_t address, const uint8_t* data, size_t size) {
+			if (!m_bus.write(address, data, size)) {
+				++m_stats.errors;
+				return false;
+			}
+			++m_stats.writeBursts;
+			m_stats.bytesWritten += static_cast<uint32_t>(size);
+			return true;
+		}
+
+		Bus& m_bus;
+		std::array<uint8_t, Count> m_shadow {};
+		Mask m_dirty = 0;
+		RegisterMapStats m_stats {};
+	};
+
+} // namespace Devices
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Devices {
+
+	/*
+	 * @brief Jeu de commandes JEDEC des NOR SPI type W25Qxx (adresses 24 bits : 16 Mo max).
+	 **/
+	namespace NorCommand {
+		inline constexpr uint8_t WriteEnable   = 0x06;
+		inline constexpr uint8_t ReadStatus1   = 0x05;
+		inline constexpr uint8_t PageProgram   = 0x02;
+		inline constexpr uint8_t SectorErase   = 0x20; // 4 Ko
+		inline constexpr uint8_t FastRead      = 0x0B; // + 1 octet factice, pleine fréquence SCK
+		inline constexpr uint8_t ReadJedecId   = 0x9F;
+
+		inline constexpr uint8_t StatusBusy    = 0x01; // WIP
+		inline constexpr uint8_t StatusWel     = 0x02;
+	}
+
+	/*
+	 * @brief Transport d'une commande NOR : CS actif, header émis (réception ignorée), puis phase de
+	 * données (tx émis, ou rx reçu avec 0xFF émis, ou rien), CS relâché. Bloquant pour l'appelant.
+	 * Implémentations : SpiBusNorTransport (DMA), SpiStaticNorTransport, SpiNorFlashSim (hôte).
+	 **/
+	template <typename T>
+	concept SpiNorTransport = requires(T transport, const uint8_t* header, size_t headerSize, const uint8_t* tx, uint8_t* rx, size_t size) {
+		{ transport.command(header, headerSize, tx, rx, size) } -> std::same_as<bool>;
+	};
+
+	/*
+	 * @brief Compteurs du driver (cumulés).
+	 * bytesWritten : octets acceptés par write() ; programOps / eraseOps : opérations lancées sur la puce.
+	 * Amplification d'écriture : programOps * PageSize / bytesWritten (1.0 = pages toujours pleines).
+	 * busyPolls : lectures de statut trouvant la puce occupée ; rejected : octets refusés, file pleine.
+	 **/
+	struct NorFlashStats {
+		uint32_t bytesWritten;
+		uint32_t rejected;
+		uint32_t programOps;
+		uint32_t eraseOps;
+		uint32_t busyPolls;
+		uint32_t cacheHits;
+		uint32_t cacheMisses;
+		uint32_t errors;
+	};
+
+	/*
+	 * @brief NOR flash SPI (W25Qxx) : lecture par lignes de secteur en cache, écritures en file.
+	 *
+	 * Écriture : write() ne bloque pas. Les octets sont recopiés dans une file de pages ; les écritures
+	 * contiguës d'une même page sont fusionnées, une page n'est programmée que pleine (ou sur flush()).
+	 * service() avance d'un pas : une lecture de statut si la puce est occupée, sinon lancement de
+	 * l'opération suivante (WREN + programmation / effacement) et retour immédiat. L'application continue
+	 * de produire pendant tPP / tSE au lieu d'attendre chaque page.
+	 *
+	 * Lecture : read() passe par CacheLines lignes de 4 Ko (un secteur, lu d'un seul Fast Read DMA).
+	 * Les lectures séquentielles suivantes sont servies depuis la RAM, même puce occupée. Les lignes
+	 * reflètent la file : une écriture ou un effacement en file est appliqué aussitôt aux lignes
+	 * présentes, et rejoué sur une ligne chargée ensuite. Un défaut de cache attend la fin de
+	 * l'opération en cours (la puce ne lit pas pendant une programmation).
+	 *
+	 * Aucun effacement implicite : write() programme (les bits ne font que passer de 1 à 0), les secteurs
+	 * à réécrire sont effacés explicitement par erase_sector(), mis en file dans l'ordre des écritures.
+	 *
+	 *   SpiNorFlash<Transport> flash(transport);
+	 *   flash.init();
+	 *   flash.erase_sector(address);                     // secteur neuf du journal
+	 *   flash.write(address, record, sizeof(record));   // tâche productrice
+	 *   while (flash.service()) { ... }                  // tâche de fond, ou à chaque tour de boucle
+	 *
+	 * @tparam Transport SpiNorTransport
+	 * @tparam QueuePages Opérations en file : pages de 256 o ou effacements
+	 * @tparam CacheLines Lignes de 4 Ko
+	 * @note Non réentrant : write(), read(), service() depuis un même thread (ou sous mutex).
+	 **/
+	template <SpiNorTransport Transport, size_t QueuePages = 8, size_t CacheLines = 2>
+	class SpiNorFlash {
+		static_assert(QueuePages >= 2, "SpiNorFlash : au moins deux pages en file (une en vol, une en remplissage)");
+		static_assert(CacheLines >= 1, "SpiNorFlash : au moins une ligne de cache");
+
+	public:
+		static constexpr uint32_t PageSize = 256;
+		static constexpr uint32_t SectorSize = 4096;
+
+		explicit SpiNorFlash(Transport& transport)
+			: m_transport(transport) {}
+
+		/*
+		 * @brief Lit l'identifiant JEDEC et en déduit la capacité (2^octet 3). Attend la fin d'une
+		 * opération laissée en cours (reset à chaud). @return false si la puce ne répond pas.
+		 **/
+		bool init() {
+			const uint8_t header[] = { NorCommand::ReadJedecId };
+			uint8_t* id = m_reply.data();
+			if (!m_transport.command(header, sizeof(header), nullptr, id, 3))
+				return false;
+			m_jedecId = (uint32_t(id[0]) << 16) | (uint32_t(id[1]) << 8) | id[2];
+			if (id[0] == 0x00 || id[0] == 0xFF || id[2] < 16 || id[2] > 24)
+				return false;
+			m_capacity = 1u << id[2];
+			for (auto& line : m_lines)
+				line.valid = false;
+			m_head = m_count = 0;
+			m_inFlight = false;
+			uint8_t status = 0;
+			do {
+				if (!read_status(status))
+					return false;
+			} while (status & NorCommand::StatusBusy);
+			return true;
+		}
+
+		uint32_t jedec_id() const { return m_jedecId; }
+		uint32_t capacity() const { return m_capacity; }
+
+		/*
+		 * @brief Met size octets en file à partir de address. @return octets acceptés (moins que size si
+		 * la file est pleine : appeler service() puis reprendre à address + retour).
+		 **/
+		size_t write(uint32_t address, const uint8_t* data, size_t size) {
+			size_t accepted = 0;
+			while (accepted < size) {
+				if (address >= m_capacity)
+					break;
+				const size_t chunk = std::min<size_t>(size - accepted, PageSize - address % PageSize);
+				if (!append(address, data + accepted, chunk))
+					break;
+				accepted += chunk;
+				address += static_cast<uint32_t>(chunk);
+			}
+			m_stats.bytesWritten += static_cast<uint32_t>(accepted);
+			m_stats.rejected += static_cast<uint32_t>(size - accepted);
+			return accepted;
+		}
+
+		// Met l'effacement du secteur contenant address en file. @return false si la file est pleine
+		bool erase_sector(uint32_t address) {
+			return push_erase(address & ~(SectorSize - 1));
+		}
+
+		/*
+		 * @brief Lit size octets, tels qu'ils seront une fois la file écrite.
+		 * @return false sur erreur de transport ou hors capacité.
+		 **/
+		bool read(uint32_t address, uint8_t* out, size_t size) {
+			if (address + size > m_capacity)
+				return false;
+			while (size > 0) {
+				const uint32_t base = address & ~(SectorSize - 1);
+				Line* line = find_line(base);
+				if (line) {
+					++m_stats.cacheHits;
+				} else {
+					++m_stats.cacheMisses;
+					line = fill_line(base);
+					if (line == nullptr)
+						return false;
+				}
+				const size_t offset = address - base;
+				const size_t chunk = std::min<size_t>(size, SectorSize - offset);
+				std::memcpy(out, line->data.data() + offset, chunk);
+				out += chunk;
+				address += static_cast<uint32_t>(chunk);
+				size -= chunk;
+			}
+			return true;
+		}
+
+		/*
+		 * @brief Un pas de la file. @return true tant qu'il reste du travail (puce occupée ou file non vide).
+		 * Une page partielle en fin de file attend d'être complétée, sauf après flush().
+		 **/
+		bool service() {
+			if (m_inFlight) {
+				if (!poll_completion())
+					return true;
+			}
+			if (m_count == 0) {
+				m_flushing = false;
+				return false;
+			}
+			Op& op = m_queue[m_head];
+			if (op.kind == OpKind::Program && m_count == 1 && op.length < PageSize && !m_flushing)
+				return false; // En attente de la suite de la page
+			issue(op);
+			return true;
+		}
+
+		// Écrit toute la file, pages partielles comprises, et attend la fin de la dernière opération
+		bool flush() {
+			const uint32_t errors = m_stats.errors;
+			m_flushing = true;
+			while (service()) {
+				if (m_stats.errors != errors)
+					return false;
+			}
+			return m_stats.errors == errors;
+		}
+
+		// Opérations en file ou en vol
+		size_t pending() const { return m_count; }
+
+		const NorFlashStats& stats() const { return m_stats; }
+
+	private:
+		enum class OpKind : uint8_t { Program, Erase };
+
+		struct Op {
+			OpKind kind;
+			uint16_t length;
+			uint32_t address;
+			std::array<uint8_t, PageSize> data;
+		};
+
+		struct Line {
+			bool valid = false;
+			uint32_t base = 0;
+			std::array<uint8_t, SectorSize> data {};
+		};
+
+		Op& at(size_t index) { return m_queue[(m_head + index) % QueuePages]; }
+
+		bool append(uint32_t address, const uint8_t* data, size_t size) {
+			// Fusion avec la dernière page en file si elle n'est pas en vol et que l'écriture la prolonge
+			if (m_count > 0 && !(m_inFlight && m_count == 1)) {
+				Op& tail = at(m_count - 1);
+				if (tail.kind == OpKind::Program && tail.address + tail.length == address
+					&& (address / PageSize) == (tail.address / PageSize)) {
+					std::memcpy(tail.data.data() + tail.length, data, size);
+					tail.length = static_cast<uint16_t>(tail.length + size);
+					apply_program(address, data, size);
+					return true;
+				}
+			}
+			if (m_count == QueuePages)
+				return false;
+			Op& op = at(m_count++);
+			op.kind = OpKind::Program;
+			op.address = address;
+			op.length = static_cast<uint16_t>(size);
+			std::memcpy(op.data.data(), data, size);
+			apply_program(address, data, size);
+			return true;
+		}
+
+		bool push_erase(uint32_t base) {
+			if (m_count == QueuePages || base >= m_capacity)
+				return false;
+			Op& op = at(m_count++);
+			op.kind = OpKind::Erase;
+			op.address = base;
+			op.length = 0;
+			if (Line* line = find_line(base))
+				line->data.fill(0xFF);
+			return true;
+		}
+
+		// Programmation NOR : les bits ne peuvent que passer de 1 à 0
+		void apply_program(uint32_t address, const uint8_t* data, size_t size) {
+			if (Line* line = find_line(address & ~(SectorSize - 1)))
+				and_into(*line, address, data, size);
+		}
+
+		static void and_into(Line& line, uint32_t address, const uint8_t* data, size_t size) {
+			uint8_t* dst = line.data.data() + (address - line.base);
+			for (size_t i = 0; i < size; ++i)
+				dst[i] &= data[i];
+		}
+
+		Line* find_line(uint32_t base) {
+			for (auto& line : m_lines)
+				if (line.valid && line.base == base)
+					return &line;
+			return nullptr;
+		}
+
+		// Charge un secteur (Fast Read d'un bloc) puis y rejoue la file
+		Line* fill_line(uint32_t base) {
+			const uint32_t errors = m_stats.errors;
+			while (m_inFlight) {
+				poll_completion();
+				if (m_stats.errors != errors)
+					return nullptr;
+			}
+			Line& line = m_lines[m_victim];
+			m_victim = (m_victim + 1) % CacheLines;
+			line.valid = false;
+			const uint8_t header[] = { NorCommand::FastRead, uint8_t(base >> 16), uint8_t(base >> 8), uint8_t(base), 0x00 };
+			if (!m_transport.command(header, sizeof(header), nullptr, line.data.data(), SectorSize)) {
+				++m_stats.errors;
+				return nullptr;
+			}
+			line.base = base;
+			line.valid = true;
+			for (size_t i = 0; i < m_count; ++i) {
+				const Op& op = at(i);
+				if ((op.address & ~(SectorSize - 1)) != base)
+					continue;
+				if (op.kind == OpKind::Erase)
+					line.data.fill(0xFF);
+				else
+					and_into(line, op.address, op.data.data(), op.length);
+			}
+			return &line;
+		}
+
+		bool read_status(uint8_t& status) {
+			const uint8_t header[] = { NorCommand::ReadStatus1 };
+			if (!m_transport.command(header, sizeof(header), nullptr, m_reply.data(), 1))
+				return false;
+			status = m_reply[0];
+			return true;
+		}
+
+		// @return true si l'opération en vol est terminée (retirée de la file)
+		bool poll_completion() {
+			uint8_t status = 0;
+			if (!read_status(status)) {
+				++m_stats.errors;
+				return false;
+			}
+			if (status & NorCommand::StatusBusy) {
+				++m_stats.busyPolls;
+				return false;
+			}
+			m_inFlight = false;
+			m_head = (m_head + 1) % QueuePages;
+			--m_count;
+			return true;
+		}
+
+		void issue(const Op& op) {
+			const uint8_t wren[] = { NorCommand::WriteEnable };
+			const uint8_t header[] = {
+				op.kind == OpKind::Erase ? NorCommand::SectorErase : NorCommand::PageProgram,
+				uint8_t(op.address >> 16), uint8_t(op.address >> 8), uint8_t(op.address),
+			};
+			const bool ok = m_transport.command(wren, sizeof(wren), nullptr, nullptr, 0)
+				&& (op.kind == OpKind::Erase
+					? m_transport.command(header, sizeof(header), nullptr, nullptr, 0)
+					: m_transport.command(header, sizeof(header), op.data.data(), nullptr, op.length));
+			if (!ok) {
+				// Opération abandonnée : retirée pour ne pas bloquer la file
+				++m_stats.errors;
+				m_head = (m_head + 1) % QueuePages;
+				--m_count;
+				return;
+			}
+			if (op.kind == OpKind::Erase)
+				++m_stats.eraseOps;
+			else
+				++m_stats.programOps;
+			m_inFlight = true;
+		}
+
+		Transport& m_transport;
+		std::array<Op, QueuePages> m_queue {};
+		std::array<Line, CacheLines> m_lines {};
+		size_t m_head = 0;
+		size_t m_count = 0;
+		size_t m_victim = 0;
+		bool m_inFlight = false;
+		bool m_flushing = false;
+		uint32_t m_jedecId = 0;
+		uint32_t m_capacity = 0;
+		NorFlashStats m_stats {};
+		std::array<uint8_t, 3> m_reply {}; // Réponse JEDEC / statut : membre, reste valide si la commande expire
+	};
+
+} // namespace Devices
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SpiNorFlash.hpp"
+
+namespace Devices {
+
+	/*
+	 * @brief Temps caractéristiques de la puce simulée (W25Q128JV, valeurs typiques de la fiche technique)
+	 * et du lien SPI. transactionOverheadNs : CS, démarrage DMA, réveil du thread.
+	 **/
+	struct NorFlashTiming {
+		uint32_t sckHz = 21000000;
+		uint32_t transactionOverheadNs = 2000;
+		uint32_t pageProgramUs = 400;
+		uint32_t sectorEraseUs = 45000;
+	};
+
+	/*
+	 * @brief Compteurs de la puce simulée.
+	 * programmedBytes : octets réellement transmis en Page Program ; violations : commande refusée par la
+	 * puce (puce occupée, WEL absent, page débordée) — doit rester à 0 avec un driver correct.
+	 **/
+	struct NorFlashSimStats {
+		uint64_t elapsedNs;
+		uint32_t commands;
+		uint32_t statusPolls;
+		uint32_t programOps;
+		uint32_t programmedBytes;
+		uint32_t eraseOps;
+		uint32_t readBytes;
+		uint32_t violations;
+	};
+
+	/*
+	 * @brief NOR SPI simulée, sans HAL : se branche comme transport de SpiNorFlash pour mesurer sur PC
+	 * débit et amplification d'écriture. Le temps est virtuel : chaque commande coûte sa durée sur le
+	 * lien, programmation et effacement tiennent la puce occupée (WIP) pendant tPP / tSE.
+	 * Sémantique NOR : la programmation fait un ET (1 -> 0 seulement), une page déborde en rebouclant
+	 * sur son début, l'effacement remet un secteur à 0xFF.
+	 *
+	 *   SpiNorFlashSim<> sim;
+	 *   SpiNorFlash<SpiNorFlashSim<>> flash(sim);
+	 *   flash.init();
+	 *   for (...) { if (address % 4096 == 0) flash.erase_sector(address); flash.write(address, record, 32); address += 32; flash.service(); sim.advance_us(50); }
+	 *   flash.flush();
+	 *   // débit : flash.stats().bytesWritten * 1e9 / sim.stats().elapsedNs
+	 *
+	 * @tparam CapacityLog2 Capacité = 2^CapacityLog2 octets (20 : 1 Mo, 24 : 16 Mo)
+	 **/
+	template <uint8_t CapacityLog2 = 20>
+	class SpiNorFlashSim {
+		static_assert(CapacityLog2 >= 16 && CapacityLog2 <= 24, "SpiNorFlashSim : adresses 24 bits");
+
+	public:
+		static constexpr uint32_t Capacity = 1u << CapacityLog2;
+		static constexpr uint32_t PageSize = 256;
+		static constexpr uint32_t SectorSize = 4096;
+
+		explicit SpiNorFlashSim(NorFlashTiming timing = {})
+			: m_timing(timing)
+			, m_memory(Capacity, 0xFF) {}
+
+		bool command(const uint8_t* header, size_t headerSize, const uint8_t* tx, uint8_t* rx, size_t size) {
+			m_stats.elapsedNs += m_timing.transactionOverheadNs
+				+ (uint64_t(headerSize + size) * 8u * 1000000000ull) / m_timing.sckHz;
+			++m_stats.commands;
+			if (headerSize == 0)
+				return false;
+
+			const bool busy = m_stats.elapsedNs < m_busyUntilNs;
+			const uint8_t opcode = header[0];
+			const uint32_t address = headerSize >= 4 ? (uint32_t(header[1]) << 16) | (uint32_t(header[2]) << 8) | header[3] : 0;
+
+			if (busy && opcode != NorCommand::ReadStatus1) {
+				++m_stats.violations; // Ignorée par la puce
+				if (rx)
+					std::fill(rx, rx + size, 0xFF);
+				return true;
+			}
+
+			switch (opcode) {
+			case NorCommand::ReadJedecId: {
+				const uint8_t id[3] = { 0xEF, 0x40, CapacityLog2 };
+				for (size_t i = 0; rx && i < size; ++i)
+					rx[i] = i < 3 ? id[i] : 0xFF;
+				break;
+			}
+			case NorCommand::ReadStatus1:
+				++m_stats.statusPolls;
+				if (rx && size > 0)
+					rx[0] = static_cast<uint8_t>((busy ? NorCommand::StatusBusy : 0u) | (m_wel ? NorCommand::StatusWel : 0u));
+				break;
+			case NorCommand::WriteEnable:
+				m_wel = true;
+				break;
+			case NorCommand::PageProgram: {
+				if (!m_wel || tx == nullptr || size > PageSize - address % PageSize) {
+					++m_stats.violations;
+					if (!m_wel || tx == nullptr)
+						break;
+				}
+				const uint32_t page = address & ~(PageSize - 1) & (Capacity - 1);
+				for (size_t i = 0; i < size; ++i)
+					m_memory[page + (address + i) % PageSize] &= tx[i];
+				m_wel = false;
+				m_busyUntilNs = m_stats.elapsedNs + uint64_t(m_timing.pageProgramUs) * 1000u;
+				++m_stats.programOps;
+				m_stats.programmedBytes += static_cast<uint32_t>(size);
+				break;
+			}
+			case NorCommand::SectorErase:
+				if (!m_wel) {
+					++m_stats.violations;
+					break;
+				}
+				std::fill_n(m_memory.begin() + (address & ~(SectorSize - 1) & (Capacity - 1)), SectorSize, 0xFF);
+				m_wel = false;
+				m_busyUntilNs = m_stats.elapsedNs + uint64_t(m_timing.sectorEraseUs) * 1000u;
+				++m_stats.eraseOps;
+				break;
+			case NorCommand::FastRead:
+			case 0x03: // Read (sans octet factice)
+				for (size_t i = 0; rx && i < size; ++i)
+					rx[i] = m_memory[(address + i) & (Capacity - 1)];
+				m_stats.readBytes += static_cast<uint32_t>(size);
+				break;
+			default:
+				++m_stats.violations;
+				break;
+			}
+			return true;
+		}
+
+		// Temps passé par l'application hors flash (production des données, autres tâches)
+		void advance_us(uint32_t us) {
+			m_stats.elapsedNs += uint64_t(us) * 1000u;
+		}
+
+		const NorFlashSimStats& stats() const { return m_stats; }
+
+		// Contenu brut, pour vérification
+		const uint8_t* memory() const { return m_memory.data(); }
+
+	private:
+		NorFlashTiming m_timing;
+		std::vector<uint8_t> m_memory;
+		uint64_t m_busyUntilNs = 0;
+		bool m_wel = false;
+		NorFlashSimStats m_stats {};
+	};
+
+} // namespace Devices
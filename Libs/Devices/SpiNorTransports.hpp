@@ -0,0 +1,93 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "SpiNorFlash.hpp"
+#include "SpiBus.hpp"
+#include "SpiStatic.hpp"
+#include "GpioStatic.hpp"
+#include "Semaphore.hpp"
+
+namespace Devices {
+
+	/*
+	 * @brief Transport NOR sur un bus partagé (SpiBus) : header et données en une seule transaction DMA
+	 * (Fast Read d'un secteur = un seul bloc de 4 Ko), le thread appelant dort sur semaphore pendant le transfert.
+	 * Transaction et header sont des membres : après un délai écoulé, command() renvoie false et la transaction
+	 * finit au bus ; la commande suivante l'attend d'abord (SpiBus::wait).
+	 * @tparam Bus Wrapper::SpiBus<...>
+	 * @tparam Device Wrapper::SpiDevice<...> de la flash
+	 * @note tx / rx ne sont pas copiés : ce sont les membres de SpiNorFlash (file, cache, réponse), qui
+	 * survivent à une commande en délai écoulé. En SRAM1/SRAM2, pas en CCM.
+	 **/
+	template <typename Bus, typename Device>
+	class SpiBusNorTransport {
+	public:
+		static constexpr size_t MaxHeader = 8;
+
+		explicit SpiBusNorTransport(Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = 1000)
+			: m_semaphore(semaphore)
+			, m_timeoutMs(timeoutMs) {}
+
+		bool command(const uint8_t* header, size_t headerSize, const uint8_t* tx, uint8_t* rx, size_t size) {
+			if (size > 0xFFFFu || headerSize > MaxHeader || !Bus::wait(m_transaction, m_semaphore, m_timeoutMs))
+				return false;
+			std::memcpy(m_header, header, headerSize);
+			m_data = { tx, rx, static_cast<uint16_t>(size) };
+			m_head = { m_header, nullptr, static_cast<uint16_t>(headerSize), &m_data };
+			m_transaction = { &Device::Info, &m_head };
+			return Bus::transfer(m_transaction, m_semaphore, m_timeoutMs);
+		}
+
+	private:
+		Rtos::Abstract::ISemaphore& m_semaphore;
+		uint32_t m_timeoutMs;
+		uint8_t m_header[MaxHeader] = { };
+		Wrapper::SpiSegment m_data {};
+		Wrapper::SpiSegment m_head {};
+		Wrapper::SpiTransaction m_transaction {};
+	};
+
+	/*
+	 * @brief Transport NOR sur un port dédié (SpiStatic) : header par le chemin registre (exchange),
+	 * données par HAL_SPI_Transmit / HAL_SPI_Receive bloquants. CS piloté par GPIO.
+	 * @tparam config SpiStaticConfig du port (maître, full-duplex, 8 bits)
+	 * @tparam CsPin GpioStaticConfig du chip select, en sortie
+	 **/
+	template <SpiConfigPolicy config, GpioConfigPolicy CsPin>
+	class SpiStaticNorTransport {
+		static_assert(config::DataSize == Wrapper::SpiDataSize::Data8Bit, "SpiStaticNorTransport : trames de 8 bits");
+
+	public:
+		explicit SpiStaticNorTransport(Wrapper::SpiStatic<config>& spi, uint32_t timeoutMs = 100)
+			: m_spi(spi)
+			, m_timeoutMs(timeoutMs) {}
+
+		// CS en sortie, relâché ; le port SPI est initialisé par son propriétaire
+		void init() {
+			m_cs.init();
+			m_cs.set_high();
+		}
+
+		bool command(const uint8_t* header, size_t headerSize, const uint8_t* tx, uint8_t* rx, size_t size) {
+			if (size > 0xFFFFu)
+				return false;
+			m_cs.set_low();
+			bool ok = m_spi.exchange(header, nullptr, headerSize) == HAL_OK;
+			if (ok && size > 0) {
+				const uint16_t frames = static_cast<uint16_t>(size);
+				ok = (tx ? m_spi.transmit(tx, frames, m_timeoutMs) : m_spi.receive(rx, frames, m_timeoutMs)) == HAL_OK;
+			}
+			m_cs.set_high();
+			return ok;
+		}
+
+	private:
+		Wrapper::SpiStatic<config>& m_spi;
+		Wrapper::GpioStatic<CsPin> m_cs;
+		uint32_t m_timeoutMs;
+	};
+
+} // namespace Devices
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include "CriticalSection.hpp"
+#include "CycleCounter.hpp"
+
+/*
+ * @brief Journal binaire différé : un site de log n'écrit que l'adresse de son descripteur, un
+ * horodatage et ses arguments bruts (mots de 32 bits) dans un anneau en RAM. Aucun formatage sur cible.
+ * Le texte est reconstruit sur PC par tools/log_decode.py à partir de l'ELF.
+ *
+ *   LOG_INFO("consigne %d mA, erreur %f", target, error);
+ *
+ * Descripteur d'un site : "niveau\0fichier\0ligne\0format", placé dans sa propre section
+ * .logfmt.<ligne>.<compteur> (INFO, non chargée : ne coûte pas de flash). Son adresse sert d'identifiant.
+ * @note Une section par site (__COUNTER__) : dans une fonction inline (membre défini dans un en-tête),
+ * le descripteur est un objet COMDAT et ne doit pas partager sa section avec celui d'une fonction non
+ * inline de même ligne (GCC : "section type conflict"). Il reste en .logfmt dans les deux cas.
+ * Seule exception, la fonction template : GCC y ignore l'attribut section et le descripteur part en
+ * .rodata (en flash). Le décodage fonctionne de la même façon, seule l'économie de flash est perdue.
+ *
+ * Enregistrement : [descripteur][CYCCNT][arg0][arg1]...
+ * Entiers et pointeurs : 1 mot, entiers 64 bits : 2 mots (poids faible d'abord), flottants : 1 mot
+ * (float). %s n'est accepté que pour des chaînes en flash (littéraux) : seule l'adresse est écrite.
+ * Les arguments sont vérifiés contre le format à la compilation (-Wformat).
+ *
+ * Filtrage : LOG_LEVEL (défaut LOG_LEVEL_DEBUG) ; les sites sous ce niveau disparaissent au
+ * préprocesseur, arguments compris (ne pas y mettre d'effets de bord).
+ * Taille de l'anneau : LOG_BUFFER_WORDS mots (puissance de 2, défaut 1024 = 4 Ko).
+ **/
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE  4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#ifndef LOG_BUFFER_WORDS
+#define LOG_BUFFER_WORDS 1024
+#endif
+
+#define LOG_STRINGIFY_(x) #x
+#define LOG_STRINGIFY(x) LOG_STRINGIFY_(x)
+
+#define LOG_RECORD(level, fmt, ...) do { \
+	__attribute__((section(".logfmt." LOG_STRINGIFY(__LINE__) "." LOG_STRINGIFY(__COUNTER__)), used)) \
+	static const char logEntry[] = #level "\0" __FILE__ "\0" LOG_STRINGIFY(__LINE__) "\0" fmt; \
+	if (false) ::Logging::Detail::check_format(fmt __VA_OPT__(,) __VA_ARGS__); \
+	::Logging::Logger::write(logEntry __VA_OPT__(,) __VA_ARGS__); \
+} while (0)
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(fmt, ...) LOG_RECORD(D, fmt __VA_OPT__(,) __VA_ARGS__)
+#else
+#define LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(fmt, ...) LOG_RECORD(I, fmt __VA_OPT__(,) __VA_ARGS__)
+#else
+#define LOG_INFO(fmt, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(fmt, ...) LOG_RECORD(W, fmt __VA_OPT__(,) __VA_ARGS__)
+#else
+#define LOG_WARN(fmt, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(fmt, ...) LOG_RECORD(E, fmt __VA_OPT__(,) __VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+namespace Logging {
+
+	namespace Detail {
+
+		// Jamais appelée : porte uniquement la vérification printf des arguments
+		__attribute__((format(printf, 1, 2))) inline void check_format(const char*, ...) {}
+
+		template <typename T>
+		constexpr size_t word_count() {
+			using U = std::decay_t<T>;
+			if constexpr ((std::is_integral_v<U> || std::is_enum_v<U>) && sizeof(U) > 4)
+				return 2;
+			else
+				return 1;
+		}
+
+		template <typename T>
+		inline uint32_t* encode(uint32_t* out, T value) {
+			using U = std::decay_t<T>;
+			if constexpr (std::is_floating_point_v<U>) {
+				*out++ = std::bit_cast<uint32_t>(static_cast<float>(value));
+			} else if constexpr (std::is_pointer_v<U>) {
+				*out++ = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value));
+			} else if constexpr (std::is_enum_v<U>) {
+				return encode(out, static_cast<std::underlying_type_t<U>>(value));
+			} else {
+				static_assert(std::is_integral_v<U>, "LOG : type d'argument non journalisable");
+				if constexpr (sizeof(U) > 4) {
+					const uint64_t raw = static_cast<uint64_t>(value);
+					*out++ = static_cast<uint32_t>(raw);
+					*out++ = static_cast<uint32_t>(raw >> 32);
+				} else {
+					*out++ = static_cast<uint32_t>(value);
+				}
+			}
+			return out;
+		}
+
+		__attribute__((section(".logfmt.dropped"), used))
+		inline constexpr char DroppedEntry[] = "W\0" __FILE__ "\0" LOG_STRINGIFY(__LINE__) "\0%u messages perdus";
+
+	} // namespace Detail
+
+	/*
+	 * @brief Anneau du journal : plusieurs producteurs (threads, ISR), un seul consommateur (le puits).
+	 * write() masque les interruptions le temps de copier quelques mots (~40 cycles pour 2 arguments) ;
+	 * anneau plein : l'enregistrement est perdu et compté, un message "perdus" le précède dès qu'il y a
+	 * de la place. Le consommateur lit sur place (peek / consume), sans copie.
+	 **/
+	class Logger {
+		static constexpr size_t Size = LOG_BUFFER_WORDS;
+		static_assert(Size >= 16 && (Size & (Size - 1)) == 0, "Logger : LOG_BUFFER_WORDS doit être une puissance de 2");
+
+	public:
+		static constexpr size_t Mask = Size - 1;
+
+		// Active CYCCNT pour l'horodatage (les enregistrements sont datés en cycles HCLK)
+		static void init() {
+			if (!Hal::CycleCounter::is_enabled())
+				Hal::CycleCounter::enable();
+		}
+
+		template <typename... Args>
+		static void write(const char* entry, Args... args) {
+			constexpr size_t count = 2 + (size_t { 0 } + ... + Detail::word_count<Args>());
+			static_assert(count <= 16, "LOG : trop d'arguments");
+
+			uint32_t record[count];
+			record[0] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(entry));
+			record[1] = Hal::CycleCounter::now();
+			[[maybe_unused]] uint32_t* out = record + 2;
+			((out = Detail::encode(out, args)), ...);
+
+			Hal::CriticalSection lock;
+			uint32_t head = m_head.load(std::memory_order_relaxed);
+			uint32_t free = Size - (head - m_tail.load(std::memory_order_acquire));
+			if (m_dropped != 0) {
+				if (free < count + 3) {
+					++m_dropped;
+					return;
+				}
+				const uint32_t dropped[3] = { static_cast<uint32_t>(reinterpret_cast<uintptr_t>(Detail::DroppedEntry)), record[1], m_dropped };
+				head = copy(head, dropped, 3);
+				m_dropped = 0;
+			} else if (free < count) {
+				++m_dropped;
+				return;
+			}
+			m_head.store(copy(head, record, count), std::memory_order_release);
+		}
+
+		// --- Côté consommateur ---
+		// Mots contigus disponibles (s'arrête en fin de tampon : rappeler après consume)
+		static std::span<const uint32_t> peek() {
+			const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+			const uint32_t available = m_head.load(std::memory_order_acquire) - tail;
+			const uint32_t start = tail & Mask;
+			const uint32_t contiguous = (available < Size - start) ? available : Size - start;
+			return { &m_buffer[start], contiguous };
+		}
+
+		static void consume(size_t words) {
+			m_tail.store(m_tail.load(std::memory_order_relaxed) + static_cast<uint32_t>(words), std::memory_order_release);
+		}
+
+		static size_t pending() {
+			return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+		}
+
+		static constexpr size_t capacity() {
+			return Size;
+		}
+
+	private:
+		static uint32_t copy(uint32_t head, const uint32_t* words, size_t count) {
+			for (size_t i = 0; i < count; ++i)
+				m_buffer[(head + i) & Mask] = words[i];
+			return head + static_cast<uint32_t>(count);
+		}
+
+		inline static uint32_t m_buffer[Size] {};
+		inline static std::atomic<uint32_t> m_head { 0 };
+		inline static std::atomic<uint32_t> m_tail { 0 };
+		inline static uint32_t m_dropped = 0; // Protégé par la section critique
+	};
+
+} // namespace Logging
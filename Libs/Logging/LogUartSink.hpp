@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Log.hpp"
+#include "UartTxQueue.hpp"
+
+using namespace Wrapper;
+
+namespace Logging {
+
+	/*
+	 * @brief Vide le journal sur un port UART par la file DMA (UartTxQueue), sans copie : le DMA lit
+	 * directement l'anneau, qui n'est libéré qu'à la fin du transfert.
+	 * Une fois lancé, le vidage se poursuit seul depuis l'ISR DMA tant que l'anneau n'est pas vide ;
+	 * flush() ne sert qu'à le relancer après une période de repos (tâche de fond, tick, boucle idle).
+	 *
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream6, UartTxDmaIrq<LogUart>)
+	 *   uart.init();
+	 *   uart.start_tx_queue();
+	 *   Logger::init();
+	 *   ...
+	 *   LogUartSink<UartPort::USART_2>::flush(); // périodiquement
+	 *
+	 * Le flux émis est la suite brute des enregistrements (mots petit-boutistes) : log_decode.py le lit
+	 * tel quel et se resynchronise seul sur un identifiant connu.
+	 **/
+	template <UartPort port>
+	class LogUartSink {
+		// Bloc DMA maximal (NDTR 16 bits), multiple d'un mot
+		static constexpr size_t MaxChunkWords = 0xFFFCu / 4;
+
+	public:
+		// Appelable depuis n'importe quel contexte de priorité inférieure ou égale au stream DMA
+		static void flush() {
+			if (m_inFlight.exchange(true, std::memory_order_acquire))
+				return;
+			for (;;) {
+				const std::span<const uint32_t> words = Logger::peek();
+				if (!words.empty()) {
+					const size_t count = (words.size() < MaxChunkWords) ? words.size() : MaxChunkWords;
+					m_chunk.data = reinterpret_cast<const uint8_t*>(words.data());
+					m_chunk.size = static_cast<uint16_t>(count * 4);
+					m_chunk.next = nullptr;
+					m_chunk.release = Callback<UartTxDescriptor*>::from<&on_sent>();
+					UartTxQueue<port>::send(m_chunk);
+					return;
+				}
+				m_inFlight.store(false, std::memory_order_seq_cst);
+				// Un enregistrement arrivé entre peek() et la remise à zéro serait sinon oublié
+				if (Logger::pending() == 0 || m_inFlight.exchange(true, std::memory_order_acquire))
+					return;
+			}
+		}
+
+		static bool idle() {
+			return !m_inFlight.load(std::memory_order_acquire);
+		}
+
+	private:
+		// ISR DMA : le bloc est lu, on le rend à l'anneau et on enchaîne
+		static void on_sent(UartTxDescriptor* chunk) {
+			Logger::consume(chunk->size / 4);
+			m_inFlight.store(false, std::memory_order_release);
+			flush();
+		}
+
+		inline static UartTxDescriptor m_chunk {};
+		inline static std::atomic<bool> m_inFlight { false };
+	};
+
+} // namespace Logging
@@ -60,20 +60,35 @@ public:
         }
     }
 
+    /**
+     * @brief Libère le sémaphore depuis une routine de service d'interruption (ISR).
+     * Utilise xSemaphoreGiveFromISR ; si une tâche plus prioritaire est réveillée, la commutation
+     * a lieu en sortie d'ISR (portYIELD_FROM_ISR).
+     * @note L'ISR doit avoir une priorité numériquement >= configMAX_SYSCALL_INTERRUPT_PRIORITY.
+     */
+    void give_from_isr() noexcept override {
+        if (m_semaphoreHandle == nullptr) {
+            return;
+        }
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        xSemaphoreGiveFromISR(m_semaphoreHandle, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+
     /**
      * @brief Tente de prendre (acquérir) le sémaphore, bloquant pendant le délai spécifié.
      * Utilise xSemaphoreTake.
-     * @param timeout Délai d'attente maximal en millisecondes.
+     * @param timeout_ms Délai d'attente maximal en millisecondes (UINT32_MAX : attente infinie).
      * @return true Si le sémaphore a été pris avec succès avant l'expiration du délai.
      * @return false Si le délai a expiré.
      */
-    bool take(std::chrono::milliseconds timeout) noexcept override {
+    bool take(uint32_t timeout_ms) noexcept override {
         if (m_semaphoreHandle == nullptr) {
             return false;
         }
         
         // Conversion du délai d'attente en millisecondes vers des Ticks FreeRTOS.
-        TickType_t ticksToWait = msToTicks(timeout);
+        TickType_t ticksToWait = msToTicks(std::chrono::milliseconds(timeout_ms));
 
         // xSemaphoreTake est la primitive FreeRTOS.
         BaseType_t result = xSemaphoreTake(m_semaphoreHandle, ticksToWait);
@@ -128,7 +143,7 @@ private:
         // Détection de l'attente infinie (si l'utilisateur utilise une très grande valeur)
         // Nous allons utiliser une valeur conventionnelle (par exemple, la plus grande possible pour un uint32_t)
         // pour représenter l'attente infinie.
-        if (timeoutMs == std::chrono::milliseconds::max().count()) { 
+        if (timeoutMs == UINT32_MAX) { 
              return portMAX_DELAY;
         }
 
@@ -8,6 +8,8 @@ class ISemaphore {
 public:
     virtual ~ISemaphore() = default;
     virtual void give() noexcept = 0;
+    // From an interrupt handler: wakes the waiting thread without blocking
+    virtual void give_from_isr() noexcept = 0;
     // timeout in milliseconds
     virtual bool take(uint32_t timeout_ms) noexcept = 0;
     virtual bool take_from_isr() noexcept = 0;
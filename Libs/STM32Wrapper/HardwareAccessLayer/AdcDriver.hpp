@@ -2,15 +2,16 @@
 
 #include "IAdcDriver.hpp"
 #include "stm32f4xx_hal_adc.h"
-#include <map>
+#include "HandleRegistry.hpp"
 #include <cassert>
 
 namespace Hal {
 
-	struct HalAdcDriver : public IAdcDriver {
+	struct HalAdcDriver {
 
-		// Stocke un handle HAL pour chaque périphérique ADC (1, 2, 3)
-		inline static std::map<AdcPort, ADC_HandleTypeDef> adcHandles;
+		// Un handle HAL statique par périphérique ADC (1, 2, 3), indexé par le port
+		static constexpr size_t PortCount = 3;
+		using Handles = HandleRegistry<AdcPort, ADC_HandleTypeDef, PortCount>;
         
 		/// <summary>
 		/// @brief Initialise le périphérique ADC (une seule fois par port).
@@ -20,11 +21,11 @@ namespace Hal {
 				enable_clock(config::Port);
 
 				// Vérifie si l'init a déjà été faite pour ce port
-				if (adcHandles.find(config::Port) != adcHandles.end()) {
+				if (Handles::is_initialized(config::Port)) {
 					return; // Déjà initialisé
 				}
             
-				ADC_HandleTypeDef* pHandle = &adcHandles[config::Port];
+				ADC_HandleTypeDef* pHandle = &Handles::template at<config::Port>();
 				pHandle->Instance = MapPort(config::Port);
 
 				// Configuration de base (non-continu, trigger logiciel)
@@ -52,14 +53,14 @@ namespace Hal {
 				sConfig.Rank = 1; // Rang 1 (une seule conversion)
 				sConfig.SamplingTime = MapSampleTime(config::SampleTime);
             
-				HAL_ADC_ConfigChannel(&adcHandles[config::Port], &sConfig);
+				HAL_ADC_ConfigChannel(&Handles::template at<config::Port>(), &sConfig);
 			}
         
 		/// <summary>
 		/// @brief Lit une valeur en mode blocant (polling).
 		/// </summary>
-		uint32_t read(AdcPort port) override {
-			ADC_HandleTypeDef* pHandle = &adcHandles[port];
+		uint32_t read(AdcPort port) {
+			ADC_HandleTypeDef* pHandle = &Handles::at(port);
             
 			HAL_ADC_Start(pHandle);
 			// Attend la fin de la conversion (10ms timeout)
@@ -137,4 +138,6 @@ namespace Hal {
 		}
 	};
 
+	static_assert(AdcDriverConcept<HalAdcDriver>, "HalAdcDriver ne respecte pas AdcDriverConcept");
+
 } // namespace Hal
\ No newline at end of file
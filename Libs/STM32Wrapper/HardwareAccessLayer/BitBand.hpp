@@ -0,0 +1,111 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+namespace Hal {
+
+	/*
+	 * @brief Accès bit-band du Cortex-M4.
+	 * Chaque bit des régions périphériques (0x40000000, 1 Mo) et SRAM (0x20000000, 1 Mo : SRAM1/SRAM2)
+	 * est aussi visible comme un mot dans une région alias. Écrire 0/1 dans ce mot modifie le seul bit visé,
+	 * le lire renvoie 0/1 : le read-modify-write est fait par le bus, sans fenêtre où une ISR pourrait
+	 * intercaler sa propre écriture sur le même registre.
+	 * @note La CCM (0x10000000) et le backup SRAM ne sont pas couverts par le bit-band.
+	 **/
+	struct BitBand {
+		static constexpr uint32_t PeriphBase      = PERIPH_BASE;
+		static constexpr uint32_t PeriphAliasBase = PERIPH_BB_BASE;
+		static constexpr uint32_t SramBase        = SRAM1_BASE;
+		static constexpr uint32_t SramAliasBase   = SRAM1_BB_BASE;
+		static constexpr uint32_t RegionSize      = 0x100000u;
+
+		static constexpr bool InPeriphRegion(uint32_t address) {
+			return address >= PeriphBase && address - PeriphBase < RegionSize;
+		}
+
+		static constexpr bool InSramRegion(uint32_t address) {
+			return address >= SramBase && address - SramBase < RegionSize;
+		}
+
+		static constexpr uint32_t PeriphAlias(uint32_t regAddress, uint32_t bit) {
+			return PeriphAliasBase + (regAddress - PeriphBase) * 32u + bit * 4u;
+		}
+
+		static constexpr uint32_t SramAlias(uint32_t address, uint32_t bit) {
+			return SramAliasBase + (address - SramBase) * 32u + bit * 4u;
+		}
+
+		// Index du bit d'un masque à un seul bit
+		static constexpr uint32_t BitIndex(uint32_t mask) {
+			return static_cast<uint32_t>(std::countr_zero(mask));
+		}
+
+		/*
+		 * @brief Mot alias d'un bit de registre périphérique, adresse résolue à la compilation.
+		 **/
+		template <uint32_t RegAddress, uint32_t Bit>
+		static inline volatile uint32_t& periph() {
+			static_assert(InPeriphRegion(RegAddress), "BitBand : registre hors de la région périphérique");
+			static_assert(Bit < 32, "BitBand : bit hors registre");
+			return *reinterpret_cast<volatile uint32_t*>(PeriphAlias(RegAddress, Bit));
+		}
+
+		/*
+		 * @brief Mot alias d'un bit de registre périphérique dont l'adresse n'est connue qu'à l'exécution.
+		 **/
+		static inline volatile uint32_t& periph(uint32_t regAddress, uint32_t bit) {
+			return *reinterpret_cast<volatile uint32_t*>(PeriphAlias(regAddress, bit));
+		}
+
+		/*
+		 * @brief Mot alias d'un bit d'une variable en SRAM1/SRAM2.
+		 **/
+		static inline volatile uint32_t& sram(const volatile uint32_t* word, uint32_t bit) {
+			const uint32_t address = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(word));
+			assert(InSramRegion(address) && "BitBand : variable hors SRAM1/SRAM2 (CCM ?)");
+			return *reinterpret_cast<volatile uint32_t*>(SramAlias(address, bit));
+		}
+	};
+
+	/*
+	 * @brief Jeu de 32 drapeaux partagés entre ISR et threads, modifiés bit par bit via l'alias SRAM.
+	 * set()/clear() sont un seul store : pas de section critique, pas de perte si une ISR modifie
+	 * un autre drapeau du même mot au même moment.
+	 * L'objet doit résider en SRAM1/SRAM2 (pas en CCM ni sur une pile placée en CCM).
+	 *
+	 * Exemple :
+	 *   inline BitBandFlags g_events;
+	 *   g_events.set(RxDone);            // ISR
+	 *   if (g_events.test(RxDone)) { g_events.clear(RxDone); ... } // thread
+	 **/
+	class BitBandFlags {
+	public:
+		inline void set(uint32_t bit) {
+			BitBand::sram(&m_word, bit) = 1u;
+		}
+
+		inline void clear(uint32_t bit) {
+			BitBand::sram(&m_word, bit) = 0u;
+		}
+
+		inline void write(uint32_t bit, bool value) {
+			BitBand::sram(&m_word, bit) = value ? 1u : 0u;
+		}
+
+		inline bool test(uint32_t bit) const {
+			return BitBand::sram(&m_word, bit) != 0u;
+		}
+
+		// Instantané de tous les drapeaux (une lecture du mot)
+		inline uint32_t value() const {
+			return m_word;
+		}
+
+	private:
+		alignas(4) volatile uint32_t m_word = 0;
+	};
+
+} // namespace Hal
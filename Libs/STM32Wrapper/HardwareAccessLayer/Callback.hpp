@@ -0,0 +1,61 @@
+#pragma once
+
+#include <type_traits>
+
+namespace Hal {
+
+	/*
+	 * @brief Callback d'interruption sans allocation : pointeur de fonction + contexte.
+	 * Remplace std::function dans les tables de dispatch : taille fixe (2 mots), copie triviale,
+	 * appel = un seul saut indirect, aucune allocation à l'enregistrement.
+	 *
+	 * Exemples :
+	 *   Callback<>::from<&on_button>()            // fonction libre
+	 *   Callback<>::from<&Motor::on_tick>(&motor) // méthode d'un objet
+	 *   Callback<> { [] { ... } }                 // lambda sans capture
+	 **/
+	template <typename... Args>
+	struct Callback {
+		using Function = void (*)(void*, Args...);
+
+		Function function = nullptr;
+		void* context = nullptr;
+
+		constexpr Callback() = default;
+		constexpr Callback(Function fn, void* ctx)
+			: function(fn)
+			, context(ctx) {}
+
+		// Fonction libre ou lambda sans capture
+		template <typename F>
+			requires (std::is_convertible_v<F, void (*)(Args...)> && !std::is_same_v<std::decay_t<F>, Callback>)
+		Callback(F fn)
+			: function(&invoke_free)
+			, context(reinterpret_cast<void*>(static_cast<void (*)(Args...)>(fn))) {}
+
+		template <auto Fn>
+		static constexpr Callback from() {
+			return Callback([](void*, Args... args) { Fn(args...); }, nullptr);
+		}
+
+		template <auto Method, typename T>
+		static constexpr Callback from(T* object) {
+			return Callback([](void* ctx, Args... args) { (static_cast<T*>(ctx)->*Method)(args...); }, object);
+		}
+
+		constexpr explicit operator bool() const {
+			return function != nullptr;
+		}
+
+		inline void operator()(Args... args) const {
+			if (function)
+				function(context, args...);
+		}
+
+	private:
+		static void invoke_free(void* ctx, Args... args) {
+			reinterpret_cast<void (*)(Args...)>(ctx)(args...);
+		}
+	};
+
+} // namespace Hal
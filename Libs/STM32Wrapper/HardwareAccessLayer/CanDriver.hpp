@@ -2,24 +2,28 @@
 
 #include "ICanDriver.hpp"
 #include "stm32f4xx_hal.h"
-#include "CAN/CanEnumsStructs.hpp"
-#include "CAN/CanConfigPolicy.hpp"
-#include <map>
+#include "CanEnumsStructs.hpp"
+#include "CanConfigPolicy.hpp"
+#include "Callback.hpp"
+#include <array>
+#include "HandleRegistry.hpp"
 #include <cassert>
-#include <functional>
 #include <iostream> // Pour les messages de debug/erreur (peut être retiré en prod)
 
 using namespace WrapperBase;
 
 namespace Hal {
 
-    struct HalCanDriver : public ICanDriver {
+    struct HalCanDriver {
 
-        // Stocke un handle HAL par périphérique CAN (CAN_1, CAN_2)
-        inline static std::map<CanPort, CAN_HandleTypeDef> canHandles;
-        
-        // Stocke les callbacks de réception C++ pour chaque FIFO (0 et 1)
-        inline static std::map<CanPort, std::map<CanRxFifo, std::function<void(const CanMessage&)>>> rxCallbacks;
+        static constexpr size_t PortCount = 2;
+
+        // Un handle HAL statique par périphérique CAN (CAN_1, CAN_2), indexé par le port
+        using Handles = HandleRegistry<CanPort, CAN_HandleTypeDef, PortCount>;
+        static constexpr size_t FifoCount = 2;
+
+        // Callbacks de réception pour chaque port et chaque FIFO (0 et 1), indexés directement depuis l'ISR
+        inline static std::array<std::array<Callback<const CanMessage&>, FifoCount>, PortCount> rxCallbacks = { };
         
         // --- Fonctions de Mapping HAL (à implémenter en entier) ---
 
@@ -98,6 +102,10 @@ namespace Hal {
             return CAN_ID_STD;
         }
 
+        static CAN_HandleTypeDef* handle(CanPort port) {
+            return &Handles::at(port);
+        }
+
         static void enable_clock(CanPort port) {
             // Pour le STM32F407, CAN1 et CAN2 sont sur l'APB1
             switch (port) {
@@ -106,18 +114,18 @@ namespace Hal {
             }
         }
 
-        // --- Implémentation de ICanDriver ---
+        // --- Implémentation de CanDriverConcept ---
 
         /// @brief Initialise le périphérique CAN et le Bit Timing.
         template <CanConfigPolicy config>
         void init_peripheral() {
             enable_clock(config::Port);
 
-            if (canHandles.find(config::Port) != canHandles.end()) {
+            if (Handles::is_initialized(config::Port)) {
                 return; // Déjà initialisé
             }
             
-            CAN_HandleTypeDef* pHandle = &canHandles[config::Port];
+            CAN_HandleTypeDef* pHandle = &Handles::template at<config::Port>();
 
             pHandle->Instance = MapPort(config::Port);
             pHandle->Init.Mode = MapMode(config::Mode);
@@ -164,13 +172,13 @@ namespace Hal {
             sFilterConfig.FilterActivation = CAN_FILTER_ENABLE;
             sFilterConfig.SlaveStartFilterBank = 14; // Dépend du MCU (souvent 14 pour les F4)
 
-            if (HAL_CAN_ConfigFilter(&canHandles[config::Port], &sFilterConfig) != HAL_OK) {
+            if (HAL_CAN_ConfigFilter(&Handles::template at<config::Port>(), &sFilterConfig) != HAL_OK) {
                 assert(false && "CAN Filter Config Failed!");
             }
         }
 
         /// @brief Envoie un message sur le bus (non-blocant).
-        bool transmit(CanPort port, const CanMessage& message) override {
+        bool transmit(CanPort port, const CanMessage& message) {
             CAN_TxHeaderTypeDef txHeader;
             uint32_t txMailbox;
 
@@ -181,7 +189,7 @@ namespace Hal {
             txHeader.DLC = message.dataLength;
             txHeader.TransmitGlobalTime = DISABLE;
 
-            if (HAL_CAN_AddTxMessage(&canHandles[port], &txHeader, (uint8_t*)message.data, &txMailbox) != HAL_OK) {
+            if (HAL_CAN_AddTxMessage(&Handles::at(port), &txHeader, (uint8_t*)message.data, &txMailbox) != HAL_OK) {
                 // Ici, on pourrait logger ou gérer l'erreur de file d'attente pleine
                 return false;
             }
@@ -189,12 +197,12 @@ namespace Hal {
         }
         
         /// @brief Réception d'un message via la FIFO (pollé/blocant).
-        bool receive_polling(CanPort port, CanRxFifo fifo, CanMessage& message) override {
+        bool receive_polling(CanPort port, CanRxFifo fifo, CanMessage& message) {
             CAN_RxHeaderTypeDef rxHeader;
             uint8_t rxData[8];
             uint32_t halFifo = (fifo == CanRxFifo::FIFO_0) ? CAN_RX_FIFO0 : CAN_RX_FIFO1;
 
-            if (HAL_CAN_GetRxMessage(&canHandles[port], halFifo, &rxHeader, rxData) != HAL_OK) {
+            if (HAL_CAN_GetRxMessage(&Handles::at(port), halFifo, &rxHeader, rxData) != HAL_OK) {
                 return false;
             }
             
@@ -208,12 +216,12 @@ namespace Hal {
         }
         
         /// @brief Attache un callback à la réception d'un message par interruption.
-        void attach_rx_interrupt(CanPort port, CanRxFifo fifo, std::function<void(const CanMessage&)> cb) override {
-            rxCallbacks[port][fifo] = cb;
+        void attach_rx_interrupt(CanPort port, CanRxFifo fifo, Callback<const CanMessage&> cb) {
+            rxCallbacks[static_cast<size_t>(port)][static_cast<size_t>(fifo)] = cb;
             uint32_t halFifo = (fifo == CanRxFifo::FIFO_0) ? CAN_IT_RX_FIFO0_MSG_PEND : CAN_IT_RX_FIFO1_MSG_PEND;
             
             // Active l'interruption dans le périphérique
-            if (HAL_CAN_ActivateNotification(&canHandles[port], halFifo) != HAL_OK) {
+            if (HAL_CAN_ActivateNotification(&Handles::at(port), halFifo) != HAL_OK) {
                 assert(false && "CAN Interrupt Activation Failed!");
             }
         }
@@ -231,33 +239,13 @@ namespace Hal {
             CanMessage receivedMsg;
             if (HalCanDriver{}.receive_polling(port, fifo, receivedMsg)) {
                 
-                // 2. Appeler le callback C++ enregistré
-                if (rxCallbacks.count(port) && rxCallbacks[port].count(fifo) && rxCallbacks[port][fifo]) {
-                    rxCallbacks[port][fifo](receivedMsg);
-                } else {
-                    // Message reçu, mais pas de callback attaché (pourrait être utile pour du debug)
-                }
+                // 2. Appeler le callback C++ enregistré (sans effet si aucun n'est attaché)
+                rxCallbacks[static_cast<size_t>(port)][static_cast<size_t>(fifo)](receivedMsg);
             }
         }
     };
-} // namespace Hal
 
-// --- Routage des Callbacks C (hors du namespace Hal) ---
+    static_assert(CanDriverConcept<HalCanDriver>, "HalCanDriver ne respecte pas CanDriverConcept");
+} // namespace Hal
 
-// Les routines HAL doivent appeler une fonction dans votre driver
-// Déclarez ces fonctions dans l'espace global, puis implémentez-les dans un fichier CanIRQHandler.cpp
-extern "C" {
-    
-    // Callback appelé par la HAL quand un message est en attente dans la FIFO 0
-    void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hadc) {
-        Hal::HalCanDriver::handle_rx_callback(hadc, WrapperBase::CanRxFifo::FIFO_0);
-    }
-    
-    // Callback appelé par la HAL quand un message est en attente dans la FIFO 1
-    void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hadc) {
-        Hal::HalCanDriver::handle_rx_callback(hadc, WrapperBase::CanRxFifo::FIFO_1);
-    }
-    
-    // Ajoutez ici les ISR (Interrupt Service Routines) CAN1_RX0_IRQHandler, etc.
-    // comme vous l'avez fait pour le GPIO.
-}
\ No newline at end of file
+// Les callbacks C de la HAL (HAL_CAN_RxFifoxMsgPendingCallback) sont définis dans HalCallbacks.cpp
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "RccDriver.hpp"
+
+namespace Hal {
+
+	/*
+	 * @brief Unité CRC matérielle du STM32F4, pilotée par registres (le module HAL CRC n'est pas requis).
+	 * CRC-32/MPEG-2 : polynôme 0x04C11DB7, valeur initiale 0xFFFFFFFF, sans réflexion ni XOR final,
+	 * mots de 32 bits uniquement (1 mot par cycle AHB).
+	 *
+	 * Convention pour un bloc d'octets (compute) : mots lus en petit-boutiste, dernier mot incomplet
+	 * complété par des zéros, puis la longueur en octets ajoutée comme mot final (deux blocs ne différant
+	 * que par des zéros terminaux ont ainsi des CRC distincts). software() calcule la même valeur côté PC.
+	 * @note Unité unique et non réentrante : un seul contexte à la fois (pas d'usage concurrent ISR / thread).
+	 **/
+	struct HalCrcDriver {
+		static constexpr RccClockBit ClockBit { RccBus::AHB1, RCC_AHB1ENR_CRCEN };
+
+		static inline void init() {
+			HalRccDriver::enable(ClockBit);
+		}
+
+		static inline void reset() {
+			CRC->CR = CRC_CR_RESET;
+		}
+
+		static inline void accumulate(uint32_t word) {
+			CRC->DR = word;
+		}
+
+		static inline uint32_t value() {
+			return CRC->DR;
+		}
+
+		static uint32_t compute(const uint8_t* data, size_t size) {
+			reset();
+			size_t i = 0;
+			for (; i + 4 <= size; i += 4) {
+				uint32_t word;
+				std::memcpy(&word, data + i, 4); // Accès non aligné toléré par le Cortex-M4, memcpy reste portable
+				accumulate(word);
+			}
+			if (i < size)
+				accumulate(tail_word(data + i, size - i));
+			accumulate(static_cast<uint32_t>(size));
+			return value();
+		}
+
+		// Référence logicielle de compute(), bit à bit (outils PC, vérification)
+		static constexpr uint32_t software(const uint8_t* data, size_t size) {
+			uint32_t crc = 0xFFFFFFFFu;
+			size_t i = 0;
+			for (; i + 4 <= size; i += 4)
+				crc = software_word(crc, static_cast<uint32_t>(data[i]) | (static_cast<uint32_t>(data[i + 1]) << 8)
+					| (static_cast<uint32_t>(data[i + 2]) << 16) | (static_cast<uint32_t>(data[i + 3]) << 24));
+			if (i < size)
+				crc = software_word(crc, tail_word(data + i, size - i));
+			return software_word(crc, static_cast<uint32_t>(size));
+		}
+
+	private:
+		static constexpr uint32_t tail_word(const uint8_t* data, size_t count) {
+			uint32_t word = 0;
+			for (size_t k = 0; k < count; ++k)
+				word |= static_cast<uint32_t>(data[k]) << (8 * k);
+			return word;
+		}
+
+		static constexpr uint32_t software_word(uint32_t crc, uint32_t word) {
+			crc ^= word;
+			for (int bit = 0; bit < 32; ++bit)
+				crc = (crc & 0x80000000u) ? (crc << 1) ^ 0x04C11DB7u : (crc << 1);
+			return crc;
+		}
+	};
+
+} // namespace Hal
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstdint>
+
+namespace Hal {
+
+	/*
+	 * @brief Section critique de portée : masque les interruptions (PRIMASK) et rétablit l'état
+	 * précédent à la sortie, ce qui rend l'imbrication sûre. À réserver à quelques dizaines de cycles.
+	 *
+	 *   { Hal::CriticalSection lock; ... }
+	 **/
+	class CriticalSection {
+	public:
+		CriticalSection() : m_primask(__get_PRIMASK()) { __disable_irq(); }
+		~CriticalSection() { __set_PRIMASK(m_primask); }
+		CriticalSection(const CriticalSection&) = delete;
+		CriticalSection& operator=(const CriticalSection&) = delete;
+
+	private:
+		uint32_t m_primask;
+	};
+
+} // namespace Hal
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstdint>
+
+namespace Hal {
+
+	/*
+	 * @brief Compteur de cycles CPU basé sur l'unité DWT du Cortex-M4.
+	 * CYCCNT compte à la fréquence HCLK et reboucle sur 32 bits (~25 s à 168 MHz) :
+	 * les différences calculées en uint32_t restent justes à travers le débordement.
+	 **/
+	struct CycleCounter {
+		
+		static inline void enable() {
+			CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+			DWT->CYCCNT = 0;
+			DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+		}
+		
+		static inline bool is_enabled() {
+			return DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk;
+		}
+		
+		static inline uint32_t now() {
+			return DWT->CYCCNT;
+		}
+		
+		static inline uint32_t elapsed(uint32_t start) {
+			return DWT->CYCCNT - start;
+		}
+	};
+
+} // namespace Hal
@@ -2,16 +2,17 @@
 
 #include "IDacDriver.hpp"
 #include "stm32f4xx_hal_dac.h"
-#include <map>
+#include "HandleRegistry.hpp"
 #include <cassert>
 
 namespace Hal {
 
-	struct HalDacDriver : public IDacDriver {
+	struct HalDacDriver {
 
-		// Stocke un handle HAL pour le périphérique DAC
+		// Handle HAL statique du périphérique DAC
 		// (un seul handle gère les deux canaux)
-		inline static std::map<DacPort, DAC_HandleTypeDef> dacHandles;
+		static constexpr size_t PortCount = 1;
+		using Handles = HandleRegistry<DacPort, DAC_HandleTypeDef, PortCount>;
         
 		/// <summary>
 		/// @brief Initialise le périphérique DAC (une seule fois).
@@ -20,11 +21,11 @@ namespace Hal {
 			void init_peripheral() {
 				enable_clock(config::Port);
 
-				if (dacHandles.find(config::Port) != dacHandles.end()) {
+				if (Handles::is_initialized(config::Port)) {
 					return; // Déjà initialisé
 				}
             
-				DAC_HandleTypeDef* pHandle = &dacHandles[config::Port];
+				DAC_HandleTypeDef* pHandle = &Handles::template at<config::Port>();
 				pHandle->Instance = MapPort(config::Port);
             
 				HAL_DAC_Init(pHandle);
@@ -42,7 +43,7 @@ namespace Hal {
 				sConfig.DAC_OutputBuffer = MapOutputBuffer(config::OutputBuffer);
             
 				HAL_DAC_ConfigChannel(
-				    &dacHandles[config::Port], 
+				    &Handles::template at<config::Port>(), 
 					&sConfig, 
 					MapChannel(config::Channel));
             
@@ -53,9 +54,9 @@ namespace Hal {
 		/// <summary>
 		/// @brief Écrit une valeur sur le canal DAC.
 		/// </summary>
-		void write(DacPort port, DacChannel channel, DacDataAlign align, uint32_t value) override {
+		void write(DacPort port, DacChannel channel, DacDataAlign align, uint32_t value) {
 			HAL_DAC_SetValue(
-			    &dacHandles[port], 
+			    &Handles::at(port), 
 				MapChannel(channel), 
 				MapAlign(align), 
 				value);
@@ -64,15 +65,15 @@ namespace Hal {
 		/// <summary>
 		/// @brief Démarre le canal.
 		/// </summary>
-		void start(DacPort port, DacChannel channel) override {
-			HAL_DAC_Start(&dacHandles[port], MapChannel(channel));
+		void start(DacPort port, DacChannel channel) {
+			HAL_DAC_Start(&Handles::at(port), MapChannel(channel));
 		}
 
 		/// <summary>
 		/// @brief Arrête le canal.
 		/// </summary>
-		void stop(DacPort port, DacChannel channel) override {
-			HAL_DAC_Stop(&dacHandles[port], MapChannel(channel));
+		void stop(DacPort port, DacChannel channel) {
+			HAL_DAC_Stop(&Handles::at(port), MapChannel(channel));
 		}
 
 
@@ -114,4 +115,6 @@ namespace Hal {
 		}
 	};
 
+	static_assert(DacDriverConcept<HalDacDriver>, "HalDacDriver ne respecte pas DacDriverConcept");
+
 } // namespace Hal
\ No newline at end of file
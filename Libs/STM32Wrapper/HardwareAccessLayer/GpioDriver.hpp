@@ -5,18 +5,50 @@
 #include "stm32f4xx_hal_gpio.h"
 #include "GpioEnumsStructs.hpp"
 #include "GpioConfigPolicy.hpp"
+#include "RccDriver.hpp"
+#include "BitBand.hpp"
+#include "Callback.hpp"
+#include <array>
 #include <cassert>
-#include <map>
-#include <functional>
+#include <cstddef>
 
 using namespace WrapperBase;
 
 namespace Hal {
-	struct HalGpioDriver : public IGpioDriver {
+
+	/*
+	 * @brief Configuration pré-calculée des registres d'un port GPIO.
+	 * Pour chaque registre : masque des bits concernés et valeur à y écrire.
+	 * Permet de configurer toutes les broches d'un port avec un seul read-modify-write par registre.
+	 **/
+	struct GpioPortSetup {
+		uint32_t moderMask = 0, moder = 0;
+		uint32_t otyperMask = 0, otyper = 0;
+		uint32_t ospeedrMask = 0, ospeedr = 0;
+		uint32_t pupdrMask = 0, pupdr = 0;
+		uint32_t afrMask[2] = { 0, 0 }, afr[2] = { 0, 0 };
+
+		constexpr bool empty() const { return moderMask == 0 && pupdrMask == 0; }
+	};
+
+	/*
+	 * @brief Configuration pré-calculée des lignes EXTI (sélection de port, fronts, masque d'interruption).
+	 **/
+	struct GpioExtiSetup {
+		uint32_t exticrMask[4] = { 0, 0, 0, 0 }, exticr[4] = { 0, 0, 0, 0 };
+		uint32_t lines = 0;
+		uint32_t rising = 0;
+		uint32_t falling = 0;
+
+		constexpr bool empty() const { return lines == 0; }
+	};
+
+	struct HalGpioDriver {
 
 		static constexpr size_t MaxPins = 16; // EXTI0 à EXTI15
 
-		inline static std::map<int, std::function<void()>> callbacks = { };
+		// Table de dispatch indexée par ligne EXTI : accès O(1), sans allocation, utilisable en ISR.
+		inline static std::array<Callback<>, MaxPins> callbacks = { };
 		
 		template <GpioConfigPolicy T>
 		void init() {
@@ -44,18 +76,41 @@ namespace Hal {
 			return gpiohalConfig;
 		}
 		
-		void attach_interrupt(uint8_t pin, std::function<void()> cb) override {
+		void attach_interrupt(uint8_t pin, Callback<> cb) {
 			if (pin < MaxPins) {
-				callbacks[pin] = std::move(cb);
+				callbacks[pin] = cb;
 			}
 		}
 		
-		static void handle(uint8_t pin) {
-			if (pin < MaxPins && callbacks[pin]) {
+		static inline void handle(uint8_t pin) {
+			if (pin < MaxPins) {
 				callbacks[pin]();
 			}
 		}
 		
+		/*
+		 * @Brief Lit EXTI->PR une seule fois et acquitte toutes les lignes en attente du masque d'une seule écriture.
+		 * Une ligne qui redevient active pendant le traitement reste en attente et relance l'ISR.
+		 **/
+		static inline uint32_t acknowledge_pending(uint32_t lineMask) {
+			const uint32_t pending = EXTI->PR & lineMask;
+			if (pending)
+				EXTI->PR = pending; // Écriture de 1 pour acquitter, les autres lignes ne sont pas touchées
+			return pending;
+		}
+		
+		/*
+		 * @Brief Appelle le callback de chaque ligne du masque, de la plus haute à la plus basse (CLZ).
+		 * Plusieurs fronts simultanés sur un vecteur partagé sont servis en une seule entrée d'ISR.
+		 **/
+		static inline void dispatch_lines(uint32_t lines) {
+			while (lines) {
+				const uint32_t line = 31u - __CLZ(lines);
+				lines &= ~(1u << line);
+				callbacks[line]();
+			}
+		}
+		
 		static constexpr GPIO_TypeDef* MapPort(GpioPort port)
 		{
 			switch (port) {
@@ -72,18 +127,115 @@ namespace Hal {
 			return nullptr;
 		}
 		
-		void write(GpioPort port, uint16_t pinMask, GpioPinState state) override {
+		void write(GpioPort port, uint16_t pinMask, GpioPinState state) {
 			HAL_GPIO_WritePin(MapPort(port), pinMask, static_cast<GPIO_PinState>(state)) ;
 		}
 
-		GpioPinState read(GpioPort port, uint16_t pinMask) override {
+		GpioPinState read(GpioPort port, uint16_t pinMask) {
 			return (HAL_GPIO_ReadPin(MapPort(port), pinMask) == GPIO_PIN_SET) ? GpioPinState::Set : GpioPinState::Reset;
 		}
 
-		void toggle(GpioPort port, uint16_t pinMask) override {
+		void toggle(GpioPort port, uint16_t pinMask) {
 			HAL_GPIO_TogglePin(MapPort(port), pinMask);
 		}
 		
+		/*
+		 * @Brief Accès direct aux registres GPIO, résolu à la compilation.
+		 * Le port et le masque étant connus à la compilation, l'adresse du port est une constante :
+		 * une écriture devient un seul store dans BSRR, une lecture un load masqué de IDR.
+		 **/
+		static constexpr bool HasDirectAccess = true;
+		
+		static constexpr uint32_t MapPortBase(GpioPort port)
+		{
+			switch (port) {
+			case GpioPort::GPIO_A: return GPIOA_BASE;
+			case GpioPort::GPIO_B: return GPIOB_BASE;
+			case GpioPort::GPIO_C: return GPIOC_BASE;
+			case GpioPort::GPIO_D: return GPIOD_BASE;
+			case GpioPort::GPIO_E: return GPIOE_BASE;
+			case GpioPort::GPIO_F: return GPIOF_BASE;
+			case GpioPort::GPIO_G: return GPIOG_BASE;
+			case GpioPort::GPIO_H: return GPIOH_BASE;
+			case GpioPort::GPIO_I: return GPIOI_BASE;
+			}
+			return 0;
+		}
+		
+		template <GpioPort port>
+		static inline GPIO_TypeDef* Regs() {
+			static_assert(MapPortBase(port) != 0, "Port GPIO inconnu");
+			return reinterpret_cast<GPIO_TypeDef*>(MapPortBase(port));
+		}
+		
+		template <GpioPort port, uint16_t pinMask>
+		static inline void set_direct() {
+			Regs<port>()->BSRR = pinMask;
+		}
+		
+		template <GpioPort port, uint16_t pinMask>
+		static inline void reset_direct() {
+			Regs<port>()->BSRR = static_cast<uint32_t>(pinMask) << 16;
+		}
+		
+		/*
+		 * @Brief Toggle par un seul load de ODR et un seul store dans BSRR.
+		 * Contrairement à ODR ^= mask, le store BSRR ne touche que les broches du masque :
+		 * une ISR qui écrit une autre broche du même port entre les deux accès n'est pas écrasée.
+		 **/
+		template <GpioPort port, uint16_t pinMask>
+		static inline void toggle_direct() {
+			const uint32_t odr = Regs<port>()->ODR;
+			Regs<port>()->BSRR = ((odr & pinMask) << 16) | (~odr & pinMask);
+		}
+		
+		template <GpioPort port, uint16_t pinMask>
+		static inline GpioPinState read_direct() {
+			return (Regs<port>()->IDR & pinMask) ? GpioPinState::Set : GpioPinState::Reset;
+		}
+		
+		/*
+		 * @Brief Applique une configuration de port complète.
+		 * Les registres de vitesse, type de sortie, pull et fonction alternative sont écrits avant MODER,
+		 * pour que la broche ne bascule dans son mode final qu'une fois entièrement configurée
+		 * (même ordre que HAL_GPIO_Init). L'horloge du port doit déjà être active.
+		 **/
+		template <GpioPort port>
+		static inline void configure_direct(const GpioPortSetup& setup) {
+			GPIO_TypeDef* regs = Regs<port>();
+			if (setup.ospeedrMask)
+				regs->OSPEEDR = (regs->OSPEEDR & ~setup.ospeedrMask) | setup.ospeedr;
+			if (setup.otyperMask)
+				regs->OTYPER = (regs->OTYPER & ~setup.otyperMask) | setup.otyper;
+			if (setup.pupdrMask)
+				regs->PUPDR = (regs->PUPDR & ~setup.pupdrMask) | setup.pupdr;
+			if (setup.afrMask[0])
+				regs->AFR[0] = (regs->AFR[0] & ~setup.afrMask[0]) | setup.afr[0];
+			if (setup.afrMask[1])
+				regs->AFR[1] = (regs->AFR[1] & ~setup.afrMask[1]) | setup.afr[1];
+			if (setup.moderMask)
+				regs->MODER = (regs->MODER & ~setup.moderMask) | setup.moder;
+		}
+		
+		/*
+		 * @Brief Configure les lignes EXTI en une passe (horloge SYSCFG déjà active).
+		 * Les événements (EMR) sont désactivés sur ces lignes, comme le fait HAL_GPIO_Init en mode IT.
+		 **/
+		static inline void configure_exti(const GpioExtiSetup& setup) {
+			for (size_t i = 0; i < 4; ++i) {
+				if (setup.exticrMask[i])
+					SYSCFG->EXTICR[i] = (SYSCFG->EXTICR[i] & ~setup.exticrMask[i]) | setup.exticr[i];
+			}
+			EXTI->RTSR = (EXTI->RTSR & ~setup.lines) | setup.rising;
+			EXTI->FTSR = (EXTI->FTSR & ~setup.lines) | setup.falling;
+			EXTI->EMR = EXTI->EMR & ~setup.lines;
+			EXTI->IMR = EXTI->IMR | setup.lines;
+		}
+		
+		static constexpr RccClockBit SyscfgClockBit() {
+			return { RccBus::APB2, RCC_APB2ENR_SYSCFGEN };
+		}
+		
 		static constexpr uint32_t MapPinMode(GpioPinMode mode) {
 			switch (mode) {
 			case GpioPinMode::Input:             return GPIO_MODE_INPUT;
@@ -170,52 +322,101 @@ namespace Hal {
 		}
 		
 		static inline void enable_clock(GpioPort port) {
-			if (is_enabled(port))
-				return;
-			switch (port) {
-			case GpioPort::GPIO_A : __HAL_RCC_GPIOA_CLK_ENABLE(); break;
-			case GpioPort::GPIO_B : __HAL_RCC_GPIOB_CLK_ENABLE(); break;
-			case GpioPort::GPIO_C : __HAL_RCC_GPIOC_CLK_ENABLE(); break;
-			case GpioPort::GPIO_D : __HAL_RCC_GPIOD_CLK_ENABLE(); break;
-			case GpioPort::GPIO_E : __HAL_RCC_GPIOE_CLK_ENABLE(); break;
-			case GpioPort::GPIO_F : __HAL_RCC_GPIOF_CLK_ENABLE(); break;
-			case GpioPort::GPIO_G : __HAL_RCC_GPIOG_CLK_ENABLE(); break;
-			case GpioPort::GPIO_H : __HAL_RCC_GPIOH_CLK_ENABLE(); break;
-			case GpioPort::GPIO_I : __HAL_RCC_GPIOI_CLK_ENABLE(); break;
-			default : assert("Valeur en dehors de la plage");
-			}
+			HalRccDriver::enable(ClockBit(port));
 		}
 		
 		static inline bool is_enabled(GpioPort port) {
+			return HalRccDriver::is_enabled(ClockBit(port));
+		}
+		
+		
+		static constexpr RccClockBit ClockBit(GpioPort port) {
 			switch (port) {
-			case GpioPort::GPIO_A : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOAEN;
-			case GpioPort::GPIO_B : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOBEN;
-			case GpioPort::GPIO_C : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOCEN;
-			case GpioPort::GPIO_D : return RCC->AHB1ENR & RCC_AHB1ENR_GPIODEN;
-			case GpioPort::GPIO_E : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOEEN;
-			case GpioPort::GPIO_F : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOFEN;
-			case GpioPort::GPIO_G : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOGEN;
-			case GpioPort::GPIO_H : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOHEN;
-			case GpioPort::GPIO_I : return RCC->AHB1ENR & RCC_AHB1ENR_GPIOIEN;
+			case GpioPort::GPIO_A : return { RccBus::AHB1, RCC_AHB1ENR_GPIOAEN };
+			case GpioPort::GPIO_B : return { RccBus::AHB1, RCC_AHB1ENR_GPIOBEN };
+			case GpioPort::GPIO_C : return { RccBus::AHB1, RCC_AHB1ENR_GPIOCEN };
+			case GpioPort::GPIO_D : return { RccBus::AHB1, RCC_AHB1ENR_GPIODEN };
+			case GpioPort::GPIO_E : return { RccBus::AHB1, RCC_AHB1ENR_GPIOEEN };
+			case GpioPort::GPIO_F : return { RccBus::AHB1, RCC_AHB1ENR_GPIOFEN };
+			case GpioPort::GPIO_G : return { RccBus::AHB1, RCC_AHB1ENR_GPIOGEN };
+			case GpioPort::GPIO_H : return { RccBus::AHB1, RCC_AHB1ENR_GPIOHEN };
+			case GpioPort::GPIO_I : return { RccBus::AHB1, RCC_AHB1ENR_GPIOIEN };
 			}
-			assert("Valeur en dehors de la plage");
+			return { RccBus::AHB1, 0 };
 		}
 		
+		static constexpr IRQn_Type ExtiIrq(uint8_t pin) {
+			if (pin == 0) return EXTI0_IRQn;
+			if (pin == 1) return EXTI1_IRQn;
+			if (pin == 2) return EXTI2_IRQn;
+			if (pin == 3) return EXTI3_IRQn;
+			if (pin == 4) return EXTI4_IRQn;
+			if (pin <= 9) return EXTI9_5_IRQn;
+			return EXTI15_10_IRQn;
+		}
 		
 		static void EnableIrq(uint16_t pin, uint32_t PreemptPriority, uint32_t SubPriority) {
-			IRQn_Type irq;
-			// La logique pour déterminer l'IRQ est correcte
-			if (pin == 0) irq = EXTI0_IRQn;
-			else if (pin == 1) irq = EXTI1_IRQn;
-			else if (pin == 2) irq = EXTI2_IRQn;
-			else if (pin == 3) irq = EXTI3_IRQn;
-			else if (pin == 4) irq = EXTI4_IRQn;
-			else if (pin >= 5 && pin <= 9) irq = EXTI9_5_IRQn;
-			else irq = EXTI15_10_IRQn;
+			const IRQn_Type irq = ExtiIrq(pin);
 			
 			HAL_NVIC_SetPriority(irq, PreemptPriority, SubPriority);
 			HAL_NVIC_EnableIRQ(irq);
 		
 		}
 	};
-}
\ No newline at end of file
+
+	static_assert(GpioDriverConcept<HalGpioDriver>, "HalGpioDriver ne respecte pas GpioDriverConcept");
+
+	/*
+	 * @Brief Politique d'accès GPIO par défaut : store BSRR pour écrire, load masqué de IDR pour lire.
+	 **/
+	struct GpioBsrrAccess {
+		template <GpioPort port, uint16_t pinMask>
+		static inline void set() { HalGpioDriver::set_direct<port, pinMask>(); }
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline void reset() { HalGpioDriver::reset_direct<port, pinMask>(); }
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline void toggle() { HalGpioDriver::toggle_direct<port, pinMask>(); }
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline GpioPinState read() { return HalGpioDriver::read_direct<port, pinMask>(); }
+	};
+
+	/*
+	 * @Brief Politique d'accès GPIO par bit-band : un mot alias par broche dans ODR et IDR.
+	 * Écriture = un store de 0/1 dans l'alias de ODR, lecture = un load de l'alias de IDR (0/1, sans masque
+	 * ni décalage). Le toggle reste un load + store sur l'alias : il ne touche que la broche visée,
+	 * mais n'est pas atomique face à un autre écrivain de la même broche.
+	 **/
+	struct GpioBitBandAccess {
+		template <GpioPort port, uint16_t pinMask>
+		static inline volatile uint32_t& odr_bit() {
+			static_assert(pinMask != 0 && (pinMask & (pinMask - 1)) == 0, "GpioBitBandAccess : une seule broche par accès");
+			return BitBand::periph<HalGpioDriver::MapPortBase(port) + offsetof(GPIO_TypeDef, ODR), BitBand::BitIndex(pinMask)>();
+		}
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline volatile uint32_t& idr_bit() {
+			static_assert(pinMask != 0 && (pinMask & (pinMask - 1)) == 0, "GpioBitBandAccess : une seule broche par accès");
+			return BitBand::periph<HalGpioDriver::MapPortBase(port) + offsetof(GPIO_TypeDef, IDR), BitBand::BitIndex(pinMask)>();
+		}
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline void set() { odr_bit<port, pinMask>() = 1u; }
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline void reset() { odr_bit<port, pinMask>() = 0u; }
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline void toggle() {
+			volatile uint32_t& bit = odr_bit<port, pinMask>();
+			bit = bit ^ 1u;
+		}
+
+		template <GpioPort port, uint16_t pinMask>
+		static inline GpioPinState read() {
+			return static_cast<GpioPinState>(idr_bit<port, pinMask>());
+		}
+	};
+}
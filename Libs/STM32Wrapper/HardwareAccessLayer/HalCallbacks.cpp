@@ -0,0 +1,99 @@
+// HalCallbacks.cpp
+// Routage des callbacks globaux de la HAL (symboles faibles) vers les tables de dispatch des drivers.
+// Chaque callback fait une recherche O(1) (instance -> index de port) puis un seul appel indirect.
+
+#include "stm32f4xx_hal.h"
+#include "GpioDriver.hpp"
+
+#ifdef HAL_UART_MODULE_ENABLED
+#include "UartDriver.hpp"
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+#include "SpiDriver.hpp"
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+#include "I2cDriver.hpp"
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+#include "CanDriver.hpp"
+#endif
+
+extern "C" {
+
+	// Utilisé uniquement si une ISR passe par HAL_GPIO_EXTI_IRQHandler (voir GpioIrq pour le chemin direct)
+	void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+		Hal::HalGpioDriver::handle(static_cast<uint8_t>(__builtin_ctz(GPIO_Pin)));
+	}
+
+#ifdef HAL_UART_MODULE_ENABLED
+	void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+		Hal::HalUartDriver::handle_tx_complete(huart);
+	}
+
+	void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+		Hal::HalUartDriver::handle_rx_complete(huart);
+	}
+
+	// Réception vers ligne inactive : Size = position d'écriture DMA dans le tampon
+	void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
+		Hal::HalUartDriver::handle_rx_event(huart, Size);
+	}
+
+	void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+		Hal::HalUartDriver::handle_error(huart);
+	}
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+	void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+		Hal::HalSpiDriver::handle_tx_complete(hspi);
+	}
+
+	void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
+		Hal::HalSpiDriver::handle_rx_complete(hspi);
+	}
+
+	void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
+		Hal::HalSpiDriver::handle_txrx_complete(hspi);
+	}
+
+	void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) {
+		Hal::HalSpiDriver::handle_error(hspi);
+	}
+#endif
+
+#ifdef HAL_I2C_MODULE_ENABLED
+	void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+		Hal::HalI2cDriver::handle_tx_complete(hi2c);
+	}
+
+	void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+		Hal::HalI2cDriver::handle_rx_complete(hi2c);
+	}
+
+	void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+		Hal::HalI2cDriver::handle_tx_complete(hi2c);
+	}
+
+	void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+		Hal::HalI2cDriver::handle_rx_complete(hi2c);
+	}
+
+	void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+		Hal::HalI2cDriver::handle_error(hi2c);
+	}
+#endif
+
+#ifdef HAL_CAN_MODULE_ENABLED
+	// Callback appelé par la HAL quand un message est en attente dans la FIFO 0
+	void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+		Hal::HalCanDriver::handle_rx_callback(hcan, WrapperBase::CanRxFifo::FIFO_0);
+	}
+
+	// Callback appelé par la HAL quand un message est en attente dans la FIFO 1
+	void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+		Hal::HalCanDriver::handle_rx_callback(hcan, WrapperBase::CanRxFifo::FIFO_1);
+	}
+#endif
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hal {
+
+	/*
+	 * @brief Registre des handles HAL d'un type de périphérique : un handle alloué statiquement par
+	 * instance, indexé par l'énumération du port.
+	 * L'adresse d'un handle ne bouge jamais (la HAL peut la garder pendant un transfert IT/DMA), et
+	 * at<port>() ou at(port) avec un port constant se réduit à une adresse constante : ni recherche ni tas.
+	 * Un handle est considéré initialisé quand son champ Instance est renseigné.
+	 *
+	 * @tparam Port   Énumération des instances (valeurs 0..Count-1)
+	 * @tparam Handle Type de handle HAL (UART_HandleTypeDef, TIM_HandleTypeDef...)
+	 * @tparam Count  Nombre d'instances
+	 **/
+	template <typename Port, typename Handle, size_t Count>
+	struct HandleRegistry {
+		static constexpr size_t Size = Count;
+
+		static constexpr size_t Index(Port port) {
+			return static_cast<size_t>(port);
+		}
+
+		template <Port port>
+		static inline Handle& at() {
+			static_assert(Index(port) < Count, "HandleRegistry : port hors registre");
+			return handles[Index(port)];
+		}
+
+		static inline Handle& at(Port port) {
+			return handles[Index(port)];
+		}
+
+		// Accès par index de handle (valeur renvoyée par init(), égale à l'index du port)
+		static inline Handle& at(size_t index) {
+			return handles[index];
+		}
+
+		// Index du port d'un handle du registre (callbacks HAL), -1 si le handle n'en fait pas partie
+		static inline int8_t index_of(const Handle* handle) {
+			const size_t index = (reinterpret_cast<uintptr_t>(handle) - reinterpret_cast<uintptr_t>(handles.data())) / sizeof(Handle);
+			return (index < Count) ? static_cast<int8_t>(index) : -1;
+		}
+
+		static inline bool is_initialized(Port port) {
+			return handles[Index(port)].Instance != nullptr;
+		}
+
+		inline static std::array<Handle, Count> handles {};
+	};
+
+} // namespace Hal
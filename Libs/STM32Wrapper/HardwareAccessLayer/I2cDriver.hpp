@@ -1,128 +1,272 @@
 #pragma once
 
-#include <vector>
+#include <array>
 #include <cstdint>
-#include <map>
-#include <functional>
 #include "II2cDriver.hpp"
 #include "stm32f4xx_hal.h"
 #include "I2cConfigPolicy.hpp"
+#include "RccDriver.hpp"
+#include "HandleRegistry.hpp"
+#include "Callback.hpp"
 
 using namespace WrapperBase;
 
 namespace Hal {
 
-	struct HalI2cDriver : public Hal::II2cDriver {
+	struct HalI2cDriver {
 
 		inline static constexpr int8_t handleEmpty = -1;
-		inline static std::vector<I2C_HandleTypeDef> i2cHandles = { };
+		inline static constexpr size_t PortCount = 3;
+		// Un handle statique par port : adresse fixe, index du handle == index du port
+		using Handles = HandleRegistry<I2cPort, I2C_HandleTypeDef, PortCount>;
         
-		// Maps pour les callbacks, indexés par l'instance I2C (I2C1, I2C2...)
-		inline static std::map<I2C_TypeDef*, std::function<void()>> tx_complete_callbacks = { };
-		inline static std::map<I2C_TypeDef*, std::function<void()>> rx_complete_callbacks = { };
-		inline static std::map<I2C_TypeDef*, std::function<void()>> error_callbacks = { };
+		// Tables de dispatch indexées par port (I2C1, I2C2...) : accès O(1), sans allocation, utilisables en ISR
+		inline static std::array<Callback<>, PortCount> tx_complete_callbacks = { };
+		inline static std::array<Callback<>, PortCount> rx_complete_callbacks = { };
+		inline static std::array<Callback<>, PortCount> error_callbacks = { };
 		// Note : I2C a aussi des callbacks pour MemTx/MemRx, vous pouvez les ajouter si besoin
+		inline static std::array<DMA_HandleTypeDef, PortCount> txDmaHandles = { };
+		inline static std::array<DMA_HandleTypeDef, PortCount> rxDmaHandles = { };
 
 		template<I2cConfigPolicy T>
 			int8_t init() {
 				enable_clock(T::Port);
+				return init_peripheral<T>();
+			}
 
-				I2C_HandleTypeDef m_handle = { };
+		// Initialise l'I2C sans toucher à l'horloge (déjà activée, ex: par BoardInit)
+		template<I2cConfigPolicy T>
+			int8_t init_peripheral() {
+				I2C_HandleTypeDef& m_handle = Handles::template at<T::Port>();
+				m_handle = { };
 				m_handle.Instance = MapPort(T::Port);
 				m_handle.Init = getHALConfig<T>();
 
 				HAL_StatusTypeDef status = HAL_I2C_Init(&m_handle);
 
 				if (status == HAL_OK) {
-					i2cHandles.push_back(m_handle);
-					return i2cHandles.size() - 1;
+					return handle_index(T::Port);
 				}
+				m_handle.Instance = nullptr;
 				return handleEmpty;
 			}
 
-		// --- Implémentation des fonctions de l'interface ---
+		static constexpr int8_t handle_index(I2cPort port) {
+			return static_cast<int8_t>(PortIndex(port));
+		}
+
+		// --- Implémentation des fonctions du contrat I2cDriverConcept ---
+		// La HAL I2C prend un uint8_t* non const même en émission : le buffer n'est pas modifié.
 
-		HAL_StatusTypeDef master_transmit(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_I2C_Master_Transmit(&i2cHandles[handleIndex], devAddress, data, size, timeout);
+		HAL_StatusTypeDef master_transmit(int8_t handleIndex, uint16_t devAddress, const uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_I2C_Master_Transmit(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, const_cast<uint8_t*>(data), size, timeout);
 		}
-		HAL_StatusTypeDef master_receive(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_I2C_Master_Receive(&i2cHandles[handleIndex], devAddress, data, size, timeout);
+		HAL_StatusTypeDef master_receive(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_I2C_Master_Receive(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, data, size, timeout);
 		}
-		HAL_StatusTypeDef mem_write(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_I2C_Mem_Write(&i2cHandles[handleIndex], devAddress, memAddress, memAddSize, data, size, timeout);
+		HAL_StatusTypeDef mem_write(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, const uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_I2C_Mem_Write(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, memAddress, memAddSize, const_cast<uint8_t*>(data), size, timeout);
 		}
-		HAL_StatusTypeDef mem_read(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_I2C_Mem_Read(&i2cHandles[handleIndex], devAddress, memAddress, memAddSize, data, size, timeout);
+		HAL_StatusTypeDef mem_read(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_I2C_Mem_Read(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, memAddress, memAddSize, data, size, timeout);
 		}
 
-		HAL_StatusTypeDef master_transmit_it(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size) override {
-			return HAL_I2C_Master_Transmit_IT(&i2cHandles[handleIndex], devAddress, data, size);
+		HAL_StatusTypeDef master_transmit_it(int8_t handleIndex, uint16_t devAddress, const uint8_t* data, uint16_t size) {
+			return HAL_I2C_Master_Transmit_IT(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, const_cast<uint8_t*>(data), size);
 		}
-		HAL_StatusTypeDef master_receive_it(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size) override {
-			return HAL_I2C_Master_Receive_IT(&i2cHandles[handleIndex], devAddress, data, size);
+		HAL_StatusTypeDef master_receive_it(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size) {
+			return HAL_I2C_Master_Receive_IT(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, data, size);
 		}
-		HAL_StatusTypeDef mem_write_it(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size) override {
-			return HAL_I2C_Mem_Write_IT(&i2cHandles[handleIndex], devAddress, memAddress, memAddSize, data, size);
+		HAL_StatusTypeDef mem_write_it(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, const uint8_t* data, uint16_t size) {
+			return HAL_I2C_Mem_Write_IT(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, memAddress, memAddSize, const_cast<uint8_t*>(data), size);
 		}
-		HAL_StatusTypeDef mem_read_it(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size) override {
-			return HAL_I2C_Mem_Read_IT(&i2cHandles[handleIndex], devAddress, memAddress, memAddSize, data, size);
+		HAL_StatusTypeDef mem_read_it(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size) {
+			return HAL_I2C_Mem_Read_IT(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, memAddress, memAddSize, data, size);
+		}
+
+		// Adresse seule, sans données : ACK de l'esclave (présence, fin de cycle d'écriture EEPROM)
+		HAL_StatusTypeDef is_device_ready(int8_t handleIndex, uint16_t devAddress, uint32_t trials, uint32_t timeout) {
+			return HAL_I2C_IsDeviceReady(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, trials, timeout);
+		}
+
+		// --- Fonctions de communication par DMA (init_dma préalable) ---
+
+		HAL_StatusTypeDef master_transmit_dma(int8_t handleIndex, uint16_t devAddress, const uint8_t* data, uint16_t size) {
+			return HAL_I2C_Master_Transmit_DMA(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, const_cast<uint8_t*>(data), size);
+		}
+		HAL_StatusTypeDef master_receive_dma(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size) {
+			return HAL_I2C_Master_Receive_DMA(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, data, size);
+		}
+		HAL_StatusTypeDef mem_write_dma(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, const uint8_t* data, uint16_t size) {
+			return HAL_I2C_Mem_Write_DMA(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, memAddress, memAddSize, const_cast<uint8_t*>(data), size);
+		}
+		HAL_StatusTypeDef mem_read_dma(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size) {
+			return HAL_I2C_Mem_Read_DMA(&Handles::at(static_cast<size_t>(handleIndex)), devAddress, memAddress, memAddSize, data, size);
 		}
 
 		// --- Fonctions statiques de gestion (callbacks, IRQ, clock) ---
 
-		static void attach_callbacks(int8_t handle_index, std::function<void()> tx_cb, std::function<void()> rx_cb, std::function<void()> error_cb) {
-			I2C_TypeDef* instance = i2cHandles[handle_index].Instance;
-			if (tx_cb) tx_complete_callbacks[instance] = std::move(tx_cb);
-			if (rx_cb) rx_complete_callbacks[instance] = std::move(rx_cb);
-			if (error_cb) error_callbacks[instance] = std::move(error_cb);
+		static I2C_HandleTypeDef* handle(I2cPort port) {
+			return Handles::is_initialized(port) ? &Handles::at(port) : nullptr;
 		}
 
-		// Fonctions à appeler depuis les callbacks globaux HAL (ex: stm32f4xx_it.c)
-		static void handle_tx_complete(I2C_HandleTypeDef *hi2c) {
-			if (tx_complete_callbacks.count(hi2c->Instance)) {
-				tx_complete_callbacks[hi2c->Instance]();
-			}
+		static void attach_callbacks(int8_t handle_index, Callback<> tx_cb, Callback<> rx_cb, Callback<> error_cb) {
+			const int8_t port = handle_index;
+			if (port < 0 || static_cast<size_t>(port) >= PortCount) return;
+			if (tx_cb) tx_complete_callbacks[port] = tx_cb;
+			if (rx_cb) rx_complete_callbacks[port] = rx_cb;
+			if (error_cb) error_callbacks[port] = error_cb;
 		}
-		static void handle_rx_complete(I2C_HandleTypeDef *hi2c) {
-			if (rx_complete_callbacks.count(hi2c->Instance)) {
-				rx_complete_callbacks[hi2c->Instance]();
-			}
+
+		// Fonctions appelées depuis les callbacks globaux HAL (HalCallbacks.cpp)
+		static inline void handle_tx_complete(I2C_HandleTypeDef *hi2c) {
+			const int8_t port = Handles::index_of(hi2c);
+			if (port >= 0) tx_complete_callbacks[port]();
+		}
+		static inline void handle_rx_complete(I2C_HandleTypeDef *hi2c) {
+			const int8_t port = Handles::index_of(hi2c);
+			if (port >= 0) rx_complete_callbacks[port]();
+		}
+		static inline void handle_error(I2C_HandleTypeDef *hi2c) {
+			const int8_t port = Handles::index_of(hi2c);
+			if (port >= 0) error_callbacks[port]();
+		}
+
+		static constexpr size_t PortIndex(I2cPort port) {
+			return static_cast<size_t>(port);
 		}
-		static void handle_error(I2C_HandleTypeDef *hi2c) {
-			if (error_callbacks.count(hi2c->Instance)) {
-				error_callbacks[hi2c->Instance]();
+
+		static inline int8_t PortIndex(const I2C_TypeDef* instance) {
+			if (instance == I2C1) return 0;
+			if (instance == I2C2) return 1;
+			if (instance == I2C3) return 2;
+			return -1;
+		}
+
+		static constexpr IRQn_Type EventIrq(I2cPort port) {
+			switch (port) {
+			case I2cPort::I2C_1: return I2C1_EV_IRQn;
+			case I2cPort::I2C_2: return I2C2_EV_IRQn;
+			case I2cPort::I2C_3: return I2C3_EV_IRQn;
 			}
+			return I2C1_EV_IRQn;
 		}
 
-		static void activate_IRQ(I2cPort port) {
-			IRQn_Type ev_irq, er_irq;
+		static constexpr IRQn_Type ErrorIrq(I2cPort port) {
 			switch (port) {
-			case I2cPort::I2C_1: ev_irq = I2C1_EV_IRQn; er_irq = I2C1_ER_IRQn; break;
-			case I2cPort::I2C_2: ev_irq = I2C2_EV_IRQn; er_irq = I2C2_ER_IRQn; break;
-			case I2cPort::I2C_3: ev_irq = I2C3_EV_IRQn; er_irq = I2C3_ER_IRQn; break;
+			case I2cPort::I2C_1: return I2C1_ER_IRQn;
+			case I2cPort::I2C_2: return I2C2_ER_IRQn;
+			case I2cPort::I2C_3: return I2C3_ER_IRQn;
 			}
+			return I2C1_ER_IRQn;
+		}
+
+		static void activate_IRQ(I2cPort port) {
+			const IRQn_Type ev_irq = EventIrq(port);
+			const IRQn_Type er_irq = ErrorIrq(port);
 			HAL_NVIC_SetPriority(ev_irq, 0, 0);
 			HAL_NVIC_EnableIRQ(ev_irq);
 			HAL_NVIC_SetPriority(er_irq, 0, 0);
 			HAL_NVIC_EnableIRQ(er_irq);
 		}
 
-		static void enable_clock(I2cPort port) {
-			if (is_enabled(port)) return;
+		struct DmaStream {
+			uint32_t base;
+			uint32_t channel;
+			IRQn_Type irq;
+		};
+
+		/*
+		 * @brief Streams DMA1 par port (RM0090, table 42), choisis pour que les trois ports tournent ensemble :
+		 *   I2C1 RX Stream0 ch1, TX Stream6 ch1 (partagés avec UART5_RX / USART2_TX)
+		 *   I2C2 RX Stream3 ch7, TX Stream7 ch7 (partagés avec USART3_TX / UART5_TX)
+		 *   I2C3 RX Stream2 ch3, TX Stream4 ch3 (partagés avec UART4_RX / UART4_TX)
+		 **/
+		static constexpr DmaStream RxDmaStream(I2cPort port) {
+			switch (port) {
+			case I2cPort::I2C_1: return { DMA1_Stream0_BASE, DMA_CHANNEL_1, DMA1_Stream0_IRQn };
+			case I2cPort::I2C_2: return { DMA1_Stream3_BASE, DMA_CHANNEL_7, DMA1_Stream3_IRQn };
+			case I2cPort::I2C_3: return { DMA1_Stream2_BASE, DMA_CHANNEL_3, DMA1_Stream2_IRQn };
+			}
+			return { DMA1_Stream0_BASE, DMA_CHANNEL_1, DMA1_Stream0_IRQn };
+		}
+
+		static constexpr DmaStream TxDmaStream(I2cPort port) {
 			switch (port) {
-			case I2cPort::I2C_1: __HAL_RCC_I2C1_CLK_ENABLE(); break;
-			case I2cPort::I2C_2: __HAL_RCC_I2C2_CLK_ENABLE(); break;
-			case I2cPort::I2C_3: __HAL_RCC_I2C3_CLK_ENABLE(); break;
+			case I2cPort::I2C_1: return { DMA1_Stream6_BASE, DMA_CHANNEL_1, DMA1_Stream6_IRQn };
+			case I2cPort::I2C_2: return { DMA1_Stream7_BASE, DMA_CHANNEL_7, DMA1_Stream7_IRQn };
+			case I2cPort::I2C_3: return { DMA1_Stream4_BASE, DMA_CHANNEL_3, DMA1_Stream4_IRQn };
+			}
+			return { DMA1_Stream6_BASE, DMA_CHANNEL_1, DMA1_Stream6_IRQn };
+		}
+
+		static DMA_HandleTypeDef* tx_dma_handle(I2cPort port) {
+			return &txDmaHandles[PortIndex(port)];
+		}
+
+		static DMA_HandleTypeDef* rx_dma_handle(I2cPort port) {
+			return &rxDmaHandles[PortIndex(port)];
+		}
+
+		/*
+		 * @brief Relie deux streams DMA au handle du port (déjà initialisé) et active les vecteurs EV, ER
+		 * et DMA à la même priorité : la HAL mène la phase d'adresse par EV, les données par DMA.
+		 * @note Une nouvelle init du port défait ce lien.
+		 **/
+		static HAL_StatusTypeDef init_dma(I2cPort port, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			I2C_HandleTypeDef* hi2c = handle(port);
+			if (hi2c == nullptr)
+				return HAL_ERROR;
+			HalRccDriver::enable({ RccBus::AHB1, RCC_AHB1ENR_DMA1EN });
+
+			const DmaStream streams[2] = { TxDmaStream(port), RxDmaStream(port) };
+			DMA_HandleTypeDef* handles[2] = { tx_dma_handle(port), rx_dma_handle(port) };
+			for (size_t i = 0; i < 2; ++i) {
+				DMA_HandleTypeDef* hdma = handles[i];
+				*hdma = {};
+				hdma->Instance                 = reinterpret_cast<DMA_Stream_TypeDef*>(streams[i].base);
+				hdma->Init.Channel             = streams[i].channel;
+				hdma->Init.Direction           = (i == 0) ? DMA_MEMORY_TO_PERIPH : DMA_PERIPH_TO_MEMORY;
+				hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+				hdma->Init.MemInc              = DMA_MINC_ENABLE;
+				hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+				hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+				hdma->Init.Mode                = DMA_NORMAL;
+				hdma->Init.Priority            = DMA_PRIORITY_MEDIUM;
+				hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+				const HAL_StatusTypeDef status = HAL_DMA_Init(hdma);
+				if (status != HAL_OK)
+					return status;
+				hdma->Parent = hi2c;
+				HAL_NVIC_SetPriority(streams[i].irq, preemptPriority, subPriority);
+				HAL_NVIC_EnableIRQ(streams[i].irq);
+			}
+			hi2c->hdmatx = handles[0];
+			hi2c->hdmarx = handles[1];
+
+			const IRQn_Type irqs[2] = { EventIrq(port), ErrorIrq(port) };
+			for (IRQn_Type irq : irqs) {
+				HAL_NVIC_SetPriority(irq, preemptPriority, subPriority);
+				HAL_NVIC_EnableIRQ(irq);
 			}
+			return HAL_OK;
+		}
+
+		static void enable_clock(I2cPort port) {
+			HalRccDriver::enable(ClockBit(port));
 		}
 
 		static bool is_enabled(I2cPort port) {
+			return HalRccDriver::is_enabled(ClockBit(port));
+		}
+
+		static constexpr RccClockBit ClockBit(I2cPort port) {
 			switch (port) {
-			case I2cPort::I2C_1: return RCC->APB1ENR & RCC_APB1ENR_I2C1EN;
-			case I2cPort::I2C_2: return RCC->APB1ENR & RCC_APB1ENR_I2C2EN;
-			case I2cPort::I2C_3: return RCC->APB1ENR & RCC_APB1ENR_I2C3EN;
+			case I2cPort::I2C_1: return { RccBus::APB1, RCC_APB1ENR_I2C1EN };
+			case I2cPort::I2C_2: return { RccBus::APB1, RCC_APB1ENR_I2C2EN };
+			case I2cPort::I2C_3: return { RccBus::APB1, RCC_APB1ENR_I2C3EN };
 			}
-			return false;
+			return { RccBus::APB1, 0 };
 		}
 
 		// --- Fonctions de mappage statiques ---
@@ -160,4 +304,6 @@ namespace Hal {
 			}
 	};
 
+	static_assert(I2cDriverConcept<HalI2cDriver>, "HalI2cDriver ne respecte pas I2cDriverConcept");
+
 } // namespace Hal
\ No newline at end of file
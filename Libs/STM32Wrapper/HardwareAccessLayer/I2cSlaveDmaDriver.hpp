@@ -0,0 +1,119 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include "I2cEnumsStructs.hpp"
+#include "I2cDriver.hpp"
+#include "RccDriver.hpp"
+
+using namespace Wrapper;
+
+namespace Hal {
+
+	/*
+	 * @brief Port I2C esclave piloté par registres, données par DMA (mêmes streams que HalI2cDriver::init_dma).
+	 * Seuls les événements de début et de fin interrompent (ADDR, STOPF, AF, BTF) : ITBUFEN reste à 0,
+	 * aucun octet ne passe par l'ISR tant que le DMA a de la place. Les streams tournent sans interruption.
+	 * @note Le port doit avoir été initialisé par la HAL (FREQ, OAR1) ; ne plus appeler la HAL I2C ensuite.
+	 **/
+	template <I2cPort port>
+	struct HalI2cSlaveDma {
+
+		// Un stream DMA1 : registres de drapeaux, décalage 0, 6, 16, 22 selon l'index dans LISR/HISR
+		template <uint32_t Base, uint32_t Channel>
+		struct StreamRef {
+			static constexpr uint32_t Index = (Base - DMA1_Stream0_BASE) / 0x18u;
+			static constexpr bool HighRegister = (Index >= 4);
+			static constexpr uint32_t FlagShift = (Index % 4 == 0) ? 0u : (Index % 4 == 1) ? 6u : (Index % 4 == 2) ? 16u : 22u;
+			static constexpr uint32_t AllFlags = 0x3Du << FlagShift;
+
+			static inline DMA_Stream_TypeDef* Stream() {
+				return reinterpret_cast<DMA_Stream_TypeDef*>(Base);
+			}
+
+			static inline void clear_flags() {
+				if constexpr (HighRegister)
+					DMA1->HIFCR = AllFlags;
+				else
+					DMA1->LIFCR = AllFlags;
+			}
+
+			static inline void start(uint32_t memory, uint16_t size, uint32_t direction) {
+				DMA_Stream_TypeDef* stream = Stream();
+				clear_flags();
+				stream->M0AR = memory;
+				stream->NDTR = size;
+				stream->CR = Channel | DMA_SxCR_PL_0 | DMA_SxCR_MINC | direction; // Octets, priorité moyenne
+				stream->CR = stream->CR | DMA_SxCR_EN;
+			}
+
+			static inline bool active() {
+				return (Stream()->CR & DMA_SxCR_EN) != 0;
+			}
+
+			// Arrête le stream ; renvoie le nombre d'octets non transférés
+			static inline uint16_t stop() {
+				DMA_Stream_TypeDef* stream = Stream();
+				stream->CR = stream->CR & ~DMA_SxCR_EN;
+				while (stream->CR & DMA_SxCR_EN) {}
+				clear_flags();
+				return static_cast<uint16_t>(stream->NDTR);
+			}
+		};
+
+		using Rx = StreamRef<HalI2cDriver::RxDmaStream(port).base, HalI2cDriver::RxDmaStream(port).channel>;
+		using Tx = StreamRef<HalI2cDriver::TxDmaStream(port).base, HalI2cDriver::TxDmaStream(port).channel>;
+
+		static inline I2C_TypeDef* I2c() {
+			return HalI2cDriver::MapPort(port);
+		}
+
+		/*
+		 * @brief Attache les streams à DR, active les requêtes DMA, les interruptions EV/ER et l'ACK d'adresse.
+		 **/
+		static void init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalRccDriver::enable({ RccBus::AHB1, RCC_AHB1ENR_DMA1EN });
+			I2C_TypeDef* i2c = I2c();
+			Rx::stop();
+			Tx::stop();
+			const uint32_t dataReg = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&i2c->DR));
+			Rx::Stream()->PAR = dataReg;
+			Rx::Stream()->FCR = 0; // Mode direct
+			Tx::Stream()->PAR = dataReg;
+			Tx::Stream()->FCR = 0;
+
+			const IRQn_Type irqs[2] = { HalI2cDriver::EventIrq(port), HalI2cDriver::ErrorIrq(port) };
+			for (IRQn_Type irq : irqs) {
+				HAL_NVIC_SetPriority(irq, preemptPriority, subPriority);
+				HAL_NVIC_EnableIRQ(irq);
+			}
+
+			i2c->CR2 = (i2c->CR2 & I2C_CR2_FREQ) | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN | I2C_CR2_DMAEN;
+			i2c->CR1 = i2c->CR1 | I2C_CR1_PE | I2C_CR1_ACK;
+		}
+
+		// Réception (maître écrit) dans data ; l'horloge reste étirée jusqu'à ce que le DMA lise DR
+		static inline void start_rx(uint8_t* data, uint16_t size) {
+			Rx::start(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)), size, 0u);
+		}
+
+		// Émission (maître lit) depuis data
+		static inline void start_tx(const uint8_t* data, uint16_t size) {
+			Tx::start(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)), size, DMA_SxCR_DIR_0);
+		}
+
+		// Efface un drapeau d'erreur de SR1 (bits rc_w0)
+		static inline void clear_sr1(uint32_t flag) {
+			I2c()->SR1 = ~flag & 0xFFFFu;
+		}
+
+		// Fin d'émission sur NACK du maître : même vidage de DR que la HAL (I2C_Flush_DR)
+		static inline void flush_tx() {
+			I2C_TypeDef* i2c = I2c();
+			if (i2c->SR1 & I2C_SR1_TXE)
+				i2c->DR = 0x00u;
+		}
+	};
+
+} // namespace Hal
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include "AdcEnumsStructs.hpp"
 #include "AdcConfigPolicy.hpp"
 #include "stm32f4xx_hal.h" // Inclure la base HAL
@@ -8,35 +9,14 @@ using namespace WrapperBase;
 
 namespace Hal {
 
-	struct IAdcDriver {
-        
-		/// <summary>
-		/// @brief Initialise le priphrique ADC principal (horloge, rsolution, etc.)
-		/// </summary>
-		template <AdcConfigPolicy config>
-			void init_peripheral();
-        
-		/// <summary>
-		/// @brief Configure un canal spcifique sur le priphrique ADC.
-		/// </summary>
-		template <AdcConfigPolicy config>
-			void config_channel();
-
-		/// <summary>
+	/// <summary>
+	/// @brief Contrat du driver ADC (vrifi  la compilation, sans appel virtuel).
+	/// init_peripheral<config>() et config_channel<config>() sont vrifis  l'instanciation du wrapper.
+	/// </summary>
+	template <typename D>
+	concept AdcDriverConcept = requires(D driver, AdcPort port) {
 		/// @brief Lance une conversion et lit la valeur (blocage).
-		/// </summary>
-		virtual uint32_t read(AdcPort port) = 0;
-        
-		// --- Fonctions d'aide statiques pour le mappage ---
-        
-		static ADC_TypeDef* MapPort(AdcPort port);
-		static uint32_t MapChannel(AdcChannel channel);
-		static uint32_t MapResolution(AdcResolution res);
-		static uint32_t MapSampleTime(AdcSampleTime time);
-		static void enable_clock(AdcPort port);
-		static bool is_clock_enabled(AdcPort port);
-
-		virtual ~IAdcDriver() = default;
+		{ driver.read(port) } -> std::same_as<uint32_t>;
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
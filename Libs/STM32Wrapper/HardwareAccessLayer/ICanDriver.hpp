@@ -1,38 +1,25 @@
 #pragma once
 
-#include "CAN/CanEnumsStructs.hpp"
-#include "CAN/CanConfigPolicy.hpp"
+#include <concepts>
+#include "CanEnumsStructs.hpp"
+#include "CanConfigPolicy.hpp"
+#include "Callback.hpp"
 #include "stm32f4xx_hal.h" 
-#include <functional>
 
 using namespace WrapperBase;
 
 namespace Hal {
 
-	struct ICanDriver {
-        
-		/// @brief Initialise le périphérique CAN et le Bit Timing.
-		template <CanConfigPolicy config>
-			void init_peripheral();
-        
-		/// @brief Configure les filtres du CAN.
-		template <CanConfigPolicy config>
-			void config_filter();
-
+	/// @brief Contrat du driver CAN (vérifié à la compilation, sans appel virtuel).
+	/// init_peripheral<config>() et config_filter<config>() sont vérifiés à l'instanciation du wrapper.
+	template <typename D>
+	concept CanDriverConcept = requires(D driver, CanPort port, CanRxFifo fifo, const CanMessage& txMessage, CanMessage& rxMessage, Callback<const CanMessage&> cb) {
 		/// @brief Envoie un message sur le bus (non-blocant).
-		virtual bool transmit(CanPort port, const CanMessage& message) = 0;
-        
+		{ driver.transmit(port, txMessage) } -> std::same_as<bool>;
 		/// @brief Réception d'un message via la FIFO (pollé/blocant).
-		virtual bool receive_polling(CanPort port, CanRxFifo fifo, CanMessage& message) = 0;
-        
+		{ driver.receive_polling(port, fifo, rxMessage) } -> std::same_as<bool>;
 		/// @brief Attache un callback à la réception d'un message par interruption.
-		virtual void attach_rx_interrupt(CanPort port, CanRxFifo fifo, std::function<void(const CanMessage&)> cb) = 0;
-
-		// --- Fonctions d'aide statiques ---
-		// Vous aurez besoin de fonctions statiques similaires à celles du GPIO/ADC
-		// pour mapper les enums vers les constantes HAL (`CAN_MODE_NORMAL`, `CAN_TX_TYPE_STDID`, etc.)
-        
-		virtual ~ICanDriver() = default;
+		driver.attach_rx_interrupt(port, fifo, cb);
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
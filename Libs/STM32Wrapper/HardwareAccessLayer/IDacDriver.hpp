@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include "DacEnumsStructs.hpp"
 #include "DacConfigPolicy.hpp"
 #include "stm32f4xx_hal.h" // Inclure la base HAL
@@ -8,46 +9,15 @@ using namespace WrapperBase;
 
 namespace Hal {
 
-	struct IDacDriver {
-        
-		/// <summary>
-		/// @brief Initialise le périphérique DAC principal (horloge).
-		/// </summary>
-		template <DacConfigPolicy config>
-			void init_peripheral();
-        
-		/// <summary>
-		/// @brief Configure un canal spécifique sur le périphérique DAC.
-		/// </summary>
-		template <DacConfigPolicy config>
-			void config_channel();
-
-		/// <summary>
-		/// @brief Écrit une valeur sur le canal DAC.
-		/// </summary>
-		virtual void write(DacPort port, DacChannel channel, DacDataAlign align, uint32_t value) = 0;
-        
-		/// <summary>
-		/// @brief Démarre la sortie DAC.
-		/// </summary>
-		virtual void start(DacPort port, DacChannel channel) = 0;
-
-		/// <summary>
-		/// @brief Arrête la sortie DAC.
-		/// </summary>
-		virtual void stop(DacPort port, DacChannel channel) = 0;
-
-		// --- Fonctions d'aide statiques pour le mappage ---
-        
-		static DAC_TypeDef* MapPort(DacPort port);
-		static uint32_t MapChannel(DacChannel channel);
-		static uint32_t MapAlign(DacDataAlign align);
-		static uint32_t MapOutputBuffer(bool enabled);
-        
-		static void enable_clock(DacPort port);
-		static bool is_clock_enabled(DacPort port);
-
-		virtual ~IDacDriver() = default;
+	/// <summary>
+	/// @brief Contrat du driver DAC (vérifié à la compilation, sans appel virtuel).
+	/// init_peripheral<config>() et config_channel<config>() sont vérifiés à l'instanciation du wrapper.
+	/// </summary>
+	template <typename D>
+	concept DacDriverConcept = requires(D driver, DacPort port, DacChannel channel, DacDataAlign align, uint32_t value) {
+		driver.write(port, channel, align, value);
+		driver.start(port, channel);
+		driver.stop(port, channel);
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
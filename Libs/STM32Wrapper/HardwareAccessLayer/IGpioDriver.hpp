@@ -1,10 +1,11 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include "stm32f4xx_hal.h"
-#include "stm32f4xx_hal_gpio.h"
 #include "GpioEnumsStructs.hpp"
 #include "GpioConfigPolicy.hpp"
-#include <functional>
+#include "Callback.hpp"
 
 using namespace WrapperBase;
 
@@ -12,48 +13,21 @@ using namespace WrapperBase;
 namespace Hal 
 {
 	/*
-	 * @brief Interface for GPIO driver, bas niveau.
+	 * @brief Contrat d'un driver GPIO bas niveau, vérifié à la compilation.
+	 * GpioStatic<config, Driver> reçoit le driver concret en paramètre template : les appels sont
+	 * résolus statiquement et inlinables (ni vtable ni vptr). Un mock fournit les mêmes fonctions.
+	 * init<config>() étant un template, il est vérifié à l'instanciation du wrapper.
 	 **/
-	struct IGpioDriver {
-		/*
-		 * @Brief Initialisation Gpio
-		 * Cette fonction avec template aide à l'initialisation et l'exploitation d'un port GPIO
-		 **/
-		template <GpioConfigPolicy config>
-		void init();
+	template <typename D>
+	concept GpioDriverConcept = requires(D driver, GpioPort port, uint16_t pinMask, GpioPinState state, uint8_t pin, Callback<> cb) {
+		driver.attach_interrupt(pin, cb);
 		
-		template <GpioConfigPolicy T>
-		GPIO_InitTypeDef getHALConfig();
+		// Ecrire / lire / toggle un état Gpio
+		driver.write(port, pinMask, state);
+		{ driver.read(port, pinMask) } -> std::same_as<GpioPinState>;
+		driver.toggle(port, pinMask);
 		
-		virtual void attach_interrupt(uint8_t pin, std::function<void()> cb) = 0;
-		
-		/*
-		 * @Brief Ecrire un état Gpio
-		 **/
-		virtual void write(GpioPort, uint16_t, GpioPinState) = 0;
-		
-		/*
-		 * @Brief Lire un état Gpio
-		 **/
-		virtual GpioPinState read(GpioPort, uint16_t) = 0;
-		/*
-		 * @Brief Toggle un Gpio
-		 **/
-		virtual void toggle(GpioPort, uint16_t) = 0;
-		
-		static inline void enable_clock(GpioPort port);
-		static inline bool is_enabled(GpioPort port);
-
-		static constexpr GPIO_TypeDef *MapPort(GpioPort port);
-		static constexpr uint32_t MapPinMode(GpioPinMode mode);
-		static constexpr uint32_t MapPull(GpioPullMode pull);
-		static constexpr uint32_t MapSpeed(GpioPinSpeed speed);
-		static constexpr uint32_t MapInterruptEdge(GpioInterruptEdge edge);
-		static constexpr uint32_t MapAlternateFunction(GpioAlternateFunctionType af);
-		
-		static void EnableIrq(uint16_t pin, uint32_t PreemptPriority, uint32_t SubPriority);
-		
-		virtual ~IGpioDriver() = default;
+		D::EnableIrq(uint16_t {}, uint32_t {}, uint32_t {});
 	};
 
 }
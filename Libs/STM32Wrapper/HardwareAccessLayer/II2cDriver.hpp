@@ -1,43 +1,36 @@
 #pragma once
+#include <concepts>
+#include <cstdint>
 #include "stm32f4xx_hal.h"
 #include "I2cEnumsStructs.hpp"
 #include "I2cConfigPolicy.hpp"
-#include <functional>
+#include "Callback.hpp"
 
 using namespace Wrapper;
 using namespace WrapperBase;
 
 namespace Hal {
 
-	/// @brief Interface pour le driver I2C de bas niveau.
-	struct II2cDriver {
-		template<I2cConfigPolicy T>
-			int8_t init();
-
-		virtual HAL_StatusTypeDef master_transmit(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef master_receive(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef mem_write(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef mem_read(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-
-		virtual HAL_StatusTypeDef master_transmit_it(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size) = 0;
-		virtual HAL_StatusTypeDef master_receive_it(int8_t handleIndex, uint16_t devAddress, uint8_t* data, uint16_t size) = 0;
-		virtual HAL_StatusTypeDef mem_write_it(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size) = 0;
-		virtual HAL_StatusTypeDef mem_read_it(int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize, uint8_t* data, uint16_t size) = 0;
-
-		static constexpr I2C_TypeDef* MapPort(I2cPort port);
-		static constexpr uint32_t MapAddressingMode(I2cAddressingMode mode);
-		static constexpr uint32_t MapDutyCycle(I2cDutyCycle cycle);
-
-		static void attach_callbacks(int8_t handle_index,
-			std::function<void()> tx_cb,
-			std::function<void()> rx_cb,
-			std::function<void()> error_cb);
-                                     
-		static void activate_IRQ(I2cPort port);
-		static void enable_clock(I2cPort port);
-		static bool is_enabled(I2cPort port);
-
-		virtual ~II2cDriver() = default;
+	/// @brief Contrat du driver I2C de bas niveau (vérifié à la compilation, sans appel virtuel).
+	template <typename D>
+	concept I2cDriverConcept = requires(D driver, int8_t handleIndex, uint16_t devAddress, uint16_t memAddress, uint16_t memAddSize,
+		const uint8_t* txData, uint8_t* rxData, uint16_t size, uint32_t timeout, I2cPort port, Callback<> cb) {
+		{ D::handleEmpty } -> std::convertible_to<int8_t>;
+		// Index de handle fixe par port (constexpr) : les wrappers le résolvent à la compilation
+		{ D::handle_index(port) } -> std::convertible_to<int8_t>;
+
+		{ driver.master_transmit(handleIndex, devAddress, txData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.master_receive(handleIndex, devAddress, rxData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.mem_write(handleIndex, devAddress, memAddress, memAddSize, txData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.mem_read(handleIndex, devAddress, memAddress, memAddSize, rxData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+
+		{ driver.master_transmit_it(handleIndex, devAddress, txData, size) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.master_receive_it(handleIndex, devAddress, rxData, size) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.mem_write_it(handleIndex, devAddress, memAddress, memAddSize, txData, size) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.mem_read_it(handleIndex, devAddress, memAddress, memAddSize, rxData, size) } -> std::same_as<HAL_StatusTypeDef>;
+
+		D::attach_callbacks(handleIndex, cb, cb, cb);
+		D::activate_IRQ(port);
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include "stm32f4xx_hal.h"
 #include "PwmEnumsStructs.hpp"
 #include "PwmConfigPolicy.hpp"
@@ -8,52 +9,18 @@ using namespace WrapperBase;
 
 namespace Hal {
 	/*
-	 * @brief Interface for PWM driver, bas niveau.
+	 * @brief Contrat du driver PWM bas niveau, vrifi  la compilation (sans appel virtuel).
+	 * init<config>() est vrifi  l'instanciation du wrapper.
 	 **/
-	struct IPwmDriver {
-        
-		/*
-		 * @Brief Initialisation du Timer et du canal PWM
-		 **/
-		template <PwmConfigPolicy config>
-			void init() = 0;
-        
-		/*
-		 * @Brief Dmarre la gnration du signal PWM
-		 **/
-		virtual void start(PwmTimerInstance timer, PwmTimerChannel channel) = 0;
-        
-		/*
-		 * @Brief Arrte la gnration du signal PWM
-		 **/
-		virtual void stop(PwmTimerInstance timer, PwmTimerChannel channel) = 0;
-        
-		/*
-		 * @Brief Dfinit la valeur du "pulse" (le rapport cyclique)
-		 * @param pulse La valeur du registre CCR (Compare Capture Register).
-		 * Doit tre entre 0 et la valeur `Period` de la config.
-		 **/
-		virtual void setDutyCycle(PwmTimerInstance timer, PwmTimerChannel channel, uint32_t pulse) = 0;
-        
-		/*
-		 * @Brief Met  jour la priode (valeur ARR)
-		 **/
-		virtual void setPeriod(PwmTimerInstance timer, uint32_t period) = 0;
-        
-		/*
-		 * @Brief Met  jour le prescaler (valeur PSC)
-		 **/
-		virtual void setPrescaler(PwmTimerInstance timer, uint32_t prescaler) = 0;
-        
-
-		// --- Fonctions de mapping statiques ---
-		static TIM_TypeDef* MapTimerInstance(PwmTimerInstance timer);
-		static uint32_t MapTimerChannel(PwmTimerChannel channel);
-		static uint32_t MapPolarity(PwmPolarity polarity);
-		static uint32_t MapMode(PwmMode mode);
-		static void EnableClock(PwmTimerInstance timer);
-
-		virtual ~IPwmDriver() = default;
+	template <typename D>
+	concept PwmDriverConcept = requires(D driver, PwmTimerInstance timer, PwmTimerChannel channel, uint32_t value) {
+		// Dmarre / arrte la gnration du signal PWM
+		driver.start(timer, channel);
+		driver.stop(timer, channel);
+		// Rapport cyclique (CCR), priode (ARR), prescaler (PSC)
+		driver.setDutyCycle(timer, channel, value);
+		driver.setPeriod(timer, value);
+		driver.setPrescaler(timer, value);
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
@@ -1,53 +1,37 @@
 // ISpiDriver.hpp
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include "stm32f4xx_hal.h"
 #include "SpiEnumsStructs.hpp"
 #include "SpiConfigPolicy.hpp"
-#include <functional>
+#include "Callback.hpp"
 
 using namespace Wrapper;
 using namespace WrapperBase;
 
 namespace Hal {
 
-	/// @brief Interface pour le driver SPI de bas niveau.
-	struct ISpiDriver {
-		template<SpiConfigPolicy T>
-			int8_t init();
+	/// @brief Contrat du driver SPI de bas niveau (vérifié à la compilation, sans appel virtuel).
+	template <typename D>
+	concept SpiDriverConcept = requires(D driver, int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size, uint32_t timeout, SpiPort port, Callback<> cb) {
+		{ D::handleEmpty } -> std::convertible_to<int8_t>;
+		// Index de handle fixe par port (constexpr) : les wrappers le résolvent à la compilation
+		{ D::handle_index(port) } -> std::convertible_to<int8_t>;
 
 		// Fonctions bloquantes
-		virtual HAL_StatusTypeDef transmit(int8_t handleIndex, const uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef receive(int8_t handleIndex, uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef transmit_receive(int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size, uint32_t timeout) = 0;
+		{ driver.transmit(handleIndex, txData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.receive(handleIndex, rxData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.transmit_receive(handleIndex, txData, rxData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
 
 		// Fonctions non-bloquantes (Interrupt)
-		virtual HAL_StatusTypeDef transmit_it(int8_t handleIndex, const uint8_t* data, uint16_t size) = 0;
-		virtual HAL_StatusTypeDef receive_it(int8_t handleIndex, uint8_t* data, uint16_t size) = 0;
-		virtual HAL_StatusTypeDef transmit_receive_it(int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size) = 0;
-
-		// Fonctions statiques de mapping et de gestion
-		static constexpr SPI_TypeDef* MapPort(SpiPort port);
-		static constexpr uint32_t MapMode(SpiMode mode);
-		static constexpr uint32_t MapDirection(SpiDirection dir);
-		static constexpr uint32_t MapDataSize(SpiDataSize size);
-		static constexpr uint32_t MapClockPolarity(SpiClockPolarity cpol);
-		static constexpr uint32_t MapClockPhase(SpiClockPhase cpha);
-		static constexpr uint32_t MapNssMode(SpiNssMode nss);
-		static constexpr uint32_t MapPrescaler(SpiBaudRatePrescaler psc);
-		static constexpr uint32_t MapFirstBit(SpiFirstBit fb);
-
-		static void attach_callbacks(int8_t handle_index,
-			std::function<void()> tx_cb,
-			std::function<void()> rx_cb,
-			std::function<void()> txrx_cb,
-			std::function<void()> error_cb);
-
-		static void activate_IRQ(SpiPort port);
-		static void enable_clock(SpiPort port);
-		static bool is_enabled(SpiPort port);
-
-		virtual ~ISpiDriver() = default;
+		{ driver.transmit_it(handleIndex, txData, size) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.receive_it(handleIndex, rxData, size) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.transmit_receive_it(handleIndex, txData, rxData, size) } -> std::same_as<HAL_StatusTypeDef>;
+
+		D::attach_callbacks(handleIndex, cb, cb, cb, cb);
+		D::activate_IRQ(port);
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
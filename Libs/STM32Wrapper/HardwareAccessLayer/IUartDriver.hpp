@@ -1,37 +1,30 @@
 // IUartDriver.hpp
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include "stm32f4xx_hal.h"
 #include "UartEnumsStructs.hpp"
-#include <functional>
+#include "Callback.hpp"
 
 using namespace Wrapper;
 
 namespace Hal {
 
-	/// @brief Interface pour le driver UART de bas niveau.
-	struct IUartDriver {
-		template<typename T>
-			uint8_t init();
-		
-		virtual HAL_StatusTypeDef transmit(int8_t handleIndex, const uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef receive(int8_t handleIndex, uint8_t* data, uint16_t size, uint32_t timeout) = 0;
-		virtual HAL_StatusTypeDef transmit_it(int8_t handleIndex, const uint8_t* data, uint16_t size) = 0;
-		virtual HAL_StatusTypeDef receive_it(int8_t handleIndex, uint8_t* data, uint16_t size) = 0;
-		
-		constexpr uint32_t MapWordLength(UartWordLength len);
-		constexpr uint32_t MapStopBits(UartStopBits sb);
-		constexpr uint32_t MapParity(UartParity p);
-		constexpr uint32_t MapMode(UartMode m);
-		constexpr uint32_t MapHwControl(UartHwControl hc);
-		
-		static void attach_callbacks(int8_t handle_index, std::function<void()> tx_cb, std::function<void()> rx_cb);
-		static void activate_IRQ(UartPort port);
-		
-		static void enable_clock();
-		static bool is_enabled();
-		
-		virtual ~IUartDriver() = default;
+	/// @brief Contrat du driver UART de bas niveau (vérifié à la compilation, sans appel virtuel).
+	template <typename D>
+	concept UartDriverConcept = requires(D driver, int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size, uint32_t timeout, UartPort port, Callback<> cb) {
+		{ D::handleEmpty } -> std::convertible_to<int8_t>;
+		// Index de handle fixe par port (constexpr) : les wrappers le résolvent à la compilation
+		{ D::handle_index(port) } -> std::convertible_to<int8_t>;
+
+		{ driver.transmit(handleIndex, txData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.receive(handleIndex, rxData, size, timeout) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.transmit_it(handleIndex, txData, size) } -> std::same_as<HAL_StatusTypeDef>;
+		{ driver.receive_it(handleIndex, rxData, size) } -> std::same_as<HAL_StatusTypeDef>;
+
+		D::attach_callbacks(handleIndex, cb, cb);
+		D::activate_IRQ(port);
 	};
 
-} // namespace Hal
\ No newline at end of file
+} // namespace Hal
@@ -4,31 +4,39 @@
 #include "PwmEnumsStructs.hpp"
 #include "PwmConfigPolicy.hpp"
 #include "stm32f4xx_hal.h"
-#include <map>
+#include "RccDriver.hpp"
+#include "HandleRegistry.hpp"
 #include <cassert>
 
 namespace Hal {
 
-	struct HalPwmDriver : public IPwmDriver {
+	struct HalPwmDriver {
 
-		// Map statique pour stocker les handles des timers déjà initialisés
-		// Clé: Pointeur vers le registre du timer (ex: TIM2)
-		// Valeur: Le handle HAL correspondant
-		inline static std::map<TIM_TypeDef*, TIM_HandleTypeDef> m_handles;
+		// Un handle HAL statique par timer, indexé par PwmTimerInstance (adresse constante, sans recherche)
+		static constexpr size_t TimerCount = 12;
+		using Handles = HandleRegistry<PwmTimerInstance, TIM_HandleTypeDef, TimerCount>;
 
 		template <PwmConfigPolicy T>
-			void init() override {
-				TIM_TypeDef* instance = MapTimerInstance(T::Timer);
-				TIM_HandleTypeDef htim;
+			void init() {
+				// Active l'horloge à la première initialisation de ce timer
+				if (!Handles::is_initialized(T::Timer)) {
+					EnableClock(T::Timer);
+				}
+				init_peripheral<T>();
+			}
 
-				// Vérifie si ce timer a déjà été initialisé
-				bool is_new_timer = (m_handles.find(instance) == m_handles.end());
+		/*
+		 * @Brief Initialise le timer et le canal sans toucher à l'horloge (déjà activée, ex: par BoardInit).
+		 **/
+		template <PwmConfigPolicy T>
+			void init_peripheral() {
+				TIM_HandleTypeDef& htim = Handles::template at<T::Timer>();
 
-				if (is_new_timer) {
+				// Vérifie si ce timer a déjà été initialisé
+				if (!Handles::is_initialized(T::Timer)) {
 					// Première initialisation pour ce timer
-					EnableClock(T::Timer); // Active l'horloge du timer
-                
-					htim.Instance = instance;
+					htim = {};
+					htim.Instance = MapTimerInstance(T::Timer);
 					htim.Init.Prescaler = T::Prescaler;
 					htim.Init.Period = T::Period;
 					htim.Init.CounterMode = TIM_COUNTERMODE_UP;
@@ -39,16 +47,11 @@ namespace Hal {
 					if (HAL_TIM_PWM_Init(&htim) != HAL_OK) {
 						assert("HAL_TIM_PWM_Init failed");
 					}
-                
-					m_handles[instance] = htim; // Sauvegarde le handle
-				}
-				else {
-					// Timer déjà initialisé, on récupère juste le handle
-					htim = m_handles[instance];
-					// Note: Idéalement, on pourrait vérifier si T::Prescaler et T::Period
-					// correspondent à ceux déjà configurés. Pour l'instant, on suppose
-					// que la première configuration est la bonne.
 				}
+				// Sinon : timer déjà initialisé, le handle est partagé par ses canaux.
+				// Note: Idéalement, on pourrait vérifier si T::Prescaler et T::Period
+				// correspondent à ceux déjà configurés. Pour l'instant, on suppose
+				// que la première configuration est la bonne.
 
 				// Configuration spécifique du canal PWM
 				TIM_OC_InitTypeDef oc_config = { };
@@ -60,34 +63,31 @@ namespace Hal {
 				if (HAL_TIM_PWM_ConfigChannel(&htim, &oc_config, MapTimerChannel(T::Channel)) != HAL_OK) {
 					assert("HAL_TIM_PWM_ConfigChannel failed");
 				}
-
-				// Met à jour le handle dans la map (au cas où HAL l'aurait modifié)
-				m_handles[instance] = htim;
 			}
 
-		void start(PwmTimerInstance timer, PwmTimerChannel channel) override {
-			TIM_HandleTypeDef* htim = &m_handles[MapTimerInstance(timer)];
+		void start(PwmTimerInstance timer, PwmTimerChannel channel) {
+			TIM_HandleTypeDef* htim = &Handles::at(timer);
 			HAL_TIM_PWM_Start(htim, MapTimerChannel(channel));
 		}
 
-		void stop(PwmTimerInstance timer, PwmTimerChannel channel) override {
-			TIM_HandleTypeDef* htim = &m_handles[MapTimerInstance(timer)];
+		void stop(PwmTimerInstance timer, PwmTimerChannel channel) {
+			TIM_HandleTypeDef* htim = &Handles::at(timer);
 			HAL_TIM_PWM_Stop(htim, MapTimerChannel(channel));
 		}
 
-		void setDutyCycle(PwmTimerInstance timer, PwmTimerChannel channel, uint32_t pulse) override {
-			TIM_HandleTypeDef* htim = &m_handles[MapTimerInstance(timer)];
+		void setDutyCycle(PwmTimerInstance timer, PwmTimerChannel channel, uint32_t pulse) {
+			TIM_HandleTypeDef* htim = &Handles::at(timer);
 			// Utilise la macro HAL pour une mise à jour efficace (évite de reconfigurer tout le canal)
 			__HAL_TIM_SET_COMPARE(htim, MapTimerChannel(channel), pulse);
 		}
 
-		void setPeriod(PwmTimerInstance timer, uint32_t period) override {
-			TIM_HandleTypeDef* htim = &m_handles[MapTimerInstance(timer)];
+		void setPeriod(PwmTimerInstance timer, uint32_t period) {
+			TIM_HandleTypeDef* htim = &Handles::at(timer);
 			__HAL_TIM_SET_AUTORELOAD(htim, period);
 		}
         
-		void setPrescaler(PwmTimerInstance timer, uint32_t prescaler) override {
-			TIM_HandleTypeDef* htim = &m_handles[MapTimerInstance(timer)];
+		void setPrescaler(PwmTimerInstance timer, uint32_t prescaler) {
+			TIM_HandleTypeDef* htim = &Handles::at(timer);
 			__HAL_TIM_SET_PRESCALER(htim, prescaler);
 		}
 
@@ -95,18 +95,18 @@ namespace Hal {
 
 		static TIM_TypeDef* MapTimerInstance(PwmTimerInstance timer) {
 			switch (timer) {
-			case PwmTimerInstance::TIM1:  return TIM1;
-			case PwmTimerInstance::TIM2:  return TIM2;
-			case PwmTimerInstance::TIM3:  return TIM3;
-			case PwmTimerInstance::TIM4:  return TIM4;
-			case PwmTimerInstance::TIM5:  return TIM5;
-			case PwmTimerInstance::TIM8:  return TIM8;
-			case PwmTimerInstance::TIM9:  return TIM9;
-			case PwmTimerInstance::TIM10: return TIM10;
-			case PwmTimerInstance::TIM11: return TIM11;
-			case PwmTimerInstance::TIM12: return TIM12;
-			case PwmTimerInstance::TIM13: return TIM13;
-			case PwmTimerInstance::TIM14: return TIM14;
+			case PwmTimerInstance::TIM_1:  return TIM1;
+			case PwmTimerInstance::TIM_2:  return TIM2;
+			case PwmTimerInstance::TIM_3:  return TIM3;
+			case PwmTimerInstance::TIM_4:  return TIM4;
+			case PwmTimerInstance::TIM_5:  return TIM5;
+			case PwmTimerInstance::TIM_8:  return TIM8;
+			case PwmTimerInstance::TIM_9:  return TIM9;
+			case PwmTimerInstance::TIM_10: return TIM10;
+			case PwmTimerInstance::TIM_11: return TIM11;
+			case PwmTimerInstance::TIM_12: return TIM12;
+			case PwmTimerInstance::TIM_13: return TIM13;
+			case PwmTimerInstance::TIM_14: return TIM14;
 			}
 			assert("Timer instance not supported");
 			return nullptr;
@@ -130,24 +130,30 @@ namespace Hal {
 			return (mode == PwmMode::PWM1) ? TIM_OCMODE_PWM1 : TIM_OCMODE_PWM2;
 		}
 
-		static void EnableClock(PwmTimerInstance timer) {
-			// Note: TIM1, TIM8-TIM11 sont sur APB2. Les autres sur APB1.
+		static constexpr RccClockBit ClockBit(PwmTimerInstance timer) {
+			// TIM1, TIM8-TIM11 sont sur APB2. Les autres sur APB1.
 			switch (timer) {
-			case PwmTimerInstance::TIM1:  __HAL_RCC_TIM1_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM2:  __HAL_RCC_TIM2_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM3:  __HAL_RCC_TIM3_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM4:  __HAL_RCC_TIM4_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM5:  __HAL_RCC_TIM5_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM8:  __HAL_RCC_TIM8_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM9:  __HAL_RCC_TIM9_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM10: __HAL_RCC_TIM10_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM11: __HAL_RCC_TIM11_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM12: __HAL_RCC_TIM12_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM13: __HAL_RCC_TIM13_CLK_ENABLE(); break;
-			case PwmTimerInstance::TIM14: __HAL_RCC_TIM14_CLK_ENABLE(); break;
-			default: assert("Timer clock not supported");
+			case PwmTimerInstance::TIM_1:  return { RccBus::APB2, RCC_APB2ENR_TIM1EN };
+			case PwmTimerInstance::TIM_2:  return { RccBus::APB1, RCC_APB1ENR_TIM2EN };
+			case PwmTimerInstance::TIM_3:  return { RccBus::APB1, RCC_APB1ENR_TIM3EN };
+			case PwmTimerInstance::TIM_4:  return { RccBus::APB1, RCC_APB1ENR_TIM4EN };
+			case PwmTimerInstance::TIM_5:  return { RccBus::APB1, RCC_APB1ENR_TIM5EN };
+			case PwmTimerInstance::TIM_8:  return { RccBus::APB2, RCC_APB2ENR_TIM8EN };
+			case PwmTimerInstance::TIM_9:  return { RccBus::APB2, RCC_APB2ENR_TIM9EN };
+			case PwmTimerInstance::TIM_10: return { RccBus::APB2, RCC_APB2ENR_TIM10EN };
+			case PwmTimerInstance::TIM_11: return { RccBus::APB2, RCC_APB2ENR_TIM11EN };
+			case PwmTimerInstance::TIM_12: return { RccBus::APB1, RCC_APB1ENR_TIM12EN };
+			case PwmTimerInstance::TIM_13: return { RccBus::APB1, RCC_APB1ENR_TIM13EN };
+			case PwmTimerInstance::TIM_14: return { RccBus::APB1, RCC_APB1ENR_TIM14EN };
 			}
+			return { RccBus::APB1, 0 };
+		}
+
+		static void EnableClock(PwmTimerInstance timer) {
+			HalRccDriver::enable(ClockBit(timer));
 		}
 	};
 
+	static_assert(PwmDriverConcept<HalPwmDriver>, "HalPwmDriver ne respecte pas PwmDriverConcept");
+
 } // namespace Hal
\ No newline at end of file
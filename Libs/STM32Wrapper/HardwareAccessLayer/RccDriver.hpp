@@ -0,0 +1,105 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include "BitBand.hpp"
+
+namespace Hal {
+
+	/*
+	 * @brief Bus d'horloge RCC portant le bit d'activation d'un périphérique.
+	 **/
+	enum class RccBus {
+		AHB1,
+		APB1,
+		APB2,
+	};
+
+	/*
+	 * @brief Bit d'activation d'horloge d'un périphérique (registre xxxENR + masque).
+	 **/
+	struct RccClockBit {
+		RccBus bus;
+		uint32_t mask;
+	};
+
+	/*
+	 * @brief Ensemble de bits d'activation, regroupés par registre RCC.
+	 * Construit à la compilation pour activer toutes les horloges d'une carte
+	 * avec un seul store par registre.
+	 **/
+	struct RccEnableMasks {
+		uint32_t ahb1 = 0;
+		uint32_t apb1 = 0;
+		uint32_t apb2 = 0;
+
+		constexpr RccEnableMasks& add(RccClockBit bit) {
+			switch (bit.bus) {
+			case RccBus::AHB1: ahb1 |= bit.mask; break;
+			case RccBus::APB1: apb1 |= bit.mask; break;
+			case RccBus::APB2: apb2 |= bit.mask; break;
+			}
+			return *this;
+		}
+
+		constexpr RccEnableMasks& add(const RccEnableMasks& other) {
+			ahb1 |= other.ahb1;
+			apb1 |= other.apb1;
+			apb2 |= other.apb2;
+			return *this;
+		}
+	};
+
+	struct HalRccDriver {
+
+		/*
+		 * @Brief Active toutes les horloges demandées : un store par registre ENR.
+		 * La relecture reproduit le délai des macros __HAL_RCC_xxx_CLK_ENABLE().
+		 **/
+		static inline void enable(const RccEnableMasks& masks) {
+			if (masks.ahb1) {
+				RCC->AHB1ENR = RCC->AHB1ENR | masks.ahb1;
+				(void)RCC->AHB1ENR;
+			}
+			if (masks.apb1) {
+				RCC->APB1ENR = RCC->APB1ENR | masks.apb1;
+				(void)RCC->APB1ENR;
+			}
+			if (masks.apb2) {
+				RCC->APB2ENR = RCC->APB2ENR | masks.apb2;
+				(void)RCC->APB2ENR;
+			}
+		}
+
+		/*
+		 * @Brief Active une seule horloge : un store dans l'alias bit-band du registre ENR.
+		 * Pas de read-modify-write logiciel, donc pas de conflit avec une ISR qui active une autre horloge.
+		 **/
+		static inline void enable(RccClockBit bit) {
+			volatile uint32_t& alias = BitBand::periph(EnrAddress(bit.bus), BitBand::BitIndex(bit.mask));
+			alias = 1u;
+			const uint32_t readback = alias; // Même délai que __HAL_RCC_xxx_CLK_ENABLE()
+			(void)readback;
+		}
+
+		static inline void disable(RccClockBit bit) {
+			BitBand::periph(EnrAddress(bit.bus), BitBand::BitIndex(bit.mask)) = 0u;
+		}
+
+		// Lecture de l'alias : 0/1 directement, sans masque
+		static inline bool is_enabled(RccClockBit bit) {
+			return BitBand::periph(EnrAddress(bit.bus), BitBand::BitIndex(bit.mask)) != 0u;
+		}
+
+		static constexpr uint32_t EnrAddress(RccBus bus) {
+			switch (bus) {
+			case RccBus::AHB1: return RCC_BASE + offsetof(RCC_TypeDef, AHB1ENR);
+			case RccBus::APB1: return RCC_BASE + offsetof(RCC_TypeDef, APB1ENR);
+			case RccBus::APB2: return RCC_BASE + offsetof(RCC_TypeDef, APB2ENR);
+			}
+			return RCC_BASE + offsetof(RCC_TypeDef, AHB1ENR);
+		}
+	};
+
+} // namespace Hal
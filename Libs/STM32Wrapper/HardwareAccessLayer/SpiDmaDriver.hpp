@@ -0,0 +1,201 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include "SpiEnumsStructs.hpp"
+#include "SpiDriver.hpp"
+#include "RccDriver.hpp"
+
+using namespace Wrapper;
+
+namespace Hal {
+
+	/*
+	 * @brief Streams DMA d'émission et de réception d'un port SPI (RM0090, tables 42/43) :
+	 *   SPI1 RX DMA2 Stream0 ch3, TX DMA2 Stream3 ch3
+	 *   SPI2 RX DMA1 Stream3 ch0, TX DMA1 Stream4 ch0 (partagés avec USART3_TX / UART4_TX de HalUartTxDma)
+	 *   SPI3 RX DMA1 Stream0 ch0, TX DMA1 Stream5 ch0 (partagés avec UART5_RX / USART2_RX de HalUartDriver)
+	 * Le stream de réception signale la fin (sa fin implique que la dernière trame est sortie). Le stream
+	 * d'émission n'interrompt que sur erreur de transfert : un stream d'émission arrêté n'écrit plus DR,
+	 * SCK s'arrête et la réception n'aboutirait jamais. Son vecteur (TxIrq) est à lier aussi.
+	 **/
+	template <SpiPort port>
+	struct HalSpiDmaStreams {
+
+		// Un stream DMA : registres de drapeaux, décalage 0, 6, 16, 22 selon l'index dans LISR/HISR
+		template <bool OnDma2, uint32_t Index>
+		struct StreamRef {
+			static constexpr bool HighRegister = (Index >= 4);
+			static constexpr uint32_t FlagShift = (Index % 4 == 0) ? 0u : (Index % 4 == 1) ? 6u : (Index % 4 == 2) ? 16u : 22u;
+			static constexpr uint32_t AllFlags = 0x3Du << FlagShift;
+			static constexpr uint32_t TransferComplete = DMA_LISR_TCIF0 << FlagShift;
+			static constexpr uint32_t HalfTransfer = DMA_LISR_HTIF0 << FlagShift;
+			static constexpr uint32_t TransferError = DMA_LISR_TEIF0 << FlagShift;
+
+			static inline DMA_TypeDef* Controller() {
+				return OnDma2 ? DMA2 : DMA1;
+			}
+
+			static inline DMA_Stream_TypeDef* Stream() {
+				const uint32_t base = OnDma2 ? DMA2_Stream0_BASE : DMA1_Stream0_BASE;
+				return reinterpret_cast<DMA_Stream_TypeDef*>(base + Index * 0x18u);
+			}
+
+			static inline uint32_t flags() {
+				return (HighRegister ? Controller()->HISR : Controller()->LISR) & AllFlags;
+			}
+
+			static inline void clear_flags(uint32_t mask) {
+				if constexpr (HighRegister)
+					Controller()->HIFCR = mask;
+				else
+					Controller()->LIFCR = mask;
+			}
+
+			static void disable() {
+				DMA_Stream_TypeDef* stream = Stream();
+				stream->CR = stream->CR & ~DMA_SxCR_EN;
+				while (stream->CR & DMA_SxCR_EN) {}
+				clear_flags(AllFlags);
+			}
+		};
+
+		static constexpr bool OnDma2 = (port == SpiPort::SPI_1);
+		static constexpr uint32_t Channel = OnDma2 ? 3u : 0u;
+		using Rx = StreamRef<OnDma2, (port == SpiPort::SPI_1) ? 0u : (port == SpiPort::SPI_2) ? 3u : 0u>;
+		using Tx = StreamRef<OnDma2, (port == SpiPort::SPI_1) ? 3u : (port == SpiPort::SPI_2) ? 4u : 5u>;
+
+		static constexpr IRQn_Type Irq = [] {
+			switch (port) {
+				case SpiPort::SPI_1: return DMA2_Stream0_IRQn;
+				case SpiPort::SPI_2: return DMA1_Stream3_IRQn;
+				case SpiPort::SPI_3: return DMA1_Stream0_IRQn;
+			}
+			return DMA2_Stream0_IRQn;
+		}();
+
+		static constexpr IRQn_Type TxIrq = [] {
+			switch (port) {
+				case SpiPort::SPI_1: return DMA2_Stream3_IRQn;
+				case SpiPort::SPI_2: return DMA1_Stream4_IRQn;
+				case SpiPort::SPI_3: return DMA1_Stream5_IRQn;
+			}
+			return DMA2_Stream3_IRQn;
+		}();
+
+		// Vecteurs des deux streams, même priorité : leurs ISR ne se préemptent pas
+		static void enable_irqs(uint32_t preemptPriority, uint32_t subPriority) {
+			for (IRQn_Type irq : { Irq, TxIrq }) {
+				HAL_NVIC_SetPriority(irq, preemptPriority, subPriority);
+				HAL_NVIC_EnableIRQ(irq);
+			}
+		}
+
+		static constexpr RccClockBit ClockBit = OnDma2
+			? RccClockBit { RccBus::AHB1, RCC_AHB1ENR_DMA2EN }
+			: RccClockBit { RccBus::AHB1, RCC_AHB1ENR_DMA1EN };
+
+		// Réception prioritaire : DR est lu avant l'arrivée de la trame suivante (pas d'OVR)
+		static constexpr uint32_t RxPriority = DMA_SxCR_PL_0 | DMA_SxCR_PL_1;
+		static constexpr uint32_t TxPriority = DMA_SxCR_PL_1;
+
+		static constexpr uint32_t SizeBits(bool wide16) {
+			return wide16 ? (DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0) : 0u;
+		}
+
+		static inline SPI_TypeDef* Spi() {
+			return HalSpiDriver::MapPort(port);
+		}
+	};
+
+	/*
+	 * @brief Transferts full-duplex par blocs sur un port SPI maître piloté par registres (sans HAL_SPI_Init),
+	 * pour un moteur qui enchaîne les blocs depuis l'ISR du stream de réception (SpiBus).
+	 * Un côté absent (tx ou rx nul) passe par une trame factice sans incrément : 0xFF émis, octets reçus jetés.
+	 * @note Les blocs doivent être en SRAM1/SRAM2 (la CCM n'est pas accessible par DMA).
+	 **/
+	template <SpiPort port>
+	struct HalSpiBlockDma : HalSpiDmaStreams<port> {
+		using Base = HalSpiDmaStreams<port>;
+		using typename Base::Rx;
+		using typename Base::Tx;
+
+		/*
+		 * @brief Active les horloges SPI et DMA, programme CR1 (sans SPE) et attache les deux streams à DR.
+		 **/
+		static void init(uint32_t cr1, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalSpiDriver::enable_clock(port);
+			HalRccDriver::enable(Base::ClockBit);
+
+			SPI_TypeDef* spi = Base::Spi();
+			spi->CR1 = 0;
+			spi->CR2 = 0;
+			Rx::disable();
+			Tx::disable();
+			const uint32_t dataReg = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&spi->DR));
+			Rx::Stream()->PAR = dataReg;
+			Rx::Stream()->FCR = 0; // Mode direct
+			Tx::Stream()->PAR = dataReg;
+			Tx::Stream()->FCR = 0;
+
+			Base::enable_irqs(preemptPriority, subPriority);
+
+			configure(cr1);
+			spi->CR2 = SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+		}
+
+		/*
+		 * @brief Change CPOL/CPHA/BR/LSBFIRST/DFF : ces bits ne s'écrivent que SPE à 0 (RM0090 28.5.1).
+		 * À appeler bus au repos (dernier bloc reçu, donc BSY à 0).
+		 **/
+		static inline void configure(uint32_t cr1) {
+			SPI_TypeDef* spi = Base::Spi();
+			spi->CR1 = cr1 & ~static_cast<uint32_t>(SPI_CR1_SPE);
+			spi->CR1 = cr1 | SPI_CR1_SPE;
+		}
+
+		/*
+		 * @brief Échange frames trames (1..65535) ; la fin est signalée par TC du stream de réception,
+		 * une erreur par TE de l'un ou l'autre stream.
+		 **/
+		static inline void start(const void* tx, void* rx, uint16_t frames, bool wide16) {
+			const uint32_t common = (Base::Channel << DMA_SxCR_CHSEL_Pos) | Base::SizeBits(wide16);
+
+			DMA_Stream_TypeDef* rxStream = Rx::Stream();
+			Rx::clear_flags(Rx::AllFlags);
+			rxStream->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(rx ? rx : static_cast<void*>(&m_dummyRx)));
+			rxStream->NDTR = frames;
+			rxStream->CR = common | Base::RxPriority | (rx ? DMA_SxCR_MINC : 0u)
+				| DMA_SxCR_TCIE | DMA_SxCR_TEIE; // Périphérique -> mémoire
+
+			DMA_Stream_TypeDef* txStream = Tx::Stream();
+			Tx::clear_flags(Tx::AllFlags);
+			txStream->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(tx ? tx : static_cast<const void*>(&DummyTx)));
+			txStream->NDTR = frames;
+			txStream->CR = common | Base::TxPriority | (tx ? DMA_SxCR_MINC : 0u) | DMA_SxCR_DIR_0
+				| DMA_SxCR_TEIE; // Mémoire -> périphérique
+
+			rxStream->CR = rxStream->CR | DMA_SxCR_EN;
+			txStream->CR = txStream->CR | DMA_SxCR_EN;
+		}
+
+		/*
+		 * @brief Arrête les deux streams (erreur de transfert) et vide DR / OVR.
+		 **/
+		static void abort() {
+			Tx::disable();
+			Rx::disable();
+			SPI_TypeDef* spi = Base::Spi();
+			for (uint32_t guard = 0; (spi->SR & SPI_SR_BSY) && guard < 100000u; ++guard) {}
+			(void)spi->DR;
+			(void)spi->SR;
+		}
+
+	private:
+		inline static const uint16_t DummyTx = 0xFFFFu;
+		inline static uint16_t m_dummyRx = 0;
+	};
+
+} // namespace Hal
@@ -1,128 +1,219 @@
 // SpiDriver.hpp
 #pragma once
 
-#include <vector>
+#include <array>
 #include <cstdint>
-#include <map>
-#include <functional>
 #include "ISpiDriver.hpp"
+#include "RccDriver.hpp"
+#include "HandleRegistry.hpp"
+#include "Callback.hpp"
 
 namespace Hal {
 
-	struct HalSpiDriver : public Hal::ISpiDriver {
+	struct HalSpiDriver {
 
 		inline static constexpr int8_t handleEmpty = -1;
-		inline static std::vector<SPI_HandleTypeDef> spiHandles = { };
+		inline static constexpr size_t PortCount = 3;
+		// Un handle statique par port : adresse fixe, index du handle == index du port
+		using Handles = HandleRegistry<SpiPort, SPI_HandleTypeDef, PortCount>;
 
-		// Maps pour les callbacks
-		inline static std::map<SPI_TypeDef*, std::function<void()>> tx_complete_callbacks = { };
-		inline static std::map<SPI_TypeDef*, std::function<void()>> rx_complete_callbacks = { };
-		inline static std::map<SPI_TypeDef*, std::function<void()>> txrx_complete_callbacks = { };
-		inline static std::map<SPI_TypeDef*, std::function<void()>> error_callbacks = { };
+		// Tables de dispatch indexées par port : accès O(1), sans allocation, utilisables en ISR
+		inline static std::array<Callback<>, PortCount> tx_complete_callbacks = { };
+		inline static std::array<Callback<>, PortCount> rx_complete_callbacks = { };
+		inline static std::array<Callback<>, PortCount> txrx_complete_callbacks = { };
+		inline static std::array<Callback<>, PortCount> error_callbacks = { };
 
 		template<SpiConfigPolicy T>
 			int8_t init() {
 				enable_clock(T::Port);
+				return init_peripheral<T>();
+			}
 
-				SPI_HandleTypeDef m_handle = { };
+		// Initialise le SPI sans toucher à l'horloge (déjà activée, ex: par BoardInit)
+		template<SpiConfigPolicy T>
+			int8_t init_peripheral() {
+				SPI_HandleTypeDef& m_handle = Handles::template at<T::Port>();
+				m_handle = { };
 				m_handle.Instance = MapPort(T::Port);
 				m_handle.Init = getHALConfig<T>();
 
 				HAL_StatusTypeDef status = HAL_SPI_Init(&m_handle);
 
 				if (status == HAL_OK) {
-					spiHandles.push_back(m_handle);
-					return spiHandles.size() - 1;
+					return handle_index(T::Port);
 				}
+				m_handle.Instance = nullptr;
 				return handleEmpty;
 			}
 
+		static constexpr int8_t handle_index(SpiPort port) {
+			return static_cast<int8_t>(PortIndex(port));
+		}
+
 		// --- Implémentation des fonctions bloquantes ---
-		HAL_StatusTypeDef transmit(int8_t handleIndex, const uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_SPI_Transmit(&spiHandles[handleIndex], data, size, timeout);
+		HAL_StatusTypeDef transmit(int8_t handleIndex, const uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_SPI_Transmit(&Handles::at(static_cast<size_t>(handleIndex)), data, size, timeout);
 		}
-		HAL_StatusTypeDef receive(int8_t handleIndex, uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_SPI_Receive(&spiHandles[handleIndex], data, size, timeout);
+		HAL_StatusTypeDef receive(int8_t handleIndex, uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_SPI_Receive(&Handles::at(static_cast<size_t>(handleIndex)), data, size, timeout);
 		}
-		HAL_StatusTypeDef transmit_receive(int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size, uint32_t timeout) override {
-			return HAL_SPI_TransmitReceive(&spiHandles[handleIndex], txData, rxData, size, timeout);
+		HAL_StatusTypeDef transmit_receive(int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size, uint32_t timeout) {
+			return HAL_SPI_TransmitReceive(&Handles::at(static_cast<size_t>(handleIndex)), txData, rxData, size, timeout);
 		}
 
 		// --- Implémentation des fonctions non-bloquantes (IT) ---
-		HAL_StatusTypeDef transmit_it(int8_t handleIndex, const uint8_t* data, uint16_t size) override {
-			return HAL_SPI_Transmit_IT(&spiHandles[handleIndex], data, size);
+		HAL_StatusTypeDef transmit_it(int8_t handleIndex, const uint8_t* data, uint16_t size) {
+			return HAL_SPI_Transmit_IT(&Handles::at(static_cast<size_t>(handleIndex)), data, size);
+		}
+		HAL_StatusTypeDef receive_it(int8_t handleIndex, uint8_t* data, uint16_t size) {
+			return HAL_SPI_Receive_IT(&Handles::at(static_cast<size_t>(handleIndex)), data, size);
 		}
-		HAL_StatusTypeDef receive_it(int8_t handleIndex, uint8_t* data, uint16_t size) override {
-			return HAL_SPI_Receive_IT(&spiHandles[handleIndex], data, size);
+		HAL_StatusTypeDef transmit_receive_it(int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size) {
+			return HAL_SPI_TransmitReceive_IT(&Handles::at(static_cast<size_t>(handleIndex)), txData, rxData, size);
 		}
-		HAL_StatusTypeDef transmit_receive_it(int8_t handleIndex, const uint8_t* txData, uint8_t* rxData, uint16_t size) override {
-			return HAL_SPI_TransmitReceive_IT(&spiHandles[handleIndex], txData, rxData, size);
+
+		/*
+		 * @brief Échange polled par registres (DR/SR), sans HAL : pour les accès registre de 1 à quelques trames.
+		 * Une trame d'avance dans DR pendant que la précédente sort : pas de blanc entre trames.
+		 * Cohabite avec les chemins HAL / DMA : le handle est pris (état READY -> BUSY_TX_RX) pendant
+		 * l'échange, HAL_BUSY si un transfert IT/DMA ou un flux est en cours.
+		 * tx nul : 0xFF émis ; rx nul : réception ignorée. Maître full-duplex uniquement (horloge garantie).
+		 * @return HAL_ERROR si OVR (interruption plus longue qu'une trame entre deux lectures de DR : une trame
+		 * est perdue, le dernier RXNE n'arriverait jamais), HAL_TIMEOUT si un drapeau ne monte pas.
+		 **/
+		template <SpiPort port, typename Frame>
+			static HAL_StatusTypeDef exchange(const Frame* tx, Frame* rx, size_t count) {
+				SPI_HandleTypeDef& hspi = Handles::template at<port>();
+				if (hspi.State != HAL_SPI_STATE_READY)
+					return HAL_BUSY;
+				hspi.State = HAL_SPI_STATE_BUSY_TX_RX;
+
+				SPI_TypeDef* spi = MapPort(port);
+				if (!(spi->CR1 & SPI_CR1_SPE))
+					spi->CR1 = spi->CR1 | SPI_CR1_SPE; // Activé paresseusement par la HAL au premier transfert
+				const Frame filler = static_cast<Frame>(0xFFFFu);
+
+				HAL_StatusTypeDef status = HAL_OK;
+				if (count > 0)
+					spi->DR = tx ? tx[0] : filler;
+				for (size_t i = 0; i < count && status == HAL_OK; ++i) {
+					if (i + 1 < count) {
+						status = wait_flag(spi, SPI_SR_TXE);
+						if (status != HAL_OK)
+							break;
+						spi->DR = tx ? tx[i + 1] : filler;
+					}
+					status = wait_flag(spi, SPI_SR_RXNE);
+					if (status != HAL_OK)
+						break;
+					const Frame value = static_cast<Frame>(spi->DR);
+					if (rx)
+						rx[i] = value;
+				}
+
+				if (status != HAL_OK) {
+					// Trame perdue ou horloge arrêtée : fin de la trame en cours, puis DR / OVR vidés
+					for (uint32_t guard = 0; (spi->SR & SPI_SR_BSY) && guard < WaitGuard; ++guard) {}
+					(void)spi->DR;
+					(void)spi->SR;
+				}
+				hspi.State = HAL_SPI_STATE_READY;
+				return status;
+			}
+
+		// Attente d'un drapeau de SR. OVR est testé à chaque lecture : la séquence lecture DR puis lecture SR
+		// l'efface, il ne serait plus visible après la boucle.
+		static inline HAL_StatusTypeDef wait_flag(SPI_TypeDef* spi, uint32_t flag) {
+			for (uint32_t guard = 0; guard < WaitGuard; ++guard) {
+				const uint32_t sr = spi->SR;
+				if (sr & SPI_SR_OVR)
+					return HAL_ERROR;
+				if (sr & flag)
+					return HAL_OK;
+			}
+			return HAL_TIMEOUT;
 		}
 
+		// Borne des attentes actives : très au-delà d'une trame de 16 bits au prescaler 256
+		inline static constexpr uint32_t WaitGuard = 100000u;
+
 		// --- Fonctions statiques de gestion ---
+		static SPI_HandleTypeDef* handle(SpiPort port) {
+			return Handles::is_initialized(port) ? &Handles::at(port) : nullptr;
+		}
+
 		static void attach_callbacks(int8_t handle_index,
-			std::function<void()> tx_cb,
-			std::function<void()> rx_cb,
-			std::function<void()> txrx_cb,
-			std::function<void()> error_cb) {
-			SPI_TypeDef* instance = spiHandles[handle_index].Instance;
-			if (tx_cb) tx_complete_callbacks[instance] = std::move(tx_cb);
-			if (rx_cb) rx_complete_callbacks[instance] = std::move(rx_cb);
-			if (txrx_cb) txrx_complete_callbacks[instance] = std::move(txrx_cb);
-			if (error_cb) error_callbacks[instance] = std::move(error_cb);
-		}
-
-		// Fonctions à appeler depuis les callbacks globaux HAL (stm32f4xx_it.c)
-		static void handle_tx_complete(SPI_HandleTypeDef *hspi) {
-			if (tx_complete_callbacks.count(hspi->Instance)) {
-				tx_complete_callbacks[hspi->Instance]();
-			}
+			Callback<> tx_cb,
+			Callback<> rx_cb,
+			Callback<> txrx_cb,
+			Callback<> error_cb) {
+			const int8_t port = handle_index;
+			if (port < 0 || static_cast<size_t>(port) >= PortCount) return;
+			if (tx_cb) tx_complete_callbacks[port] = tx_cb;
+			if (rx_cb) rx_complete_callbacks[port] = rx_cb;
+			if (txrx_cb) txrx_complete_callbacks[port] = txrx_cb;
+			if (error_cb) error_callbacks[port] = error_cb;
 		}
-		static void handle_rx_complete(SPI_HandleTypeDef *hspi) {
-			if (rx_complete_callbacks.count(hspi->Instance)) {
-				rx_complete_callbacks[hspi->Instance]();
-			}
+
+		// Fonctions appelées depuis les callbacks globaux HAL (HalCallbacks.cpp)
+		static inline void handle_tx_complete(SPI_HandleTypeDef *hspi) {
+			const int8_t port = Handles::index_of(hspi);
+			if (port >= 0) tx_complete_callbacks[port]();
 		}
-		static void handle_txrx_complete(SPI_HandleTypeDef *hspi) {
-			if (txrx_complete_callbacks.count(hspi->Instance)) {
-				txrx_complete_callbacks[hspi->Instance]();
-			}
+		static inline void handle_rx_complete(SPI_HandleTypeDef *hspi) {
+			const int8_t port = Handles::index_of(hspi);
+			if (port >= 0) rx_complete_callbacks[port]();
 		}
-		static void handle_error(SPI_HandleTypeDef *hspi) {
-			if (error_callbacks.count(hspi->Instance)) {
-				error_callbacks[hspi->Instance]();
-			}
+		static inline void handle_txrx_complete(SPI_HandleTypeDef *hspi) {
+			const int8_t port = Handles::index_of(hspi);
+			if (port >= 0) txrx_complete_callbacks[port]();
+		}
+		static inline void handle_error(SPI_HandleTypeDef *hspi) {
+			const int8_t port = Handles::index_of(hspi);
+			if (port >= 0) error_callbacks[port]();
 		}
 
-		static void activate_IRQ(SpiPort port) {
-			IRQn_Type irq;
+		static constexpr size_t PortIndex(SpiPort port) {
+			return static_cast<size_t>(port);
+		}
+
+		static inline int8_t PortIndex(const SPI_TypeDef* instance) {
+			if (instance == SPI1) return 0;
+			if (instance == SPI2) return 1;
+			if (instance == SPI3) return 2;
+			return -1;
+		}
+
+		static constexpr IRQn_Type Irq(SpiPort port) {
 			switch (port) {
-			case SpiPort::SPI_1: irq = SPI1_IRQn; break;
-			case SpiPort::SPI_2: irq = SPI2_IRQn; break;
-			case SpiPort::SPI_3: irq = SPI3_IRQn; break;
+			case SpiPort::SPI_1: return SPI1_IRQn;
+			case SpiPort::SPI_2: return SPI2_IRQn;
+			case SpiPort::SPI_3: return SPI3_IRQn;
 			}
+			return SPI1_IRQn;
+		}
+
+		static void activate_IRQ(SpiPort port) {
+			const IRQn_Type irq = Irq(port);
 			HAL_NVIC_SetPriority(irq, 0, 0);
 			HAL_NVIC_EnableIRQ(irq);
 		}
 
 		static void enable_clock(SpiPort port) {
-			if (is_enabled(port)) return;
-			switch (port) {
-				// SPI1 est sur APB2
-			case SpiPort::SPI_1: __HAL_RCC_SPI1_CLK_ENABLE(); break;
-				// SPI2 et SPI3 sont sur APB1
-			case SpiPort::SPI_2: __HAL_RCC_SPI2_CLK_ENABLE(); break;
-			case SpiPort::SPI_3: __HAL_RCC_SPI3_CLK_ENABLE(); break;
-			}
+			HalRccDriver::enable(ClockBit(port));
 		}
 
 		static bool is_enabled(SpiPort port) {
+			return HalRccDriver::is_enabled(ClockBit(port));
+		}
+
+		static constexpr RccClockBit ClockBit(SpiPort port) {
 			switch (port) {
-			case SpiPort::SPI_1: return RCC->APB2ENR & RCC_APB2ENR_SPI1EN;
-			case SpiPort::SPI_2: return RCC->APB1ENR & RCC_APB1ENR_SPI2EN;
-			case SpiPort::SPI_3: return RCC->APB1ENR & RCC_APB1ENR_SPI3EN;
+			case SpiPort::SPI_1: return { RccBus::APB2, RCC_APB2ENR_SPI1EN };
+			case SpiPort::SPI_2: return { RccBus::APB1, RCC_APB1ENR_SPI2EN };
+			case SpiPort::SPI_3: return { RccBus::APB1, RCC_APB1ENR_SPI3EN };
 			}
-			return false;
+			return { RccBus::APB1, 0 };
 		}
 
 		// --- Fonctions de mappage statiques ---
@@ -192,4 +283,6 @@ namespace Hal {
 		}
 	};
 
+	static_assert(SpiDriverConcept<HalSpiDriver>, "HalSpiDriver ne respecte pas SpiDriverConcept");
+
 } // namespace Hal
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include "SpiEnumsStructs.hpp"
+#include "SpiDmaDriver.hpp"
+#include "RccDriver.hpp"
+#include "Callback.hpp"
+
+using namespace Wrapper;
+
+namespace Hal {
+
+	/*
+	 * @brief Flux SPI full-duplex continu : deux streams DMA circulaires (émission et réception) sur des
+	 * tampons de deux moitiés, pilotés directement par registres.
+	 * Une fois lancé, le DMA ne s'arrête plus : aucun réarmement par transfert, donc aucun trou entre
+	 * trames. Le stream de réception interrompt sur HT / TC : la réception d'une moitié implique que
+	 * le DMA d'émission a déjà lu la même moitié, qui peut donc être remplie à nouveau. Le stream
+	 * d'émission n'interrompt que sur erreur (tx_isr, SpiStreamDmaTxIrq) : sans lui, un stream d'émission
+	 * arrêté couperait SCK et le flux se figerait sans erreur.
+	 * Streams : voir HalSpiDmaStreams.
+	 * @note Les tampons doivent être en SRAM1/SRAM2 (la CCM n'est pas accessible par DMA).
+	 **/
+	template <SpiPort port>
+	struct HalSpiStreamDma : HalSpiDmaStreams<port> {
+		using Base = HalSpiDmaStreams<port>;
+		using typename Base::Rx;
+		using typename Base::Tx;
+
+		/*
+		 * @brief Lance le flux : rx et tx contiennent chacun 2 * halfFrames trames (1..32767 par moitié).
+		 * on_half(moitié) est appelé depuis l'ISR quand la moitié 0 ou 1 de rx est complète ; la même
+		 * moitié de tx peut être réécrite jusqu'au tour suivant. tx doit être rempli avant l'appel.
+		 * on_error est appelé après arrêt du flux sur erreur de transfert DMA.
+		 * Le port SPI doit être initialisé et libre (aucun transfert HAL en cours).
+		 **/
+		static HAL_StatusTypeDef start(void* rx, const void* tx, uint16_t halfFrames, bool wide16, Callback<size_t> on_half, Callback<> on_error, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			SPI_HandleTypeDef* hspi = HalSpiDriver::handle(port);
+			if (hspi == nullptr || halfFrames == 0 || halfFrames > 32767u)
+				return HAL_ERROR;
+			if (hspi->State != HAL_SPI_STATE_READY || m_active)
+				return HAL_BUSY;
+
+			HalRccDriver::enable(Base::ClockBit);
+			Rx::disable();
+			Tx::disable();
+
+			m_halfFrames = halfFrames;
+			m_lastHalf = 1u;
+			m_onHalf = on_half;
+			m_onError = on_error;
+
+			SPI_TypeDef* spi = hspi->Instance;
+			const uint32_t dataReg = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&spi->DR));
+			const uint32_t common = (Base::Channel << DMA_SxCR_CHSEL_Pos) | Base::SizeBits(wide16) | DMA_SxCR_MINC | DMA_SxCR_CIRC;
+
+			DMA_Stream_TypeDef* rxStream = Rx::Stream();
+			rxStream->PAR = dataReg;
+			rxStream->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(rx));
+			rxStream->NDTR = 2u * halfFrames;
+			rxStream->FCR = 0; // Mode direct
+			rxStream->CR = common
+				| Base::RxPriority
+				| DMA_SxCR_HTIE | DMA_SxCR_TCIE | DMA_SxCR_TEIE; // Périphérique -> mémoire
+
+			DMA_Stream_TypeDef* txStream = Tx::Stream();
+			txStream->PAR = dataReg;
+			txStream->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(tx));
+			txStream->NDTR = 2u * halfFrames;
+			txStream->FCR = 0;
+			txStream->CR = common
+				| Base::TxPriority
+				| DMA_SxCR_DIR_0 // Mémoire -> périphérique
+				| DMA_SxCR_TEIE;
+
+			Base::enable_irqs(preemptPriority, subPriority);
+
+			// RM0090 28.3.9 : RXDMAEN, streams, TXDMAEN, puis SPE
+			hspi->State = HAL_SPI_STATE_BUSY_TX_RX; // Les appels HAL bloquants / IT répondent HAL_BUSY
+			(void)spi->DR;
+			spi->CR2 = spi->CR2 | SPI_CR2_RXDMAEN;
+			rxStream->CR = rxStream->CR | DMA_SxCR_EN;
+			txStream->CR = txStream->CR | DMA_SxCR_EN;
+			spi->CR2 = spi->CR2 | SPI_CR2_TXDMAEN;
+			m_active = true;
+			spi->CR1 = spi->CR1 | SPI_CR1_SPE;
+			return HAL_OK;
+		}
+
+		/*
+		 * @brief Arrête le flux et rend le port à la HAL. La trame en cours se termine (BSY attendu).
+		 **/
+		static void stop() {
+			SPI_HandleTypeDef* hspi = HalSpiDriver::handle(port);
+			if (hspi == nullptr || !m_active)
+				return;
+			m_active = false;
+			SPI_TypeDef* spi = hspi->Instance;
+			spi->CR2 = spi->CR2 & ~static_cast<uint32_t>(SPI_CR2_TXDMAEN);
+			Tx::disable();
+			for (uint32_t guard = 0; (spi->SR & SPI_SR_BSY) && guard < 100000u; ++guard) {}
+			Rx::disable();
+			spi->CR2 = spi->CR2 & ~static_cast<uint32_t>(SPI_CR2_RXDMAEN);
+			spi->CR1 = spi->CR1 & ~static_cast<uint32_t>(SPI_CR1_SPE);
+			(void)spi->DR;
+			(void)spi->SR; // OVR effacé par lecture DR puis SR
+			hspi->State = HAL_SPI_STATE_READY;
+		}
+
+		/*
+		 * @brief ISR du stream de réception (SpiStreamDmaIrq<config>).
+		 * La moitié prête est déduite de NDTR et non des drapeaux : si HT et TC sont levés ensemble
+		 * (ISR en retard d'une moitié), seule la plus récente est signalée et l'écart est compté.
+		 **/
+		static inline void isr() {
+			const uint32_t rxFlags = Rx::flags();
+			Rx::clear_flags(rxFlags);
+			if (rxFlags & Rx::TransferError) {
+				fail();
+				return;
+			}
+			if (!(rxFlags & (Rx::HalfTransfer | Rx::TransferComplete)) || !m_active)
+				return;
+			const size_t ready = (Rx::Stream()->NDTR > m_halfFrames) ? 1u : 0u;
+			if (ready == m_lastHalf)
+				m_overruns = m_overruns + 1u;
+			m_lastHalf = ready;
+			m_onHalf(ready);
+		}
+
+		/*
+		 * @brief ISR du stream d'émission (SpiStreamDmaTxIrq<config>) : erreur de transfert seulement.
+		 **/
+		static inline void tx_isr() {
+			const uint32_t txFlags = Tx::flags();
+			Tx::clear_flags(txFlags);
+			if (txFlags & Tx::TransferError)
+				fail();
+		}
+
+		static bool active() {
+			return m_active;
+		}
+
+		// Moitiés non signalées à temps (traitement plus long qu'une demi-période)
+		static uint32_t overruns() {
+			return m_overruns;
+		}
+
+		// Arrêts sur erreur de transfert DMA (ex: tampon en CCM)
+		static uint32_t errors() {
+			return m_errors;
+		}
+
+	private:
+		static void fail() {
+			if (!m_active)
+				return;
+			stop();
+			m_errors = m_errors + 1u;
+			m_onError();
+		}
+
+		inline static volatile bool m_active = false;
+		inline static uint16_t m_halfFrames = 0;
+		inline static size_t m_lastHalf = 1u;
+		inline static volatile uint32_t m_overruns = 0;
+		inline static volatile uint32_t m_errors = 0;
+		inline static Callback<size_t> m_onHalf {};
+		inline static Callback<> m_onError {};
+	};
+
+} // namespace Hal
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstdint>
+#include "PwmEnumsStructs.hpp"
+#include "PwmDriver.hpp"
+#include "RccDriver.hpp"
+
+namespace Hal {
+
+	/*
+	 * @brief Timer utilisé comme base de temps périodique (interruption de mise à jour).
+	 * Le compteur tourne à 1 MHz : la période est exprimée en microsecondes.
+	 * Le vecteur est lié avec WRAPPER_BIND_IRQ(<vecteur>, Wrapper::TimerTickIrq<timer, &handler>).
+	 **/
+	template <PwmTimerInstance timer>
+	struct HalTickTimer {
+
+		static constexpr IRQn_Type UpdateIrq(PwmTimerInstance instance) {
+			switch (instance) {
+			case PwmTimerInstance::TIM_1:  return TIM1_UP_TIM10_IRQn;
+			case PwmTimerInstance::TIM_2:  return TIM2_IRQn;
+			case PwmTimerInstance::TIM_3:  return TIM3_IRQn;
+			case PwmTimerInstance::TIM_4:  return TIM4_IRQn;
+			case PwmTimerInstance::TIM_5:  return TIM5_IRQn;
+			case PwmTimerInstance::TIM_8:  return TIM8_UP_TIM13_IRQn;
+			case PwmTimerInstance::TIM_9:  return TIM1_BRK_TIM9_IRQn;
+			case PwmTimerInstance::TIM_10: return TIM1_UP_TIM10_IRQn;
+			case PwmTimerInstance::TIM_11: return TIM1_TRG_COM_TIM11_IRQn;
+			case PwmTimerInstance::TIM_12: return TIM8_BRK_TIM12_IRQn;
+			case PwmTimerInstance::TIM_13: return TIM8_UP_TIM13_IRQn;
+			case PwmTimerInstance::TIM_14: return TIM8_TRG_COM_TIM14_IRQn;
+			}
+			return TIM2_IRQn;
+		}
+
+		static constexpr IRQn_Type Irq = UpdateIrq(timer);
+		static constexpr bool Is32Bit = (timer == PwmTimerInstance::TIM_2 || timer == PwmTimerInstance::TIM_5);
+		static constexpr bool OnApb2 = (HalPwmDriver::ClockBit(timer).bus == RccBus::APB2);
+
+		/*
+		 * @Brief Horloge du timer : PCLKx, doublée quand le prescaler APB est différent de 1.
+		 **/
+		static inline uint32_t clock_hz() {
+			if constexpr (OnApb2)
+				return HAL_RCC_GetPCLK2Freq() * ((RCC->CFGR & RCC_CFGR_PPRE2_2) ? 2u : 1u);
+			else
+				return HAL_RCC_GetPCLK1Freq() * ((RCC->CFGR & RCC_CFGR_PPRE1_2) ? 2u : 1u);
+		}
+
+		template <uint32_t PeriodUs>
+		static void start(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			static_assert(PeriodUs > 0, "HalTickTimer : période nulle");
+			static_assert(Is32Bit || PeriodUs <= 0x10000u, "HalTickTimer : période trop longue pour un timer 16 bits");
+
+			HalRccDriver::enable(HalPwmDriver::ClockBit(timer));
+			TIM_TypeDef* tim = HalPwmDriver::MapTimerInstance(timer);
+			tim->CR1 = 0;
+			tim->PSC = clock_hz() / 1000000u - 1u;
+			tim->ARR = PeriodUs - 1u;
+			tim->EGR = TIM_EGR_UG;  // Charge PSC/ARR
+			tim->SR = 0;            // UG a levé UIF
+			tim->DIER = TIM_DIER_UIE;
+			tim->CR1 = TIM_CR1_CEN;
+
+			HAL_NVIC_SetPriority(Irq, preemptPriority, subPriority);
+			HAL_NVIC_EnableIRQ(Irq);
+		}
+
+		static inline void stop() {
+			HalPwmDriver::MapTimerInstance(timer)->CR1 = 0;
+		}
+
+		/*
+		 * @Brief Mode un coup (OPM) : configure le timer à 1 MHz sans le lancer.
+		 * arm() lance ensuite un délai unique, relançable : le compteur s'arrête seul à l'échéance.
+		 **/
+		static void init_one_shot(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalRccDriver::enable(HalPwmDriver::ClockBit(timer));
+			TIM_TypeDef* tim = HalPwmDriver::MapTimerInstance(timer);
+			tim->CR1 = TIM_CR1_OPM | TIM_CR1_URS; // URS : UG ne lève pas d'interruption
+			tim->PSC = clock_hz() / 1000000u - 1u;
+			tim->EGR = TIM_EGR_UG;
+			tim->SR = 0;
+			tim->DIER = TIM_DIER_UIE;
+
+			HAL_NVIC_SetPriority(Irq, preemptPriority, subPriority);
+			HAL_NVIC_EnableIRQ(Irq);
+		}
+
+		// (Re)lance un délai de delayUs (1..65536 sur un timer 16 bits) ; annule le délai en cours
+		static inline void arm(uint32_t delayUs) {
+			TIM_TypeDef* tim = HalPwmDriver::MapTimerInstance(timer);
+			tim->CR1 = TIM_CR1_OPM | TIM_CR1_URS;
+			tim->SR = ~static_cast<uint32_t>(TIM_SR_UIF);
+			tim->CNT = 0;
+			tim->ARR = delayUs - 1u;
+			tim->CR1 = TIM_CR1_OPM | TIM_CR1_URS | TIM_CR1_CEN;
+		}
+
+		static inline void disarm() {
+			TIM_TypeDef* tim = HalPwmDriver::MapTimerInstance(timer);
+			tim->CR1 = TIM_CR1_OPM | TIM_CR1_URS;
+			tim->SR = ~static_cast<uint32_t>(TIM_SR_UIF);
+		}
+
+		/*
+		 * @Brief Acquitte l'interruption de mise à jour ; faux si elle ne vient pas de ce timer (vecteur partagé).
+		 **/
+		static inline bool acknowledge() {
+			TIM_TypeDef* tim = HalPwmDriver::MapTimerInstance(timer);
+			if (!(tim->SR & TIM_SR_UIF))
+				return false;
+			tim->SR = ~static_cast<uint32_t>(TIM_SR_UIF);
+			return true;
+		}
+	};
+
+} // namespace Hal
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstdint>
+#include "CycleCounter.hpp"
+#include "PwmEnumsStructs.hpp"
+#include "PwmDriver.hpp"
+#include "RccDriver.hpp"
+
+namespace Hal {
+
+	/*
+	 * @brief Source d'horodatage basée sur DWT->CYCCNT (résolution HCLK, reboucle en ~25 s à 168 MHz).
+	 **/
+	struct HalDwtTimestamp {
+		static inline void start() {
+			if (!CycleCounter::is_enabled())
+				CycleCounter::enable();
+		}
+
+		static inline uint32_t now() {
+			return CycleCounter::now();
+		}
+	};
+
+	/*
+	 * @brief Source d'horodatage basée sur un timer 32 bits libre (TIM2 ou TIM5), compteur sans prescaler.
+	 * Utile quand le DWT est réservé au débogueur ou pour horodater dans le même domaine qu'une capture timer.
+	 **/
+	template <PwmTimerInstance timer>
+	struct HalTimerTimestamp {
+		static_assert(timer == PwmTimerInstance::TIM_2 || timer == PwmTimerInstance::TIM_5,
+			"HalTimerTimestamp : seuls TIM2 et TIM5 ont un compteur 32 bits");
+
+		static inline TIM_TypeDef* Regs() {
+			return (timer == PwmTimerInstance::TIM_2) ? TIM2 : TIM5;
+		}
+
+		static inline void start() {
+			HalRccDriver::enable(HalPwmDriver::ClockBit(timer));
+			TIM_TypeDef* tim = Regs();
+			tim->CR1 = 0;
+			tim->PSC = 0;
+			tim->ARR = 0xFFFFFFFFu;
+			tim->EGR = TIM_EGR_UG; // Charge PSC/ARR
+			tim->CR1 = TIM_CR1_CEN;
+		}
+
+		static inline uint32_t now() {
+			return Regs()->CNT;
+		}
+	};
+
+} // namespace Hal
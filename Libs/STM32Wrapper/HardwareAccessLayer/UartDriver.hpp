@@ -1,28 +1,45 @@
 // UartDriver.hpp
 #pragma once
 
-#include <vector>
+#include <array>
 #include <cstdint>
-#include <map>
-#include <functional>
 #include "IUartDriver.hpp"
+#include "RccDriver.hpp"
+#include "HandleRegistry.hpp"
+#include "Callback.hpp"
 
 namespace Hal {
 
-	struct HalUartDriver : public Hal::IUartDriver {
+	struct HalUartDriver {
 		
 		inline static constexpr int8_t handleEmpty = -1;
 		
-		inline static std::vector<UART_HandleTypeDef> uartHandles = { };
-		inline static std::map<USART_TypeDef*, std::function<void()>> tx_complete_callbacks = { };
-		inline static std::map<USART_TypeDef*, std::function<void()>> rx_complete_callbacks = { };
+		inline static constexpr size_t PortCount = 6;
+		
+		// Un handle statique par port : adresse fixe, index du handle == index du port
+		using Handles = HandleRegistry<UartPort, UART_HandleTypeDef, PortCount>;
+		
+		// Tables de dispatch indexées par port : accès O(1), sans allocation, utilisables en ISR.
+		inline static std::array<Callback<>, PortCount> tx_complete_callbacks = { };
+		inline static std::array<Callback<>, PortCount> rx_complete_callbacks = { };
+		// Réception DMA circulaire : position d'écriture (octets depuis le début du tampon) et erreurs
+		inline static std::array<Callback<uint16_t>, PortCount> rx_event_callbacks = { };
+		inline static std::array<Callback<>, PortCount> error_callbacks = { };
+		inline static std::array<DMA_HandleTypeDef, PortCount> rxDmaHandles = { };
 		
 		template<typename T>
 		int8_t init() {
-
 			enable_clock(T::Port);
-
-			UART_HandleTypeDef m_handle = {};
+			return init_peripheral<T>();
+		}
+		
+		/*
+		 * @Brief Initialise l'UART sans toucher à l'horloge (déjà activée, ex: par BoardInit).
+		 **/
+		template<typename T>
+		int8_t init_peripheral() {
+			UART_HandleTypeDef& m_handle = Handles::template at<T::Port>();
+			m_handle = {};
 			
 			// Configurer le handle UART
 			m_handle.Instance = MapPort(T::Port);
@@ -31,96 +48,223 @@ namespace Hal {
 			HAL_StatusTypeDef status = HAL_UART_Init(&m_handle);
         
 			if (status == HAL_OK) {
-				uartHandles.push_back(m_handle);
-				return uartHandles.size() - 1;
+				return handle_index(T::Port);
 			}
+			m_handle.Instance = nullptr;
 			return handleEmpty;
 		}
 		
+		static constexpr int8_t handle_index(UartPort port) {
+			return static_cast<int8_t>(PortIndex(port));
+		}
+		
 		static USART_TypeDef* uart_instance(int8_t handle_index) {
-			return uartHandles[handle_index].Instance;
+			return Handles::at(static_cast<size_t>(handle_index)).Instance;
+		}
+		
+		static UART_HandleTypeDef* handle(UartPort port) {
+			return Handles::is_initialized(port) ? &Handles::at(port) : nullptr;
 		}
 		
-		static void attach_callbacks(int8_t handle_index, std::function<void()> tx_cb, std::function<void()> rx_cb) {
-			USART_TypeDef* uart_instance = uartHandles[handle_index].Instance;
+		static void attach_callbacks(int8_t handle_index, Callback<> tx_cb, Callback<> rx_cb) {
+			const int8_t port = handle_index;
+			if (port < 0 || static_cast<size_t>(port) >= PortCount)
+				return;
 			if (tx_cb) {
-				tx_complete_callbacks[uart_instance] = std::move(tx_cb);
+				tx_complete_callbacks[port] = tx_cb;
 			}
 			if (rx_cb) {
-				rx_complete_callbacks[uart_instance] = std::move(rx_cb);
+				rx_complete_callbacks[port] = rx_cb;
 			}
 		}
 		
-		static void handle_tx_complete(UART_HandleTypeDef *huart) {
-			if (tx_complete_callbacks.count(huart->Instance)) {
-				tx_complete_callbacks[huart->Instance]();
+		// Appelées depuis les callbacks globaux HAL (HalCallbacks.cpp)
+		static inline void handle_tx_complete(UART_HandleTypeDef *huart) {
+			const int8_t port = Handles::index_of(huart);
+			if (port >= 0) {
+				tx_complete_callbacks[port]();
 			}
 		}
 
-		static void handle_rx_complete(UART_HandleTypeDef *huart) {
-			if (rx_complete_callbacks.count(huart->Instance)) {
-				rx_complete_callbacks[huart->Instance]();
+		static inline void handle_rx_complete(UART_HandleTypeDef *huart) {
+			const int8_t port = Handles::index_of(huart);
+			if (port >= 0) {
+				rx_complete_callbacks[port]();
 			}
 		}
 		
-		static void activate_IRQ(UartPort port) {
+		static inline void handle_rx_event(UART_HandleTypeDef *huart, uint16_t position) {
+			const int8_t port = Handles::index_of(huart);
+			if (port >= 0) {
+				rx_event_callbacks[port](position);
+			}
+		}
 
-			// Activer les IRQs
+		static inline void handle_error(UART_HandleTypeDef *huart) {
+			const int8_t port = Handles::index_of(huart);
+			if (port >= 0) {
+				error_callbacks[port]();
+			}
+		}
+		
+		/*
+		 * @brief Stream DMA de réception de chaque port (RM0090, tables 42/43).
+		 * @note USART6_RX (DMA2 Stream1) partage le stream de TIM8_UP (HalTimerGpioDma<TIM_8>).
+		 **/
+		struct DmaStream {
+			uint32_t base;
+			uint32_t channel;
 			IRQn_Type irq;
+			RccClockBit clock;
+		};
+		
+		static constexpr DmaStream RxDmaStream(UartPort port) {
+			constexpr RccClockBit dma1 { RccBus::AHB1, RCC_AHB1ENR_DMA1EN };
+			constexpr RccClockBit dma2 { RccBus::AHB1, RCC_AHB1ENR_DMA2EN };
 			switch (port) {
-				case UartPort::USART_1: irq = USART1_IRQn; break;
-				case UartPort::USART_2: irq = USART2_IRQn;  break;
-				case UartPort::USART_3: irq = USART3_IRQn;  break;
-				case UartPort::UART_4:  irq = UART4_IRQn;  break;
-				case UartPort::UART_5:  irq = UART5_IRQn;  break;
-				case UartPort::USART_6: irq = USART6_IRQn;  break;
+				case UartPort::USART_1: return { DMA2_Stream2_BASE, DMA_CHANNEL_4, DMA2_Stream2_IRQn, dma2 };
+				case UartPort::USART_2: return { DMA1_Stream5_BASE, DMA_CHANNEL_4, DMA1_Stream5_IRQn, dma1 };
+				case UartPort::USART_3: return { DMA1_Stream1_BASE, DMA_CHANNEL_4, DMA1_Stream1_IRQn, dma1 };
+				case UartPort::UART_4:  return { DMA1_Stream2_BASE, DMA_CHANNEL_4, DMA1_Stream2_IRQn, dma1 };
+				case UartPort::UART_5:  return { DMA1_Stream0_BASE, DMA_CHANNEL_4, DMA1_Stream0_IRQn, dma1 };
+				case UartPort::USART_6: return { DMA2_Stream1_BASE, DMA_CHANNEL_5, DMA2_Stream1_IRQn, dma2 };
 			}
+			return { DMA2_Stream2_BASE, DMA_CHANNEL_4, DMA2_Stream2_IRQn, dma2 };
+		}
+		
+		static DMA_HandleTypeDef* rx_dma_handle(UartPort port) {
+			return &rxDmaHandles[PortIndex(port)];
+		}
+		
+		/*
+		 * @brief Démarre la réception continue du port dans buffer (DMA circulaire + ligne inactive).
+		 * on_event reçoit la position d'écriture DMA (1..size) à mi-tampon, fin de tampon et ligne inactive ;
+		 * on_error est appelé si la HAL arrête la réception (erreur de transfert DMA).
+		 * Les erreurs de ligne (bruit, trame, overrun matériel) ne stoppent pas le flux : l'octet reçu est
+		 * transféré tel quel, la vérification est laissée au protocole (CRC...).
+		 * @note Le handle UART est relié au handle DMA ici : une nouvelle init du port défait ce lien.
+		 **/
+		static HAL_StatusTypeDef start_rx_dma(UartPort port, uint8_t* buffer, uint16_t size, Callback<uint16_t> on_event, Callback<> on_error, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			UART_HandleTypeDef* huart = handle(port);
+			if (huart == nullptr)
+				return HAL_ERROR;
+
+			const DmaStream stream = RxDmaStream(port);
+			HalRccDriver::enable(stream.clock);
+
+			DMA_HandleTypeDef* hdma = rx_dma_handle(port);
+			*hdma = {};
+			hdma->Instance                 = reinterpret_cast<DMA_Stream_TypeDef*>(stream.base);
+			hdma->Init.Channel             = stream.channel;
+			hdma->Init.Direction           = DMA_PERIPH_TO_MEMORY;
+			hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+			hdma->Init.MemInc              = DMA_MINC_ENABLE;
+			hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+			hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+			hdma->Init.Mode                = DMA_CIRCULAR;
+			hdma->Init.Priority            = DMA_PRIORITY_HIGH;
+			hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+			HAL_StatusTypeDef status = HAL_DMA_Init(hdma);
+			if (status != HAL_OK)
+				return status;
+			huart->hdmarx = hdma;
+			hdma->Parent = huart;
+
+			const size_t index = PortIndex(port);
+			rx_event_callbacks[index] = on_event;
+			error_callbacks[index] = on_error;
+
+			HAL_NVIC_SetPriority(stream.irq, preemptPriority, subPriority);
+			HAL_NVIC_EnableIRQ(stream.irq);
+			HAL_NVIC_SetPriority(Irq(port), preemptPriority, subPriority);
+			HAL_NVIC_EnableIRQ(Irq(port));
+
+			status = HAL_UARTEx_ReceiveToIdle_DMA(huart, buffer, size);
+			if (status == HAL_OK) {
+				// Erreurs de ligne non bloquantes : sans EIE/PEIE la HAL ne fait plus avorter le DMA
+				huart->Instance->CR3 = huart->Instance->CR3 & ~static_cast<uint32_t>(USART_CR3_EIE);
+				huart->Instance->CR1 = huart->Instance->CR1 & ~static_cast<uint32_t>(USART_CR1_PEIE);
+			}
+			return status;
+		}
+
+		static HAL_StatusTypeDef stop_rx_dma(UartPort port) {
+			UART_HandleTypeDef* huart = handle(port);
+			if (huart == nullptr)
+				return HAL_ERROR;
+			return HAL_UART_AbortReceive(huart);
+		}
+		
+		static constexpr size_t PortIndex(UartPort port) {
+			return static_cast<size_t>(port);
+		}
+		
+		static inline int8_t PortIndex(const USART_TypeDef* instance) {
+			if (instance == USART1) return 0;
+			if (instance == USART2) return 1;
+			if (instance == USART3) return 2;
+			if (instance == UART4)  return 3;
+			if (instance == UART5)  return 4;
+			if (instance == USART6) return 5;
+			return -1;
+		}
+		
+		static constexpr IRQn_Type Irq(UartPort port) {
+			switch (port) {
+				case UartPort::USART_1: return USART1_IRQn;
+				case UartPort::USART_2: return USART2_IRQn;
+				case UartPort::USART_3: return USART3_IRQn;
+				case UartPort::UART_4:  return UART4_IRQn;
+				case UartPort::UART_5:  return UART5_IRQn;
+				case UartPort::USART_6: return USART6_IRQn;
+			}
+			return USART1_IRQn;
+		}
+		
+		static void activate_IRQ(UartPort port) {
+
+			// Activer les IRQs
+			const IRQn_Type irq = Irq(port);
         
 			HAL_NVIC_SetPriority(irq, 0, 0);
 			HAL_NVIC_EnableIRQ(irq);
 		}
 		
-		HAL_StatusTypeDef transmit(int8_t handleIndex, const uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_UART_Transmit(&uartHandles[handleIndex], data, size, timeout);
+		HAL_StatusTypeDef transmit(int8_t handleIndex, const uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_UART_Transmit(&Handles::at(static_cast<size_t>(handleIndex)), data, size, timeout);
 		}
 
-		HAL_StatusTypeDef receive(int8_t handleIndex, uint8_t* data, uint16_t size, uint32_t timeout) override {
-			return HAL_UART_Receive(&uartHandles[handleIndex], data, size, timeout);
+		HAL_StatusTypeDef receive(int8_t handleIndex, uint8_t* data, uint16_t size, uint32_t timeout) {
+			return HAL_UART_Receive(&Handles::at(static_cast<size_t>(handleIndex)), data, size, timeout);
 		}
 
-		HAL_StatusTypeDef transmit_it(int8_t handleIndex, const uint8_t* data, uint16_t size) override {
-			return HAL_UART_Transmit_IT(&uartHandles[handleIndex], data, size);
+		HAL_StatusTypeDef transmit_it(int8_t handleIndex, const uint8_t* data, uint16_t size) {
+			return HAL_UART_Transmit_IT(&Handles::at(static_cast<size_t>(handleIndex)), data, size);
 		}
 
-		HAL_StatusTypeDef receive_it(int8_t handleIndex, uint8_t* data, uint16_t size) override {
-			return HAL_UART_Receive_IT(&uartHandles[handleIndex], data, size);
+		HAL_StatusTypeDef receive_it(int8_t handleIndex, uint8_t* data, uint16_t size) {
+			return HAL_UART_Receive_IT(&Handles::at(static_cast<size_t>(handleIndex)), data, size);
 		}
 		
 		static void enable_clock(UartPort port) {
-			if (is_enabled(port))
-				return;
-			
-			// Activer l'horloge de l'UART/USART
-			switch (port) {
-				case UartPort::USART_1: __HAL_RCC_USART1_CLK_ENABLE(); break;
-				case UartPort::USART_2: __HAL_RCC_USART2_CLK_ENABLE(); break;
-				case UartPort::USART_3: __HAL_RCC_USART3_CLK_ENABLE(); break;
-				case UartPort::UART_4:  __HAL_RCC_UART4_CLK_ENABLE(); break;
-				case UartPort::UART_5:  __HAL_RCC_UART5_CLK_ENABLE(); break;
-				case UartPort::USART_6: __HAL_RCC_USART6_CLK_ENABLE(); break;
-			}
+			HalRccDriver::enable(ClockBit(port));
 		}
 		
 		static bool is_enabled(UartPort port) {
+			return HalRccDriver::is_enabled(ClockBit(port));
+		}
+		
+		static constexpr RccClockBit ClockBit(UartPort port) {
 			switch (port) {
-				case UartPort::USART_1: return RCC->APB2ENR & RCC_APB2ENR_USART1EN;
-				case UartPort::USART_2: return RCC->APB1ENR & RCC_APB1ENR_USART2EN;
-				case UartPort::USART_3: return RCC->APB1ENR & RCC_APB1ENR_USART3EN;
-				case UartPort::UART_4:  return RCC->APB1ENR & RCC_APB1ENR_UART4EN;
-				case UartPort::UART_5:  return RCC->APB1ENR & RCC_APB1ENR_UART5EN;
-				case UartPort::USART_6: return RCC->APB2ENR & RCC_APB2ENR_USART6EN;
+				case UartPort::USART_1: return { RccBus::APB2, RCC_APB2ENR_USART1EN };
+				case UartPort::USART_2: return { RccBus::APB1, RCC_APB1ENR_USART2EN };
+				case UartPort::USART_3: return { RccBus::APB1, RCC_APB1ENR_USART3EN };
+				case UartPort::UART_4:  return { RccBus::APB1, RCC_APB1ENR_UART4EN };
+				case UartPort::UART_5:  return { RccBus::APB1, RCC_APB1ENR_UART5EN };
+				case UartPort::USART_6: return { RccBus::APB2, RCC_APB2ENR_USART6EN };
 			}
-			return false;
+			return { RccBus::APB1, 0 };
 		}
 		
 		static constexpr USART_TypeDef* MapPort(UartPort port) {
@@ -181,4 +325,6 @@ namespace Hal {
 		
 	};
 
+	static_assert(UartDriverConcept<HalUartDriver>, "HalUartDriver ne respecte pas UartDriverConcept");
+
 } // namespace Driver
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include "UartEnumsStructs.hpp"
+#include "UartDriver.hpp"
+#include "RccDriver.hpp"
+
+using namespace Wrapper;
+
+namespace Hal {
+
+	/*
+	 * @brief Stream DMA d'émission d'un port UART, piloté directement par registres.
+	 * Chaque start() charge un bloc ; relancé depuis l'ISR de fin de transfert, le bloc suivant part
+	 * pendant que TDR et le registre à décalage se vident encore : la ligne reste continue tant que la
+	 * latence d'ISR reste sous deux durées de caractère (~21 µs à 921600 bauds).
+	 * Correspondance (RM0090, tables 42/43) :
+	 *   USART1 DMA2 Stream7 ch4, USART2 DMA1 Stream6 ch4, USART3 DMA1 Stream3 ch4,
+	 *   UART4 DMA1 Stream4 ch4, UART5 DMA1 Stream7 ch4, USART6 DMA2 Stream6 ch5.
+	 * @note Les blocs doivent être en SRAM1/SRAM2 (la CCM n'est pas accessible par DMA).
+	 * @note DMAT reste actif : ne pas mélanger avec HAL_UART_Transmit_IT/DMA sur le même port.
+	 **/
+	template <UartPort port>
+	struct HalUartTxDma {
+		static constexpr bool OnDma2 = (port == UartPort::USART_1 || port == UartPort::USART_6);
+		static constexpr uint32_t StreamIndex = [] {
+			switch (port) {
+				case UartPort::USART_1: return 7u;
+				case UartPort::USART_2: return 6u;
+				case UartPort::USART_3: return 3u;
+				case UartPort::UART_4:  return 4u;
+				case UartPort::UART_5:  return 7u;
+				case UartPort::USART_6: return 6u;
+			}
+			return 7u;
+		}();
+		static constexpr uint32_t Channel = (port == UartPort::USART_6) ? 5u : 4u;
+		static constexpr IRQn_Type Irq = [] {
+			switch (port) {
+				case UartPort::USART_1: return DMA2_Stream7_IRQn;
+				case UartPort::USART_2: return DMA1_Stream6_IRQn;
+				case UartPort::USART_3: return DMA1_Stream3_IRQn;
+				case UartPort::UART_4:  return DMA1_Stream4_IRQn;
+				case UartPort::UART_5:  return DMA1_Stream7_IRQn;
+				case UartPort::USART_6: return DMA2_Stream6_IRQn;
+			}
+			return DMA2_Stream7_IRQn;
+		}();
+
+		// Streams 0..3 dans LISR, 4..7 dans HISR ; décalage des drapeaux dans le registre : 0, 6, 16, 22
+		static constexpr bool HighRegister = (StreamIndex >= 4);
+		static constexpr uint32_t FlagShift = (StreamIndex % 4 == 0) ? 0u : (StreamIndex % 4 == 1) ? 6u : (StreamIndex % 4 == 2) ? 16u : 22u;
+		static constexpr uint32_t AllFlags = 0x3Du << FlagShift;
+		static constexpr uint32_t TransferComplete = DMA_LISR_TCIF0 << FlagShift;
+		static constexpr uint32_t TransferError = DMA_LISR_TEIF0 << FlagShift;
+
+		static constexpr RccClockBit ClockBit = OnDma2
+			? RccClockBit { RccBus::AHB1, RCC_AHB1ENR_DMA2EN }
+			: RccClockBit { RccBus::AHB1, RCC_AHB1ENR_DMA1EN };
+
+		static inline DMA_TypeDef* Controller() {
+			return OnDma2 ? DMA2 : DMA1;
+		}
+
+		static inline DMA_Stream_TypeDef* Stream() {
+			const uint32_t base = OnDma2 ? DMA2_Stream0_BASE : DMA1_Stream0_BASE;
+			return reinterpret_cast<DMA_Stream_TypeDef*>(base + StreamIndex * 0x18u);
+		}
+
+		static inline uint32_t flags() {
+			return HighRegister ? Controller()->HISR : Controller()->LISR;
+		}
+
+		static inline void clear_flags(uint32_t mask) {
+			if constexpr (HighRegister)
+				Controller()->HIFCR = mask;
+			else
+				Controller()->LIFCR = mask;
+		}
+
+		/*
+		 * @brief Active l'horloge DMA, attache le stream à USARTx->DR et active les requêtes DMA d'émission.
+		 * Le port UART doit déjà être initialisé.
+		 **/
+		static void init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalRccDriver::enable(ClockBit);
+
+			DMA_Stream_TypeDef* stream = Stream();
+			stream->CR = 0;
+			while (stream->CR & DMA_SxCR_EN) {}
+			USART_TypeDef* usart = HalUartDriver::MapPort(port);
+			stream->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&usart->DR));
+			stream->FCR = 0; // Mode direct
+			clear_flags(AllFlags);
+
+			HAL_NVIC_SetPriority(Irq, preemptPriority, subPriority);
+			HAL_NVIC_EnableIRQ(Irq);
+
+			usart->CR3 = usart->CR3 | USART_CR3_DMAT;
+		}
+
+		/*
+		 * @brief Émet size octets (1..65535) ; TC est signalé quand le DMA a lu le dernier octet.
+		 * Le drapeau TC de l'USART est effacé (RM0090 30.3.13) : il ne remonte qu'une fois ce bloc sorti.
+		 **/
+		static inline void start(const uint8_t* data, uint16_t size) {
+			DMA_Stream_TypeDef* stream = Stream();
+			clear_flags(AllFlags);
+			HalUartDriver::MapPort(port)->SR = ~static_cast<uint32_t>(USART_SR_TC);
+			stream->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data));
+			stream->NDTR = size;
+			stream->CR = (Channel << DMA_SxCR_CHSEL_Pos)
+				| DMA_SxCR_PL_0      // Priorité moyenne
+				| DMA_SxCR_MINC
+				| DMA_SxCR_DIR_0     // Mémoire -> périphérique, octets
+				| DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+			stream->CR = stream->CR | DMA_SxCR_EN;
+		}
+
+		static void stop() {
+			DMA_Stream_TypeDef* stream = Stream();
+			stream->CR = stream->CR & ~DMA_SxCR_EN;
+			while (stream->CR & DMA_SxCR_EN) {}
+			clear_flags(AllFlags);
+		}
+	};
+
+} // namespace Hal
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include "PwmEnumsStructs.hpp"
+#include "PwmDriver.hpp"
+#include "RccDriver.hpp"
+#include "TickTimerDriver.hpp"
+
+namespace Hal {
+
+	/*
+	 * @brief Flux DMA cadencé par l'événement de mise à jour d'un timer, écrivant des mots 32 bits
+	 * dans un registre périphérique (typiquement GPIOx->BSRR).
+	 * Sur le F407, seul DMA2 a accès au bus AHB1 des GPIO : seules les requêtes TIM1_UP (DMA2 Stream5,
+	 * canal 6) et TIM8_UP (DMA2 Stream1, canal 7) conviennent.
+	 * @note Le tampon doit être en SRAM1/SRAM2 (la CCM n'est pas accessible par DMA).
+	 **/
+	template <PwmTimerInstance timer>
+	struct HalTimerGpioDma {
+		static_assert(timer == PwmTimerInstance::TIM_1 || timer == PwmTimerInstance::TIM_8,
+			"HalTimerGpioDma : seules les requêtes TIM1_UP et TIM8_UP sont routées vers DMA2");
+
+		static constexpr bool IsTim1 = (timer == PwmTimerInstance::TIM_1);
+		static constexpr IRQn_Type Irq = IsTim1 ? DMA2_Stream5_IRQn : DMA2_Stream1_IRQn;
+		static constexpr uint32_t Channel = IsTim1 ? 6u : 7u;
+		static constexpr uint32_t FlagShift = 6u; // Stream1 (LISR) et Stream5 (HISR) : bits 6..11
+		static constexpr uint32_t AllFlags = 0x3Du << FlagShift;
+		static constexpr uint32_t TransferComplete = DMA_LISR_TCIF1; // == DMA_HISR_TCIF5
+		static constexpr uint32_t HalfTransfer = DMA_LISR_HTIF1;     // == DMA_HISR_HTIF5
+		static constexpr uint32_t TransferError = DMA_LISR_TEIF1;    // == DMA_HISR_TEIF5
+
+		static inline DMA_Stream_TypeDef* Stream() {
+			return IsTim1 ? DMA2_Stream5 : DMA2_Stream1;
+		}
+
+		static inline TIM_TypeDef* Timer() {
+			return HalPwmDriver::MapTimerInstance(timer);
+		}
+
+		static inline uint32_t flags() {
+			return IsTim1 ? DMA2->HISR : DMA2->LISR;
+		}
+
+		static inline void clear_flags(uint32_t mask) {
+			if constexpr (IsTim1)
+				DMA2->HIFCR = mask;
+			else
+				DMA2->LIFCR = mask;
+		}
+
+		/*
+		 * @brief Active les horloges DMA2 et timer, prépare le timer (arrêté) à la cadence demandée
+		 * et attache le stream au registre de destination.
+		 **/
+		static void init(volatile uint32_t* destination, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalRccDriver::enable(RccClockBit { RccBus::AHB1, RCC_AHB1ENR_DMA2EN });
+			HalRccDriver::enable(HalPwmDriver::ClockBit(timer));
+
+			TIM_TypeDef* tim = Timer();
+			tim->CR1 = 0;
+			tim->DIER = 0;
+			tim->PSC = 0;
+			tim->RCR = 0; // Une requête par débordement
+
+			DMA_Stream_TypeDef* stream = Stream();
+			stream->CR = 0;
+			while (stream->CR & DMA_SxCR_EN) {}
+			stream->PAR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(destination));
+			stream->FCR = 0; // Mode direct
+			clear_flags(AllFlags);
+
+			HAL_NVIC_SetPriority(Irq, preemptPriority, subPriority);
+			HAL_NVIC_EnableIRQ(Irq);
+		}
+
+		/*
+		 * @brief PSC / ARR (16 bits chacun) pour une mise à jour à sampleRateHz : le prescaler le plus petit
+		 * qui fait tenir la période dans ARR, donc la meilleure résolution (168 MHz : PSC = 0 jusqu'à ~2,6 kHz).
+		 * @return false si la cadence est nulle ou au-delà de la moitié de l'horloge timer.
+		 **/
+		static bool timing(uint32_t sampleRateHz, uint32_t& psc, uint32_t& arr) {
+			const uint32_t clock = HalTickTimer<timer>::clock_hz();
+			if (sampleRateHz == 0 || sampleRateHz > clock / 2u)
+				return false;
+			const uint32_t ticks = static_cast<uint32_t>((uint64_t(clock) + sampleRateHz / 2u) / sampleRateHz);
+			psc = (ticks - 1u) / 0x10000u;
+			arr = (ticks + psc / 2u) / (psc + 1u) - 1u;
+			return true;
+		}
+
+		/*
+		 * @brief Lance la lecture de count mots, un mot par période timer (sampleRateHz).
+		 * Le premier mot est écrit à la première mise à jour, une période après le départ.
+		 * En mode circulaire, HT et TC sont signalés à chaque tour (double tampon).
+		 * @return false (rien n'est lancé) si sampleRateHz est hors limites, voir timing().
+		 **/
+		static bool start(const uint32_t* words, uint16_t count, uint32_t sampleRateHz, bool circular) {
+			uint32_t psc = 0;
+			uint32_t arr = 0;
+			if (!timing(sampleRateHz, psc, arr))
+				return false;
+			TIM_TypeDef* tim = Timer();
+			tim->CR1 = 0;
+			tim->DIER = 0;
+			tim->PSC = psc;
+			tim->ARR = arr;
+			tim->CNT = 0;
+			tim->EGR = TIM_EGR_UG; // Charge PSC / ARR sans requête DMA (UDE encore à 0)
+			tim->SR = 0;
+
+			DMA_Stream_TypeDef* stream = Stream();
+			clear_flags(AllFlags);
+			stream->M0AR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(words));
+			stream->NDTR = count;
+			stream->CR = (Channel << DMA_SxCR_CHSEL_Pos)
+				| DMA_SxCR_PL_1                       // Priorité haute
+				| DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 // Mots 32 bits
+				| DMA_SxCR_MINC
+				| DMA_SxCR_DIR_0                      // Mémoire -> périphérique
+				| (circular ? (DMA_SxCR_CIRC | DMA_SxCR_HTIE) : 0u)
+				| DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+			stream->CR = stream->CR | DMA_SxCR_EN;
+
+			tim->DIER = TIM_DIER_UDE;
+			tim->CR1 = TIM_CR1_CEN;
+			return true;
+		}
+
+		/*
+		 * @brief Arrête le timer puis le stream. Les broches gardent le dernier niveau écrit.
+		 **/
+		static void stop() {
+			TIM_TypeDef* tim = Timer();
+			tim->CR1 = 0;
+			tim->DIER = 0;
+			DMA_Stream_TypeDef* stream = Stream();
+			stream->CR = stream->CR & ~DMA_SxCR_EN;
+			while (stream->CR & DMA_SxCR_EN) {}
+			clear_flags(AllFlags);
+		}
+
+		// Nombre de mots restant à transférer dans le tour courant
+		static inline uint16_t remaining() {
+			return static_cast<uint16_t>(Stream()->NDTR);
+		}
+	};
+
+} // namespace Hal
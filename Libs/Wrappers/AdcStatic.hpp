@@ -10,7 +10,7 @@ using namespace WrapperBase;
 
 namespace Wrapper {
 
-	template<AdcConfigPolicy config, typename Driver = HalAdcDriver>
+	template<AdcConfigPolicy config, AdcDriverConcept Driver = HalAdcDriver>
 		class AdcStatic {
 		public:
 			AdcStatic() = default;
@@ -35,7 +35,7 @@ namespace Wrapper {
 			// On pourrait ajouter attach_interrupt() ici si on gérait les IT
         
 		private:
-			Driver driver;
+			[[no_unique_address]] Driver driver;
 		};
 
 } //namespace Wrapper
\ No newline at end of file
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "UartConfigPolicy.hpp"
+#include "SpiConfigPolicy.hpp"
+#include "I2cConfigPolicy.hpp"
+#include "PwmConfigPolicy.hpp"
+#include "GpioDriver.hpp"
+#include "GpioPinSet.hpp"
+#include "PwmDriver.hpp"
+#include "RccDriver.hpp"
+#ifdef HAL_UART_MODULE_ENABLED
+#include "UartDriver.hpp"
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+#include "SpiDriver.hpp"
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+#include "I2cDriver.hpp"
+#endif
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Description d'une broche extraite d'une politique (Gpio, Uart, Spi, I2c ou Pwm).
+	 **/
+	struct BoardPinDesc {
+		GpioPort port;
+		uint8_t pin;
+		GpioPinMode mode;
+		GpioPullMode pull;
+		GpioPinSpeed speed;
+		GpioInterruptEdge interrupt;
+		GpioAlternateFunctionType af;
+
+		constexpr bool same_pin(const BoardPinDesc& other) const {
+			return port == other.port && pin == other.pin;
+		}
+
+		constexpr bool same_config(const BoardPinDesc& other) const {
+			return mode == other.mode && pull == other.pull && speed == other.speed
+				&& interrupt == other.interrupt && af == other.af;
+		}
+	};
+
+	namespace Detail {
+
+		template <typename>
+		inline constexpr bool AlwaysFalse = false;
+
+		template <GpioConfigPolicy P>
+		constexpr BoardPinDesc DescribePin() {
+			return { P::Port, P::Pin, P::Mode, P::Pull, P::Speed, P::Interrupt, P::GpioAF };
+		}
+
+		/*
+		 * @brief Broches utilisées par une politique, quel que soit son type.
+		 **/
+		template <typename P>
+		constexpr auto PinsOf() {
+			if constexpr (GpioConfigPolicy<P>)
+				return std::array<BoardPinDesc, 1> { DescribePin<P>() };
+			else if constexpr (UartConfigPolicy<P>)
+				return std::array<BoardPinDesc, 2> { DescribePin<typename P::TxPin>(), DescribePin<typename P::RxPin>() };
+			else if constexpr (SpiConfigPolicy<P>) {
+				if constexpr (std::is_void_v<typename P::NssPin>)
+					return std::array<BoardPinDesc, 3> { DescribePin<typename P::SckPin>(), DescribePin<typename P::MisoPin>(),
+						DescribePin<typename P::MosiPin>() };
+				else
+					return std::array<BoardPinDesc, 4> { DescribePin<typename P::SckPin>(), DescribePin<typename P::MisoPin>(),
+						DescribePin<typename P::MosiPin>(), DescribePin<typename P::NssPin>() };
+			}
+			else if constexpr (I2cConfigPolicy<P>)
+				return std::array<BoardPinDesc, 2> { DescribePin<typename P::SclPin>(), DescribePin<typename P::SdaPin>() };
+			else if constexpr (PwmConfigPolicy<P>)
+				return std::array<BoardPinDesc, 1> { DescribePin<typename P::GpioPolicy>() };
+			else
+				static_assert(AlwaysFalse<P>, "BoardInit : politique non reconnue (Gpio, Uart, Spi, I2c ou Pwm attendue)");
+		}
+
+		/*
+		 * @brief Horloge propre au périphérique (les horloges de ports sont déduites des broches).
+		 **/
+		template <typename P>
+		constexpr RccEnableMasks PeripheralClockOf() {
+			RccEnableMasks masks {};
+			if constexpr (UartConfigPolicy<P>) {
+#ifdef HAL_UART_MODULE_ENABLED
+				masks.add(HalUartDriver::ClockBit(P::Port));
+#else
+				static_assert(AlwaysFalse<P>, "BoardInit : HAL_UART_MODULE_ENABLED requis pour une politique Uart");
+#endif
+			}
+			else if constexpr (SpiConfigPolicy<P>) {
+#ifdef HAL_SPI_MODULE_ENABLED
+				masks.add(HalSpiDriver::ClockBit(P::Port));
+#else
+				static_assert(AlwaysFalse<P>, "BoardInit : HAL_SPI_MODULE_ENABLED requis pour une politique Spi");
+#endif
+			}
+			else if constexpr (I2cConfigPolicy<P>) {
+#ifdef HAL_I2C_MODULE_ENABLED
+				masks.add(HalI2cDriver::ClockBit(P::Port));
+#else
+				static_assert(AlwaysFalse<P>, "BoardInit : HAL_I2C_MODULE_ENABLED requis pour une politique I2c");
+#endif
+			}
+			else if constexpr (PwmConfigPolicy<P>)
+				masks.add(HalPwmDriver::ClockBit(P::Timer));
+			return masks;
+		}
+
+		template <typename... P>
+		constexpr RccEnableMasks PeripheralClocks() {
+			RccEnableMasks masks {};
+			(masks.add(PeripheralClockOf<P>()), ...);
+			return masks;
+		}
+
+		template <size_t... N>
+		constexpr auto ConcatPins(const std::array<BoardPinDesc, N>&... parts) {
+			std::array<BoardPinDesc, (N + ... + 0)> all {};
+			size_t i = 0;
+			((std::copy(parts.begin(), parts.end(), all.begin() + i), i += N), ...);
+			return all;
+		}
+
+		// Une broche partagée par plusieurs politiques doit avoir la même configuration partout.
+		template <size_t N>
+		constexpr bool PinsConsistent(const std::array<BoardPinDesc, N>& pins) {
+			for (size_t i = 0; i < N; ++i)
+				for (size_t j = i + 1; j < N; ++j)
+					if (pins[i].same_pin(pins[j]) && !pins[i].same_config(pins[j]))
+						return false;
+			return true;
+		}
+
+		// Une ligne EXTI n'est reliée qu'à un seul port : PA0 et PB0 ne peuvent pas tous deux interrompre.
+		template <size_t N>
+		constexpr bool ExtiLinesDistinct(const std::array<BoardPinDesc, N>& pins) {
+			for (size_t i = 0; i < N; ++i)
+				for (size_t j = i + 1; j < N; ++j)
+					if (pins[i].interrupt != GpioInterruptEdge::None && pins[j].interrupt != GpioInterruptEdge::None
+						&& pins[i].pin == pins[j].pin && pins[i].port != pins[j].port)
+						return false;
+			return true;
+		}
+
+		template <size_t N>
+		constexpr std::array<GpioPortSetup, GpioPortCount> MakePortSetups(const std::array<BoardPinDesc, N>& pins) {
+			std::array<GpioPortSetup, GpioPortCount> setups {};
+			for (const BoardPinDesc& p : pins) {
+				GpioPortSetup& s = setups[PortIndex(p.port)];
+				const uint32_t pos2 = p.pin * 2u;
+				// En mode interruption, la broche est une entrée (cf. HalGpioDriver::getHALConfig)
+				const uint32_t halMode = (p.interrupt != GpioInterruptEdge::None)
+					? GPIO_MODE_INPUT : HalGpioDriver::MapPinMode(p.mode);
+				const uint32_t moder = halMode & GPIO_MODE;
+
+				if (moder == MODE_OUTPUT || moder == MODE_AF) {
+					s.ospeedrMask |= 0x3u << pos2;
+					s.ospeedr = (s.ospeedr & ~(0x3u << pos2)) | (HalGpioDriver::MapSpeed(p.speed) << pos2);
+					s.otyperMask |= 0x1u << p.pin;
+					s.otyper = (s.otyper & ~(0x1u << p.pin)) | (((halMode & OUTPUT_TYPE) >> OUTPUT_TYPE_Pos) << p.pin);
+				}
+				if (moder != MODE_ANALOG) {
+					s.pupdrMask |= 0x3u << pos2;
+					s.pupdr = (s.pupdr & ~(0x3u << pos2)) | (HalGpioDriver::MapPull(p.pull) << pos2);
+				}
+				if (moder == MODE_AF) {
+					const uint32_t reg = p.pin >> 3u;
+					const uint32_t pos4 = (p.pin & 0x7u) * 4u;
+					s.afrMask[reg] |= 0xFu << pos4;
+					s.afr[reg] = (s.afr[reg] & ~(0xFu << pos4)) | (HalGpioDriver::MapAlternateFunction(p.af) << pos4);
+				}
+				s.moderMask |= 0x3u << pos2;
+				s.moder = (s.moder & ~(0x3u << pos2)) | (moder << pos2);
+			}
+			return setups;
+		}
+
+		template <size_t N>
+		constexpr GpioExtiSetup MakeExtiSetup(const std::array<BoardPinDesc, N>& pins) {
+			GpioExtiSetup exti {};
+			for (const BoardPinDesc& p : pins) {
+				if (p.interrupt == GpioInterruptEdge::None)
+					continue;
+				const uint32_t line = 1u << p.pin;
+				const uint32_t pos4 = (p.pin & 0x3u) * 4u;
+				exti.exticrMask[p.pin >> 2u] |= 0xFu << pos4;
+				exti.exticr[p.pin >> 2u] |= static_cast<uint32_t>(PortIndex(p.port)) << pos4;
+				exti.lines |= line;
+				if (p.interrupt == GpioInterruptEdge::Rising || p.interrupt == GpioInterruptEdge::RisingFalling)
+					exti.rising |= line;
+				if (p.interrupt == GpioInterruptEdge::Falling || p.interrupt == GpioInterruptEdge::RisingFalling)
+					exti.falling |= line;
+			}
+			return exti;
+		}
+
+		template <size_t N>
+		constexpr RccEnableMasks MakeClocks(const std::array<BoardPinDesc, N>& pins, RccEnableMasks peripherals, bool exti) {
+			RccEnableMasks masks = peripherals;
+			for (const BoardPinDesc& p : pins)
+				masks.add(HalGpioDriver::ClockBit(p.port));
+			if (exti)
+				masks.add(HalGpioDriver::SyscfgClockBit());
+			return masks;
+		}
+	}
+
+	/*
+	 * @brief Initialisation groupée de la carte à partir de toutes les politiques du firmware.
+	 * Tout est calculé à la compilation :
+	 *  - les horloges (ports GPIO, périphériques, SYSCFG si EXTI) sont activées avec un seul store par registre RCC ENR,
+	 *  - les broches d'un même port sont configurées avec un seul read-modify-write par registre
+	 *    (OSPEEDR, OTYPER, PUPDR, AFR puis MODER),
+	 *  - les lignes EXTI sont configurées en une passe.
+	 * Les périphériques s'initialisent ensuite via init_peripheral(), qui ne retouche ni horloges ni broches.
+	 * @note Les vecteurs NVIC restent activés par attach_interrupt().
+	 *
+	 * Exemple :
+	 *   using Board = BoardInit<LedConfig, ButtonConfig, Uart2Config, Spi1Config, Pwm3Config>;
+	 *   Board::init();
+	 *   uart.init_peripheral(); spi.init_peripheral(); pwm.init_peripheral();
+	 **/
+	template <typename... Policies>
+	struct BoardInit {
+		static_assert(sizeof...(Policies) > 0, "BoardInit attend au moins une politique");
+
+		static constexpr auto Pins = Detail::ConcatPins(Detail::PinsOf<Policies>()...);
+		static_assert(Detail::PinsConsistent(Pins), "BoardInit : une broche est utilisée avec deux configurations différentes");
+		static_assert(Detail::ExtiLinesDistinct(Pins), "BoardInit : deux broches de ports différents partagent la même ligne EXTI");
+
+		static constexpr std::array<GpioPortSetup, GpioPortCount> PortSetups = Detail::MakePortSetups(Pins);
+		static constexpr GpioExtiSetup Exti = Detail::MakeExtiSetup(Pins);
+		static constexpr RccEnableMasks Clocks = Detail::MakeClocks(Pins,
+			Detail::PeripheralClocks<Policies...>(), !Exti.empty());
+
+		static void init() {
+			HalRccDriver::enable(Clocks);
+			configure_ports(std::make_index_sequence<GpioPortCount> {});
+			if constexpr (!Exti.empty())
+				HalGpioDriver::configure_exti(Exti);
+		}
+
+	private:
+		template <size_t... P>
+		static inline void configure_ports(std::index_sequence<P...>) {
+			(configure_port<P>(), ...);
+		}
+
+		template <size_t P>
+		static inline void configure_port() {
+			if constexpr (!PortSetups[P].empty())
+				HalGpioDriver::configure_direct<static_cast<GpioPort>(P)>(PortSetups[P]);
+		}
+	};
+
+} // namespace Wrapper
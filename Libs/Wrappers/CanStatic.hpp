@@ -10,7 +10,7 @@ using namespace WrapperBase;
 
 namespace Wrapper {
 
-    template<CanConfigPolicy config, typename Driver = HalCanDriver>
+    template<CanConfigPolicy config, CanDriverConcept Driver = HalCanDriver>
     class CanStatic {
     public:
         CanStatic() = default;
@@ -21,7 +21,7 @@ namespace Wrapper {
             driver.template config_filter<config>();
             
             // Démarrer le périphérique CAN
-            HAL_CAN_Start(&Driver::canHandles[config::Port]);
+            HAL_CAN_Start(Driver::handle(config::Port));
         }
         
         /// @brief Envoie un message CAN.
@@ -34,7 +34,7 @@ namespace Wrapper {
         }
         
         /// @brief Attache un callback à l'interruption de réception (pour le message filtré).
-        void attach_rx_callback(std::function<void(const CanMessage&)> cb) {
+        void attach_rx_callback(Callback<const CanMessage&> cb) {
             if constexpr (config::CanReceive && config::UseInterrupt) {
                 driver.attach_rx_interrupt(config::Port, config::FilterConfig.Fifo, cb);
             }
@@ -43,7 +43,7 @@ namespace Wrapper {
         // On peut ajouter une méthode pour lire l'état du bus, le nombre d'erreurs, etc.
 
     private:
-        Driver driver;
+        [[no_unique_address]] Driver driver;
     };
 
 } //namespace Wrapper
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Wrapper {
+
+	/*
+	 * @brief COBS (Consistent Overhead Byte Stuffing) : supprime les 0x00 d'un bloc pour que 0x00 serve
+	 * de délimiteur de trame. Surcoût : 1 octet + 1 par tranche de 254 octets.
+	 * Le décodage se fait en place (la sortie n'est jamais plus longue que l'entrée, et l'écriture ne
+	 * dépasse jamais la lecture), directement dans le tampon de réception.
+	 **/
+	struct Cobs {
+		static constexpr size_t Error = static_cast<size_t>(-1);
+
+		static constexpr size_t max_encoded_size(size_t size) {
+			return size + size / 254 + 1;
+		}
+
+		/*
+		 * @brief Encodeur incrémental : plusieurs blocs (ex: charge utile puis CRC) encodés comme un seul,
+		 * sans les recopier dans un tampon intermédiaire.
+		 **/
+		class Encoder {
+		public:
+			explicit Encoder(std::span<uint8_t> dst) : m_dst(dst), m_ok(!dst.empty()) {}
+
+			void append(std::span<const uint8_t> src) {
+				for (const uint8_t byte : src) {
+					if (byte != 0) {
+						put(byte);
+						++m_code;
+					}
+					if (byte == 0 || m_code == 0xFF) {
+						close_block();
+						m_codeIndex = m_write;
+						put(0); // Réservé au code du bloc suivant
+						m_code = 1;
+					}
+				}
+			}
+
+			// @return taille encodée (sans délimiteur), Error si dst est trop petit
+			size_t finish() {
+				close_block();
+				return m_ok ? m_write : Error;
+			}
+
+		private:
+			void put(uint8_t byte) {
+				if (m_write < m_dst.size())
+					m_dst[m_write] = byte;
+				else
+					m_ok = false;
+				++m_write;
+			}
+
+			void close_block() {
+				if (m_codeIndex < m_dst.size())
+					m_dst[m_codeIndex] = m_code;
+			}
+
+			std::span<uint8_t> m_dst;
+			size_t m_codeIndex = 0;
+			size_t m_write = 1;
+			uint8_t m_code = 1;
+			bool m_ok;
+		};
+
+		/*
+		 * @brief Encode src dans dst (au moins max_encoded_size(src.size()) octets), sans délimiteur.
+		 * @return taille encodée, Error si dst est trop petit.
+		 **/
+		static size_t encode(std::span<const uint8_t> src, std::span<uint8_t> dst) {
+			Encoder encoder(dst);
+			encoder.append(src);
+			return encoder.finish();
+		}
+
+		/*
+		 * @brief Décode en place un bloc encodé (sans son délimiteur).
+		 * @return taille décodée, Error si le bloc est mal formé (0x00 ou code dépassant le bloc).
+		 **/
+		static size_t decode(std::span<uint8_t> frame) {
+			const size_t size = frame.size();
+			size_t read = 0;
+			size_t write = 0;
+			while (read < size) {
+				const uint8_t code = frame[read++];
+				if (code == 0 || read + code - 1 > size)
+					return Error;
+				for (uint8_t i = 1; i < code; ++i) {
+					const uint8_t byte = frame[read++];
+					if (byte == 0)
+						return Error;
+					frame[write++] = byte;
+				}
+				if (code != 0xFF && read < size)
+					frame[write++] = 0;
+			}
+			return write;
+		}
+	};
+
+} // namespace Wrapper
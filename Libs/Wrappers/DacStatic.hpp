@@ -10,7 +10,7 @@ using namespace WrapperBase;
 
 namespace Wrapper {
 
-    template<DacConfigPolicy config, typename Driver = HalDacDriver>
+    template<DacConfigPolicy config, DacDriverConcept Driver = HalDacDriver>
     class DacStatic {
     public:
         DacStatic() = default;
@@ -34,7 +34,7 @@ namespace Wrapper {
         }
         
     private:
-        Driver driver;
+        [[no_unique_address]] Driver driver;
     };
 
 } //namespace Wrapper
\ No newline at end of file
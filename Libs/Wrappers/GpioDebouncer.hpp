@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "GpioDriver.hpp"
+#include "GpioStatic.hpp"
+#include "GpioPinSet.hpp"
+#include "Callback.hpp"
+#include "TickTimerDriver.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Anti-rebond par compteurs verticaux sur des ports entiers.
+	 * À chaque tick, IDR est lu une seule fois par port et un compteur 2 bits par broche (bits répartis
+	 * sur deux mots : cnt0/cnt1) avance pour toutes les broches en parallèle, en quelques opérations logiques.
+	 * Une broche ne change d'état qu'après SampleCount échantillons consécutifs différents de l'état courant ;
+	 * tout retour à l'état stable remet son compteur à zéro.
+	 *
+	 * Le bit i des valeurs (state(), changements) correspond à la i-ème broche de la liste, comme GpioGroup.
+	 *
+	 * @tparam SamplePeriodUs Période d'échantillonnage, fixée à la compilation
+	 * @tparam Pins           Broches en entrée (sans interruption EXTI)
+	 *
+	 * Exemple (TIM13, vecteur partagé TIM8_UP_TIM13) :
+	 *   using Panel = GpioDebouncer<2000, Key0, Key1, Key2, DoorContact>;
+	 *   WRAPPER_BIND_IRQ(TIM8_UP_TIM13, TimerTickIrq<PwmTimerInstance::TIM_13, &Panel::sample>)
+	 *   Panel::init();
+	 *   Panel::start<PwmTimerInstance::TIM_13>();
+	 *   uint32_t changed = Panel::take_changes();
+	 **/
+	template <uint32_t SamplePeriodUs, GpioConfigPolicy... Pins>
+	class GpioDebouncer {
+		static_assert(((Pins::Mode == GpioPinMode::Input) && ...), "GpioDebouncer : toutes les broches doivent être en entrée");
+		static_assert(((Pins::Interrupt == GpioInterruptEdge::None) && ...), "GpioDebouncer : les broches sont échantillonnées, pas d'EXTI");
+
+	public:
+		using PinSet = GpioPinSet<Pins...>;
+		static constexpr uint32_t SampleCount = 4; // Compteur vertical 2 bits
+		static constexpr uint32_t SettleTimeUs = SamplePeriodUs * SampleCount;
+
+		/*
+		 * @brief Configure les broches et initialise l'état filtré avec le niveau courant (aucun changement signalé).
+		 **/
+		static void init() {
+			(GpioStatic<Pins> {}.init(), ...);
+			preload(std::make_index_sequence<GpioPortCount> {});
+			m_state.store(to_value(std::make_index_sequence<GpioPortCount> {}), std::memory_order_relaxed);
+			m_changes.store(0, std::memory_order_relaxed);
+		}
+
+		/*
+		 * @brief Démarre un timer qui appelle sample() toutes les SamplePeriodUs (vecteur lié par TimerTickIrq).
+		 **/
+		template <PwmTimerInstance timer>
+		static void start(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalTickTimer<timer>::template start<SamplePeriodUs>(preemptPriority, subPriority);
+		}
+
+		/*
+		 * @brief Un tick d'échantillonnage. À appeler depuis une ISR périodique.
+		 **/
+		static void sample() {
+			const uint32_t toggled = sample_ports(std::make_index_sequence<GpioPortCount> {});
+			if (!toggled)
+				return;
+			const uint32_t state = to_value(std::make_index_sequence<GpioPortCount> {});
+			m_state.store(state, std::memory_order_relaxed);
+			m_changes.fetch_or(toggled, std::memory_order_release);
+			m_onChange(toggled, state);
+		}
+
+		// État filtré courant (bit i = i-ème broche)
+		static uint32_t state() {
+			return m_state.load(std::memory_order_relaxed);
+		}
+
+		// Broches ayant changé d'état depuis le dernier appel
+		static uint32_t take_changes() {
+			return m_changes.exchange(0, std::memory_order_acquire);
+		}
+
+		/*
+		 * @brief Callback appelé depuis l'ISR de tick quand au moins une broche a changé : (changées, état).
+		 **/
+		static void set_on_change(Callback<uint32_t, uint32_t> onChange) {
+			m_onChange = onChange;
+		}
+
+	private:
+		struct PortFilter {
+			uint16_t state = 0;
+			uint16_t cnt0 = 0;
+			uint16_t cnt1 = 0;
+		};
+
+		template <size_t... P>
+		static inline void preload(std::index_sequence<P...>) {
+			((PinSet::PortMasks[P] != 0
+				? static_cast<void>(m_ports[P].state = static_cast<uint16_t>(read_port<P>()))
+				: static_cast<void>(0)), ...);
+		}
+
+		template <size_t P>
+		static inline uint32_t read_port() {
+			return HalGpioDriver::Regs<static_cast<GpioPort>(P)>()->IDR & PinSet::PortMasks[P];
+		}
+
+		template <size_t... P>
+		static inline uint32_t sample_ports(std::index_sequence<P...>) {
+			return (sample_port<P>() | ... | 0u);
+		}
+
+		// Compteur vertical : delta remet à zéro les compteurs stables, sinon cnt1:cnt0 avance ;
+		// au passage de 3 à 0, la broche bascule.
+		template <size_t P>
+		static inline uint32_t sample_port() {
+			if constexpr (PinSet::PortMasks[P] == 0)
+				return 0u;
+			else {
+				PortFilter& f = m_ports[P];
+				const uint16_t delta = static_cast<uint16_t>(read_port<P>() ^ f.state);
+				f.cnt1 = static_cast<uint16_t>((f.cnt1 ^ f.cnt0) & delta);
+				f.cnt0 = static_cast<uint16_t>(~f.cnt0 & delta);
+				const uint16_t toggle = static_cast<uint16_t>(delta & ~(f.cnt0 | f.cnt1));
+				f.state ^= toggle;
+				return PinSet::template port_to_value<P>(toggle);
+			}
+		}
+
+		template <size_t... P>
+		static inline uint32_t to_value(std::index_sequence<P...>) {
+			return (port_state<P>() | ... | 0u);
+		}
+
+		template <size_t P>
+		static inline uint32_t port_state() {
+			if constexpr (PinSet::PortMasks[P] == 0)
+				return 0u;
+			else
+				return PinSet::template port_to_value<P>(m_ports[P].state);
+		}
+
+		inline static std::array<PortFilter, GpioPortCount> m_ports {};
+		inline static std::atomic<uint32_t> m_state { 0 };
+		inline static std::atomic<uint32_t> m_changes { 0 };
+		inline static Callback<uint32_t, uint32_t> m_onChange {};
+	};
+
+} // namespace Wrapper
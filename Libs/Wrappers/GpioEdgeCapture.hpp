@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "GpioDriver.hpp"
+#include "GpioStatic.hpp"
+#include "Callback.hpp"
+#include "TimestampDriver.hpp"
+#include "SpscRing.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Front horodaté capturé dans l'ISR EXTI.
+	 **/
+	struct GpioEdgeEvent {
+		uint32_t timestamp;  ///< Valeur de la source d'horodatage à l'entrée du handler
+		GpioPort port;
+		uint8_t pin;
+		GpioPinState level;  ///< Niveau après le front
+	};
+
+	/*
+	 * @brief Capture horodatée des fronts d'un ensemble de broches dans une file SPSC.
+	 * L'ISR (producteur) horodate, lit le niveau et pousse un GpioEdgeEvent : pas d'allocation,
+	 * temps borné (quelques dizaines de cycles). Un thread (consommateur) vide la file par lots avec drain().
+	 * Si la file est pleine, l'événement est perdu et overflow_count() est incrémenté.
+	 *
+	 * @tparam Capacity  Taille de la file (puissance de 2)
+	 * @tparam Timestamp HalDwtTimestamp (cycles CPU) ou HalTimerTimestamp<TIM_2 / TIM_5>
+	 * @tparam Pins      Broches configurées en interruption
+	 * @note Toutes les lignes doivent partager la même priorité NVIC (cas par défaut) : un seul producteur à la fois.
+	 *
+	 * Exemple :
+	 *   using Capture = GpioEdgeCapture<256, HalDwtTimestamp, EncoderA, EncoderB>;
+	 *   Capture::init();
+	 *   // Optionnel, horodatage au plus tôt : WRAPPER_BIND_IRQ(EXTI0, GpioIrq<EncoderA, &Capture::on_edge<EncoderA>>)
+	 *   GpioEdgeEvent batch[32];
+	 *   size_t n = Capture::drain(batch, 32);
+	 **/
+	template <size_t Capacity, typename Timestamp, GpioConfigPolicy... Pins>
+	class GpioEdgeCapture {
+		static_assert(sizeof...(Pins) > 0, "GpioEdgeCapture attend au moins une broche");
+		static_assert(((Pins::Interrupt != GpioInterruptEdge::None) && ...), "GpioEdgeCapture : toutes les broches doivent être en interruption");
+
+	public:
+		using Ring = SpscRing<GpioEdgeEvent, Capacity>;
+		static constexpr uint32_t LineMask = (0u | ... | Pins::PinMask);
+		static_assert(std::popcount(LineMask) == sizeof...(Pins), "GpioEdgeCapture : deux broches partagent la même ligne EXTI");
+
+		/*
+		 * @brief Démarre la source d'horodatage, configure les broches et attache les handlers à la table EXTI.
+		 **/
+		static void init() {
+			Timestamp::start();
+			(init_pin<Pins>(), ...);
+		}
+
+		/*
+		 * @brief Handler ISR d'une broche. Peut être lié directement au vecteur (GpioIrq<Pin, &on_edge<Pin>>).
+		 **/
+		template <GpioConfigPolicy Pin>
+		static void on_edge() {
+			const uint32_t timestamp = Timestamp::now();
+			GpioEdgeEvent event { timestamp, Pin::Port, Pin::Pin, edge_level<Pin>() };
+			if (!m_ring.push(event))
+				m_overflows.store(m_overflows.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			m_notify();
+		}
+
+		// --- Côté consommateur ---
+		static size_t drain(GpioEdgeEvent* out, size_t maxCount) {
+			return m_ring.pop_batch(out, maxCount);
+		}
+
+		static bool pop(GpioEdgeEvent& event) {
+			return m_ring.pop(event);
+		}
+
+		static size_t pending() {
+			return m_ring.size();
+		}
+
+		static uint32_t overflow_count() {
+			return m_overflows.load(std::memory_order_relaxed);
+		}
+
+		/*
+		 * @brief Callback appelé depuis l'ISR après chaque push (ex: réveiller le thread consommateur).
+		 **/
+		static void set_notify(Callback<> notify) {
+			m_notify = notify;
+		}
+
+	private:
+		template <GpioConfigPolicy Pin>
+		static void init_pin() {
+			GpioStatic<Pin> pin;
+			pin.init();
+			pin.attach_interrupt(Callback<>::from<&on_edge<Pin>>());
+		}
+
+		// Sur un seul type de front, le niveau est connu ; sur les deux, il est lu dans IDR.
+		template <GpioConfigPolicy Pin>
+		static inline GpioPinState edge_level() {
+			if constexpr (Pin::Interrupt == GpioInterruptEdge::Rising)
+				return GpioPinState::Set;
+			else if constexpr (Pin::Interrupt == GpioInterruptEdge::Falling)
+				return GpioPinState::Reset;
+			else
+				return HalGpioDriver::read_direct<Pin::Port, Pin::PinMask>();
+		}
+
+		inline static Ring m_ring {};
+		inline static std::atomic<uint32_t> m_overflows { 0 };
+		inline static Callback<> m_notify {};
+	};
+
+} // namespace Wrapper
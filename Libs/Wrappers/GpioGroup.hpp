@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "GpioDriver.hpp"
+#include "GpioStatic.hpp"
+#include "GpioPinSet.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Groupe de broches GPIO écrit/lu comme un bus parallèle.
+	 * Le bit i de la valeur correspond à la i-ème politique (ex: D0..D7 d'un LCD).
+	 * Les masques set/reset de chaque port sont calculés à la compilation :
+	 * write() fait un seul store BSRR par port concerné (mise à jour atomique des broches d'un port),
+	 * read() fait un seul load IDR par port et rassemble les bits par segments contigus.
+	 * @note Les broches réparties sur plusieurs ports sont mises à jour port après port.
+	 **/
+	template <GpioConfigPolicy... Pins>
+	class GpioGroup {
+	public:
+		using PinSet = GpioPinSet<Pins...>;
+		static constexpr size_t Width = PinSet::Count;
+		static constexpr uint32_t ValueMask = PinSet::ValueMask;
+
+		GpioGroup() = default;
+
+		void init() {
+			(GpioStatic<Pins>{}.init(), ...);
+		}
+
+		void write(uint32_t value) {
+			static_assert((Pins::CanSet && ...), "Toutes les broches du groupe doivent être en sortie pour write()");
+			write_ports(value, std::make_index_sequence<GpioPortCount> {});
+		}
+
+		uint32_t read() const {
+			static_assert((Pins::CanRead && ...), "Toutes les broches du groupe doivent être en entrée pour read()");
+			return read_ports(std::make_index_sequence<GpioPortCount> {});
+		}
+
+	private:
+		// --- Écriture : un store BSRR par port ---
+		template <size_t... P>
+		static inline void write_ports(uint32_t value, std::index_sequence<P...>) {
+			(write_port<P>(value), ...);
+		}
+
+		template <size_t P>
+		static inline void write_port(uint32_t value) {
+			constexpr uint16_t portMask = PinSet::PortMasks[P];
+			if constexpr (portMask != 0) {
+				const uint32_t set = PinSet::template value_to_port<P>(value);
+				HalGpioDriver::Regs<static_cast<GpioPort>(P)>()->BSRR = (static_cast<uint32_t>(portMask & ~set) << 16) | set;
+			}
+		}
+
+		// --- Lecture : un load IDR par port ---
+		template <size_t... P>
+		static inline uint32_t read_ports(std::index_sequence<P...>) {
+			return (read_port<P>() | ... | 0u);
+		}
+
+		template <size_t P>
+		static inline uint32_t read_port() {
+			if constexpr (PinSet::PortMasks[P] == 0)
+				return 0u;
+			else {
+				const uint32_t idr = HalGpioDriver::Regs<static_cast<GpioPort>(P)>()->IDR;
+				return PinSet::template port_to_value<P>(idr);
+			}
+		}
+	};
+
+} // namespace Wrapper
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	inline constexpr size_t GpioPortCount = 9; // GPIO_A .. GPIO_I
+
+	constexpr size_t PortIndex(GpioPort port) {
+		return static_cast<size_t>(port);
+	}
+
+	/*
+	 * @brief Segment de broches contiguës : les bits [valueShift, valueShift + largeur) d'une valeur
+	 * correspondent aux broches [pinShift, pinShift + largeur) d'un même port.
+	 * Un segment se lit/écrit avec un seul décalage et un seul masque.
+	 **/
+	struct GpioPinRun {
+		GpioPort port;
+		uint8_t valueShift;
+		uint8_t pinShift;
+		uint16_t mask; ///< Masque de largeur du segment, non décalé
+	};
+
+	namespace Detail {
+		template <size_t N>
+		constexpr size_t CountRuns(const std::array<GpioPort, N>& ports, const std::array<uint8_t, N>& pins) {
+			size_t runs = 0;
+			for (size_t i = 0; i < N; ++i) {
+				if (i == 0 || ports[i] != ports[i - 1] || pins[i] != pins[i - 1] + 1)
+					++runs;
+			}
+			return runs;
+		}
+
+		template <size_t RunCount, size_t N>
+		constexpr std::array<GpioPinRun, RunCount> MakeRuns(const std::array<GpioPort, N>& ports, const std::array<uint8_t, N>& pins) {
+			std::array<GpioPinRun, RunCount> runs {};
+			size_t r = 0;
+			for (size_t i = 0; i < N; ++i) {
+				if (i == 0 || ports[i] != ports[i - 1] || pins[i] != pins[i - 1] + 1) {
+					if (i != 0) ++r;
+					runs[r] = GpioPinRun { ports[i], static_cast<uint8_t>(i), pins[i], 0 };
+				}
+				runs[r].mask = static_cast<uint16_t>((runs[r].mask << 1) | 1u);
+			}
+			return runs;
+		}
+
+		template <size_t N>
+		constexpr std::array<uint16_t, GpioPortCount> MakePortMasks(const std::array<GpioPort, N>& ports, const std::array<uint8_t, N>& pins) {
+			std::array<uint16_t, GpioPortCount> masks {};
+			for (size_t i = 0; i < N; ++i)
+				masks[PortIndex(ports[i])] |= static_cast<uint16_t>(1u << pins[i]);
+			return masks;
+		}
+
+		template <size_t N>
+		constexpr bool AllDistinct(const std::array<GpioPort, N>& ports, const std::array<uint8_t, N>& pins) {
+			for (size_t i = 0; i < N; ++i)
+				for (size_t j = i + 1; j < N; ++j)
+					if (ports[i] == ports[j] && pins[i] == pins[j])
+						return false;
+			return true;
+		}
+	}
+
+	/*
+	 * @brief Description à la compilation d'un ensemble ordonné de broches.
+	 * Le bit i d'une valeur correspond à la i-ème politique de la liste.
+	 * Fournit les masques par port et le découpage en segments contigus.
+	 **/
+	template <GpioConfigPolicy... Pins>
+	struct GpioPinSet {
+		static constexpr size_t Count = sizeof...(Pins);
+		static_assert(Count > 0 && Count <= 32, "Un GpioPinSet contient de 1 à 32 broches");
+
+		static constexpr std::array<GpioPort, Count> Ports { Pins::Port... };
+		static constexpr std::array<uint8_t, Count> PinNumbers { Pins::Pin... };
+		static_assert(Detail::AllDistinct(Ports, PinNumbers), "Une broche apparaît plusieurs fois dans le GpioPinSet");
+
+		static constexpr std::array<uint16_t, GpioPortCount> PortMasks = Detail::MakePortMasks(Ports, PinNumbers);
+
+		static constexpr size_t RunCount = Detail::CountRuns(Ports, PinNumbers);
+		static constexpr std::array<GpioPinRun, RunCount> Runs = Detail::MakeRuns<RunCount>(Ports, PinNumbers);
+
+		static constexpr uint32_t ValueMask = (Count == 32) ? 0xFFFFFFFFu : ((1u << Count) - 1u);
+
+		// Bits d'un registre du port P (IDR, ODR...) -> bits de valeur (bit i = i-ème broche)
+		template <size_t P>
+		static constexpr uint32_t port_to_value(uint32_t portBits) {
+			return port_to_value<P>(portBits, std::make_index_sequence<RunCount> {});
+		}
+
+		// Bits de valeur -> bits du port P (seules les broches de ce port sont positionnées)
+		template <size_t P>
+		static constexpr uint32_t value_to_port(uint32_t value) {
+			return value_to_port<P>(value, std::make_index_sequence<RunCount> {});
+		}
+
+	private:
+		template <size_t P, size_t... R>
+		static constexpr uint32_t port_to_value(uint32_t portBits, std::index_sequence<R...>) {
+			return (run_to_value<P, R>(portBits) | ... | 0u);
+		}
+
+		template <size_t P, size_t R>
+		static constexpr uint32_t run_to_value(uint32_t portBits) {
+			constexpr GpioPinRun run = Runs[R];
+			if constexpr (PortIndex(run.port) != P)
+				return 0u;
+			else
+				return ((portBits >> run.pinShift) & run.mask) << run.valueShift;
+		}
+
+		template <size_t P, size_t... R>
+		static constexpr uint32_t value_to_port(uint32_t value, std::index_sequence<R...>) {
+			return (run_to_port<P, R>(value) | ... | 0u);
+		}
+
+		template <size_t P, size_t R>
+		static constexpr uint32_t run_to_port(uint32_t value) {
+			constexpr GpioPinRun run = Runs[R];
+			if constexpr (PortIndex(run.port) != P)
+				return 0u;
+			else
+				return ((value >> run.valueShift) & run.mask) << run.pinShift;
+		}
+	};
+
+} // namespace Wrapper
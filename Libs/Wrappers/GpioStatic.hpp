@@ -1,7 +1,6 @@
 #pragma once
 
 #include "GpioEnumsStructs.hpp"
-#include <functional>
 #include "IGpioDriver.hpp"
 #include "GpioDriver.hpp"
 #include "GpioConfigPolicy.hpp"
@@ -12,7 +11,11 @@ using namespace WrapperBase;
 namespace Wrapper {
 	
 
-template<GpioConfigPolicy config, typename Driver = HalGpioDriver>
+/*
+ * @brief Broche GPIO résolue à la compilation.
+ * @tparam Access Politique d'accès du chemin direct : GpioBsrrAccess (défaut) ou GpioBitBandAccess.
+ **/
+template<GpioConfigPolicy config, GpioDriverConcept Driver = HalGpioDriver, GpioAccessPolicy Access = GpioBsrrAccess>
 	class GpioStatic {
 	public:
 		GpioStatic() = default;
@@ -23,36 +26,52 @@ template<GpioConfigPolicy config, typename Driver = HalGpioDriver>
 		
 		void constexpr set_high() { 
 			if constexpr (config::CanSet) {
-				driver.write(config::Port, config::PinMask, GpioPinState::Set);
+				if constexpr (DirectAccess)
+					Access::template set<config::Port, config::PinMask>();
+				else
+					driver.write(config::Port, config::PinMask, GpioPinState::Set);
 			}
 		}
 		
 		void constexpr set_low() {
 			if constexpr (config::CanSet) {
-				driver.write(config::Port, config::PinMask, GpioPinState::Reset);
+				if constexpr (DirectAccess)
+					Access::template reset<config::Port, config::PinMask>();
+				else
+					driver.write(config::Port, config::PinMask, GpioPinState::Reset);
 			}
 		}
 		
 		void constexpr toggle() { 
 			if constexpr (config::CanToggle) {
-				driver.toggle(config::Port, config::PinMask);
+				if constexpr (DirectAccess)
+					Access::template toggle<config::Port, config::PinMask>();
+				else
+					driver.toggle(config::Port, config::PinMask);
 			}
 		}
 		
 		GpioPinState read() {
-			if constexpr (config::CanRead) 
-				return driver.read(config::Port, config::PinMask);
+			if constexpr (config::CanRead) {
+				if constexpr (DirectAccess)
+					return Access::template read<config::Port, config::PinMask>();
+				else
+					return driver.read(config::Port, config::PinMask);
+			}
 			else 
 				return GpioPinState::Reset;
 		}
 		
-		void attach_interrupt(std::function<void()> callback) {
+		void attach_interrupt(Callback<> callback) {
 			if constexpr (config::Interrupt != GpioInterruptEdge::None) {
-				driver.attach_interrupt(config::Pin, std::move(callback));
+				driver.attach_interrupt(config::Pin, callback);
 			}
 			Driver::EnableIrq(config::Pin, 0,0);
 		}
 	private:
-		Driver driver;
+		// Chemin registre direct (via Access) si le driver le propose (HalGpioDriver), sinon appel via l'interface (mocks).
+		static constexpr bool DirectAccess = requires { requires Driver::HasDirectAccess; };
+		
+		[[no_unique_address]] Driver driver;
 	};
 } //namespace
\ No newline at end of file
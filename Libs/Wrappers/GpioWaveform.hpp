@@ -0,0 +1,245 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "PwmEnumsStructs.hpp"
+#include "GpioDriver.hpp"
+#include "GpioStatic.hpp"
+#include "GpioPinSet.hpp"
+#include "Callback.hpp"
+#include "WaveDmaDriver.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Symbole de codage d'un bit en créneaux : un bit occupe Slots échantillons,
+	 * la sortie est haute pendant les High0 (bit à 0) ou High1 (bit à 1) premiers échantillons.
+	 **/
+	template <uint8_t Slots, uint8_t High0, uint8_t High1>
+	struct BitSymbol {
+		static_assert(Slots > 0 && High0 <= Slots && High1 <= Slots, "BitSymbol : créneaux incohérents");
+		static constexpr uint8_t SlotCount = Slots;
+		static constexpr uint8_t HighSlots0 = High0;
+		static constexpr uint8_t HighSlots1 = High1;
+	};
+
+	// WS2812B à 2,4 MHz : 0 = 417 ns haut / 833 ns bas, 1 = 833 ns haut / 417 ns bas
+	using Ws2812Symbol = BitSymbol<3, 1, 2>;
+	inline constexpr uint32_t Ws2812SampleRateHz = 2400000;
+
+	/*
+	 * @brief Encodeur de mots BSRR pour un groupe de broches d'un même port.
+	 * Le bit i d'une valeur correspond à la i-ème broche : level_word() donne le mot BSRR qui
+	 * impose exactement ce niveau à toutes les broches du groupe (set pour les 1, reset pour les 0).
+	 * Un mot 0 ne modifie aucune broche.
+	 **/
+	template <GpioConfigPolicy... Pins>
+	struct BsrrEncoder {
+		using PinSet = GpioPinSet<Pins...>;
+		static constexpr size_t Lanes = PinSet::Count;
+		static constexpr GpioPort Port = PinSet::Ports[0];
+		static constexpr size_t PortSlot = PortIndex(Port);
+		static constexpr uint16_t PortMask = PinSet::PortMasks[PortSlot];
+		static_assert(((Pins::Port == Port) && ...), "BsrrEncoder : toutes les broches doivent être sur le même port");
+
+		static constexpr uint32_t level_word(uint32_t value) {
+			const uint32_t set = PinSet::template value_to_port<PortSlot>(value);
+			return (static_cast<uint32_t>(PortMask & ~set) << 16) | set;
+		}
+
+		// Mots nécessaires pour encoder bytes octets par voie avec le symbole donné
+		template <typename Symbol>
+		static constexpr size_t EncodedSize(size_t bytes) {
+			return bytes * 8u * Symbol::SlotCount;
+		}
+
+		/*
+		 * @brief Encode une suite de niveaux (une valeur par échantillon).
+		 * @return Nombre de mots écrits, 0 si out est trop petit.
+		 **/
+		static size_t encode_levels(const uint32_t* values, size_t count, uint32_t* out, size_t outCapacity) {
+			if (count > outCapacity)
+				return 0;
+			for (size_t i = 0; i < count; ++i)
+				out[i] = level_word(values[i]);
+			return count;
+		}
+
+		/*
+		 * @brief Encode Lanes flux d'octets en parallèle (MSB d'abord), une voie par broche.
+		 * lanes[i] pointe sur bytes octets destinés à la i-ème broche.
+		 * @return Nombre de mots écrits, 0 si out est trop petit.
+		 **/
+		template <typename Symbol>
+		static size_t encode_bits(const uint8_t* const (&lanes)[Lanes], size_t bytes, uint32_t* out, size_t outCapacity) {
+			const size_t needed = EncodedSize<Symbol>(bytes);
+			if (needed > outCapacity)
+				return 0;
+			size_t w = 0;
+			for (size_t byte = 0; byte < bytes; ++byte) {
+				for (int bit = 7; bit >= 0; --bit) {
+					uint32_t ones = 0;
+					for (size_t lane = 0; lane < Lanes; ++lane)
+						ones |= static_cast<uint32_t>((lanes[lane][byte] >> bit) & 1u) << lane;
+					for (uint8_t slot = 0; slot < Symbol::SlotCount; ++slot)
+						out[w++] = level_word(slot_value<Symbol>(ones, slot));
+				}
+			}
+			return needed;
+		}
+
+		// Variante une voie (Lanes == 1)
+		template <typename Symbol>
+		static size_t encode_bits(const uint8_t* data, size_t bytes, uint32_t* out, size_t outCapacity) {
+			static_assert(Lanes == 1, "BsrrEncoder : une voie par broche, utiliser la variante multi-voies");
+			const uint8_t* const lanes[1] = { data };
+			return encode_bits<Symbol>(lanes, bytes, out, outCapacity);
+		}
+
+		/*
+		 * @brief Remplit count échantillons avec un niveau constant (ex: reset WS2812 > 50 µs à l'état bas).
+		 **/
+		static size_t encode_hold(uint32_t value, size_t count, uint32_t* out, size_t outCapacity) {
+			if (count > outCapacity)
+				return 0;
+			const uint32_t word = level_word(value);
+			for (size_t i = 0; i < count; ++i)
+				out[i] = word;
+			return count;
+		}
+
+	private:
+		// Voies hautes pendant ce créneau : toutes si slot < min(High0, High1), puis selon le bit
+		template <typename Symbol>
+		static constexpr uint32_t slot_value(uint32_t ones, uint8_t slot) {
+			constexpr uint32_t all = (Lanes >= 32) ? 0xFFFFFFFFu : ((1u << Lanes) - 1u);
+			const uint32_t zeros = ~ones & all;
+			return (slot < Symbol::HighSlots1 ? ones : 0u) | (slot < Symbol::HighSlots0 ? zeros : 0u);
+		}
+	};
+
+	/*
+	 * @brief Générateur de formes d'onde GPIO par DMA : un tampon de mots BSRR est écrit dans
+	 * le port à chaque mise à jour du timer, sans intervention du CPU et sans gigue due à l'ordonnanceur.
+	 *
+	 * @tparam timer TIM_1 ou TIM_8 (requête de mise à jour routée vers DMA2)
+	 * @tparam Pins  Broches de sortie, toutes sur le même port
+	 *
+	 * Exemple (deux bandeaux WS2812 en parallèle) :
+	 *   using Strips = GpioWaveform<PwmTimerInstance::TIM_1, StripA, StripB>;
+	 *   WRAPPER_BIND_IRQ(DMA2_Stream5, Strips)
+	 *   Strips::init();
+	 *   size_t n = Strips::Encoder::encode_bits<Ws2812Symbol>({ pixelsA, pixelsB }, 3 * Leds, buffer, Size);
+	 *   n += Strips::Encoder::encode_hold(0, 130, buffer + n, Size - n);
+	 *   Strips::play(buffer, n, Ws2812SampleRateHz);
+	 **/
+	template <PwmTimerInstance timer, GpioConfigPolicy... Pins>
+	class GpioWaveform {
+		static_assert(((Pins::Mode == GpioPinMode::Output) && ...), "GpioWaveform : toutes les broches doivent être en sortie");
+
+		using Dma = HalTimerGpioDma<timer>;
+
+	public:
+		using Encoder = BsrrEncoder<Pins...>;
+		static constexpr IRQn_Type Irq = Dma::Irq;
+
+		/*
+		 * @brief Configure les broches, le timer et le stream DMA (arrêtés).
+		 **/
+		static void init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			(GpioStatic<Pins> {}.init(), ...);
+			Dma::init(&HalGpioDriver::Regs<Encoder::Port>()->BSRR, preemptPriority, subPriority);
+		}
+
+		/*
+		 * @brief Joue count mots une fois ; on_complete est appelé depuis l'ISR DMA à la fin.
+		 * @return false si une lecture est déjà en cours, si count est hors limites (1..65535) ou si
+		 * sampleRateHz est nul ou au-delà de la moitié de l'horloge timer.
+		 **/
+		static bool play(const uint32_t* words, size_t count, uint32_t sampleRateHz) {
+			return launch(words, count, sampleRateHz, false);
+		}
+
+		/*
+		 * @brief Joue le tampon en boucle jusqu'à stop(). on_half / on_complete signalent la moitié
+		 * libre à recalculer (double tampon).
+		 **/
+		static bool loop(const uint32_t* words, size_t count, uint32_t sampleRateHz) {
+			return launch(words, count, sampleRateHz, true);
+		}
+
+		static void stop() {
+			Dma::stop();
+			m_busy.store(false, std::memory_order_release);
+		}
+
+		static bool busy() {
+			return m_busy.load(std::memory_order_acquire);
+		}
+
+		// Erreurs de transfert DMA (tampon inaccessible, ex: en CCM)
+		static uint32_t error_count() {
+			return m_errors.load(std::memory_order_relaxed);
+		}
+
+		static void set_on_complete(Callback<> onComplete) {
+			m_onComplete = onComplete;
+		}
+
+		static void set_on_half(Callback<> onHalf) {
+			m_onHalf = onHalf;
+		}
+
+		/*
+		 * @brief ISR du stream DMA, à lier avec WRAPPER_BIND_IRQ(DMA2_Stream5 / DMA2_Stream1, GpioWaveform<...>).
+		 **/
+		static void isr() {
+			const uint32_t flags = Dma::flags() & Dma::AllFlags;
+			Dma::clear_flags(flags);
+
+			if (flags & Dma::TransferError) {
+				m_errors.store(m_errors.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				stop();
+				m_onComplete();
+				return;
+			}
+			if (flags & Dma::HalfTransfer)
+				m_onHalf();
+			if (flags & Dma::TransferComplete) {
+				if (!m_circular) {
+					Dma::stop();
+					m_busy.store(false, std::memory_order_release);
+				}
+				m_onComplete();
+			}
+		}
+
+	private:
+		static bool launch(const uint32_t* words, size_t count, uint32_t sampleRateHz, bool circular) {
+			if (count == 0 || count > 0xFFFFu || sampleRateHz == 0)
+				return false;
+			if (m_busy.exchange(true, std::memory_order_acq_rel))
+				return false;
+			m_circular = circular;
+			if (!Dma::start(words, static_cast<uint16_t>(count), sampleRateHz, circular)) {
+				m_busy.store(false, std::memory_order_release);
+				return false;
+			}
+			return true;
+		}
+
+		inline static std::atomic<bool> m_busy { false };
+		inline static std::atomic<uint32_t> m_errors { 0 };
+		inline static bool m_circular = false;
+		inline static Callback<> m_onComplete {};
+		inline static Callback<> m_onHalf {};
+	};
+
+} // namespace Wrapper
@@ -0,0 +1,325 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "I2cEnumsStructs.hpp"
+#include "I2cConfigPolicy.hpp"
+#include "I2cDriver.hpp"
+#include "I2cStatic.hpp"
+#include "Callback.hpp"
+#include "MpscList.hpp"
+#include "Semaphore.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Travail I2C : écriture puis lecture sur un esclave, chaque phase optionnelle.
+	 *  - regSize 1 ou 2 : adressage registre (Mem_Write / Mem_Read, répétition de START avant la lecture) ;
+	 *    sans données à écrire ni à lire, seul le numéro de registre est écrit (pointeur de registre).
+	 *  - regSize 0 : écriture et lecture brutes, séparées par un STOP.
+	 * Les tampons restent au planificateur entre submit() et done (pending) ; en SRAM1/SRAM2 (DMA, pas de CCM).
+	 **/
+	struct I2cJob {
+		uint16_t address = 0; // Adresse 7 bits, non décalée
+		uint16_t reg = 0;
+		uint8_t regSize = 0;
+		std::span<const uint8_t> write {};
+		std::span<uint8_t> read {};
+		Callback<I2cJob*> done {};
+		volatile bool ok = false;      // Renseigné avant done
+		volatile bool pending = false; // Vrai de submit() jusqu'à done
+		volatile uint32_t error = 0;   // HAL_I2C_ERROR_* du handle (AF : esclave absent / NACK)
+
+		I2cJob* queueLink = nullptr; // Réservé à la file
+	};
+
+	/*
+	 * @brief Compteurs du planificateur (instantané). nacks : travaux terminés sur HAL_I2C_ERROR_AF.
+	 **/
+	struct I2cSchedulerStats {
+		uint32_t depth;
+		uint32_t maxDepth;
+		uint32_t jobs;
+		uint32_t errors;
+		uint32_t nacks;
+	};
+
+	/*
+	 * @brief File de travaux I2C d'un port, exécutés à la suite par DMA. Les travaux sont mis en file sans
+	 * verrou depuis plusieurs threads ; la fin d'une phase (callback HAL, en ISR) lance la phase ou le travail
+	 * suivant sans retour au thread. Le thread appelant dort sur un sémaphore au lieu d'attendre en boucle.
+	 *
+	 *   using Sensors = I2cScheduler<I2c1Config>;
+	 *   WRAPPER_BIND_IRQ(I2C1_EV, I2cEventIrq<I2c1Config>)
+	 *   WRAPPER_BIND_IRQ(I2C1_ER, I2cErrorIrq<I2c1Config>)
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream6, I2cTxDmaIrq<I2c1Config>)
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream0, I2cRxDmaIrq<I2c1Config>)
+	 *   Sensors::init(6);
+	 *
+	 *   uint8_t accel[6], temp[2];
+	 *   I2cJob jobs[2] = { { 0x68, 0x3B, 1, {}, accel }, { 0x48, 0x00, 1, {}, temp } };
+	 *   Sensors::transfer(jobs, done_semaphore, 10);   // deux lectures enchaînées, un seul réveil
+	 *
+	 * @note Le port est réservé au planificateur : ses callbacks remplacent ceux de I2cStatic::attach_callbacks.
+	 * Pas de récupération de bus (SDA bloquée) : un travail sans fin ne se termine que par l'erreur HAL.
+	 **/
+	template <I2cConfigPolicy config>
+	class I2cScheduler {
+		static constexpr int8_t handleIndex = HalI2cDriver::handle_index(config::Port);
+
+	public:
+		/*
+		 * @brief Broches, périphérique, streams DMA et vecteurs EV/ER/DMA. Priorité : celle des ISR qui
+		 * réveillent les threads (FreeRTOS : numériquement >= configMAX_SYSCALL_INTERRUPT_PRIORITY).
+		 **/
+		static bool init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			I2cStatic<config> port;
+			port.init();
+			HalI2cDriver::attach_callbacks(handleIndex,
+				Callback<>::template from<&on_tx_complete>(),
+				Callback<>::template from<&on_rx_complete>(),
+				Callback<>::template from<&on_error>());
+			return HalI2cDriver::init_dma(config::Port, preemptPriority, subPriority) == HAL_OK;
+		}
+
+		/*
+		 * @brief Met un travail en file. Appelable depuis n'importe quel thread (ou ISR de priorité inférieure
+		 * ou égale aux vecteurs I2C/DMA du port). Ne bloque jamais ; done est appelé depuis l'ISR.
+		 **/
+		static void submit(I2cJob& job) {
+			job.ok = false;
+			job.pending = true;
+			job.error = HAL_I2C_ERROR_NONE;
+			const uint32_t depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+			uint32_t max = m_maxDepth.load(std::memory_order_relaxed);
+			while (depth > max && !m_maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {}
+
+			m_inbox.push(&job);
+			if (!m_busy.exchange(true, std::memory_order_acquire))
+				advance();
+		}
+
+		/*
+		 * @brief Exécute un travail et bloque le thread appelant jusqu'à sa fin, au plus timeoutMs par attente.
+		 * done est remplacé par le réveil de semaphore (binaire, initialement pris, un par thread appelant).
+		 * Un travail encore au planificateur après un délai écoulé est d'abord attendu (wait), jamais
+		 * soumis deux fois. Même protocole que SpiBus::transfer.
+		 * @return false sur erreur ou délai écoulé ; après un délai écoulé le travail reste au planificateur
+		 * (pending) : ne pas le modifier ni réutiliser ses tampons avant que wait() renvoie true.
+		 **/
+		static bool transfer(I2cJob& job, Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = UINT32_MAX) {
+			if (!wait(job, semaphore, timeoutMs))
+				return false;
+			job.done = Callback<I2cJob*>(&wake, &semaphore);
+			submit(job);
+			return semaphore.take(timeoutMs) && wait(job, semaphore, timeoutMs) && job.ok;
+		}
+
+		/*
+		 * @brief Exécute une série de travaux à la suite, un seul réveil : la file est FIFO, la fin du dernier
+		 * implique celle des précédents. Le résultat de chacun reste dans son ok / error.
+		 * @return true si tous ont réussi dans le délai
+		 **/
+		static bool transfer(std::span<I2cJob> jobs, Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = UINT32_MAX) {
+			if (jobs.empty())
+				return true;
+			for (const I2cJob& job : jobs)
+				if (!wait(job, semaphore, timeoutMs))
+					return false;
+			for (I2cJob& job : jobs.first(jobs.size() - 1)) {
+				job.done = {};
+				submit(job);
+			}
+			if (!transfer(jobs.back(), semaphore, timeoutMs))
+				return false;
+			for (const I2cJob& job : jobs)
+				if (!job.ok)
+					return false;
+			return true;
+		}
+
+		/*
+		 * @brief Attend la fin d'un travail lancé par transfer() sur semaphore, au plus timeoutMs par réveil.
+		 * Un réveil resté dans le sémaphore après un délai écoulé est consommé : seul pending fait foi.
+		 * @return true si le travail n'est plus au planificateur (ses tampons sont rendus)
+		 **/
+		static bool wait(const I2cJob& job, Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = UINT32_MAX) {
+			while (job.pending)
+				if (!semaphore.take(timeoutMs))
+					return false;
+			return true;
+		}
+
+		static I2cSchedulerStats stats() {
+			return {
+				m_depth.load(std::memory_order_relaxed),
+				m_maxDepth.load(std::memory_order_relaxed),
+				m_jobs.load(std::memory_order_relaxed),
+				m_errors.load(std::memory_order_relaxed),
+				m_nacks.load(std::memory_order_relaxed),
+			};
+		}
+
+		static bool idle() {
+			return !m_busy.load(std::memory_order_acquire);
+		}
+
+	private:
+		enum class Phase : uint8_t { Write, Read };
+
+		static void wake(void* semaphore, I2cJob*) {
+			static_cast<Rtos::Abstract::ISemaphore*>(semaphore)->give_from_isr();
+		}
+
+		static inline uint16_t hal_address(const I2cJob& job) {
+			return static_cast<uint16_t>(job.address << 1);
+		}
+
+		static inline uint16_t mem_size(const I2cJob& job) {
+			return job.regSize == 2 ? I2C_MEMADD_SIZE_16BIT : I2C_MEMADD_SIZE_8BIT;
+		}
+
+		// Lance la phase de lecture ; HAL_OK sans rien lancer s'il n'y en a pas (m_current inchangé)
+		static HAL_StatusTypeDef start_read(I2cJob& job) {
+			m_phase = Phase::Read;
+			const uint16_t size = static_cast<uint16_t>(job.read.size());
+			if (job.regSize)
+				return m_driver.mem_read_dma(handleIndex, hal_address(job), job.reg, mem_size(job), job.read.data(), size);
+			return m_driver.master_receive_dma(handleIndex, hal_address(job), job.read.data(), size);
+		}
+
+		// Lance la première phase du travail ; false s'il est vide (terminé sans transfert)
+		static bool start_job(I2cJob& job, HAL_StatusTypeDef& status) {
+			m_phase = Phase::Write;
+			if (!job.write.empty()) {
+				const uint16_t size = static_cast<uint16_t>(job.write.size());
+				status = job.regSize
+					? m_driver.mem_write_dma(handleIndex, hal_address(job), job.reg, mem_size(job), job.write.data(), size)
+					: m_driver.master_transmit_dma(handleIndex, hal_address(job), job.write.data(), size);
+				return true;
+			}
+			if (!job.read.empty()) {
+				status = start_read(job);
+				return true;
+			}
+			if (job.regSize) {
+				m_regBytes[0] = static_cast<uint8_t>(job.regSize == 2 ? job.reg >> 8 : job.reg);
+				m_regBytes[1] = static_cast<uint8_t>(job.reg);
+				status = m_driver.master_transmit_dma(handleIndex, hal_address(job), m_regBytes, job.regSize);
+				return true;
+			}
+			return false;
+		}
+
+		static void finish(I2cJob* job, bool ok, uint32_t error) {
+			m_current = nullptr;
+			const Callback<I2cJob*> done = job->done; // Lu avant : le propriétaire reprend la main
+			job->error = error;
+			job->ok = ok;
+			job->pending = false;
+			m_jobs.store(m_jobs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			if (!ok) {
+				m_errors.store(m_errors.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				if (error & HAL_I2C_ERROR_AF)
+					m_nacks.store(m_nacks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			}
+			m_depth.fetch_sub(1, std::memory_order_relaxed);
+			done(job);
+		}
+
+		static uint32_t handle_error() {
+			const I2C_HandleTypeDef* hi2c = HalI2cDriver::handle(config::Port);
+			const uint32_t error = hi2c ? hi2c->ErrorCode : HAL_I2C_ERROR_NONE;
+			return error != HAL_I2C_ERROR_NONE ? error : HAL_I2C_ERROR_TIMEOUT;
+		}
+
+		/*
+		 * @brief Démarre le prochain travail. Même protocole que SpiBus::advance : appelé uniquement par le
+		 * détenteur de m_busy, qui le relâche quand la file est vide puis revérifie.
+		 * Un travail refusé par la HAL (bus occupé) se termine en erreur et la file continue.
+		 **/
+		static void advance() {
+			for (;;) {
+				I2cJob* next = take_job();
+				if (next == nullptr) {
+					m_busy.store(false, std::memory_order_seq_cst);
+					if (m_inbox.empty() || m_busy.exchange(true, std::memory_order_acquire))
+						return;
+					continue;
+				}
+				m_current = next;
+				HAL_StatusTypeDef status = HAL_OK;
+				if (!start_job(*next, status))
+					finish(next, true, HAL_I2C_ERROR_NONE);
+				else if (status != HAL_OK)
+					finish(next, false, handle_error());
+				else
+					return;
+			}
+		}
+
+		static I2cJob* take_job() {
+			if (m_pending == nullptr)
+				m_pending = m_inbox.take_all();
+			I2cJob* job = m_pending;
+			if (job)
+				m_pending = job->queueLink;
+			return job;
+		}
+
+		// --- Callbacks HAL (ISR EV / DMA du port) ---
+
+		static void on_tx_complete() {
+			I2cJob* job = m_current;
+			if (job == nullptr)
+				return;
+			if (m_phase == Phase::Write && !job->read.empty()) {
+				const HAL_StatusTypeDef status = start_read(*job);
+				if (status == HAL_OK)
+					return;
+				finish(job, false, handle_error());
+			} else {
+				finish(job, true, HAL_I2C_ERROR_NONE);
+			}
+			advance();
+		}
+
+		static void on_rx_complete() {
+			I2cJob* job = m_current;
+			if (job == nullptr)
+				return;
+			finish(job, true, HAL_I2C_ERROR_NONE);
+			advance();
+		}
+
+		static void on_error() {
+			I2cJob* job = m_current;
+			if (job == nullptr)
+				return;
+			finish(job, false, handle_error());
+			advance();
+		}
+
+		inline static HalI2cDriver m_driver {};
+		inline static MpscList<I2cJob, &I2cJob::queueLink> m_inbox {};
+		inline static std::atomic<bool> m_busy { false };
+		// État du consommateur (détenteur de m_busy uniquement)
+		inline static I2cJob* m_pending = nullptr;
+		inline static I2cJob* volatile m_current = nullptr;
+		inline static Phase m_phase = Phase::Write;
+		inline static uint8_t m_regBytes[2] = { };
+
+		inline static std::atomic<uint32_t> m_depth { 0 };
+		inline static std::atomic<uint32_t> m_maxDepth { 0 };
+		inline static std::atomic<uint32_t> m_jobs { 0 };
+		inline static std::atomic<uint32_t> m_errors { 0 };
+		inline static std::atomic<uint32_t> m_nacks { 0 };
+	};
+
+} // namespace Wrapper
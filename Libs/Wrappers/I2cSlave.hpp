@@ -0,0 +1,304 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "I2cEnumsStructs.hpp"
+#include "I2cConfigPolicy.hpp"
+#include "I2cDriver.hpp"
+#include "I2cSlaveDmaDriver.hpp"
+#include "I2cStatic.hpp"
+#include "Callback.hpp"
+#include "SpscRing.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Bloc de registres 8 bits exposés au maître : [first, first + count), inscriptible ou non.
+	 **/
+	template <uint8_t first, uint8_t count, bool writable = false>
+	struct I2cRegisterBlock {
+		static constexpr uint8_t First = first;
+		static constexpr uint8_t Count = count;
+		static constexpr bool Writable = writable;
+	};
+
+	/*
+	 * @brief Carte de registres d'un esclave, résolue à la compilation. Les adresses hors blocs se lisent
+	 * à 0 et ne s'écrivent pas.
+	 *
+	 *   using Map = I2cRegisterMap<
+	 *       I2cRegisterBlock<0x00, 2>,          // identifiant, version
+	 *       I2cRegisterBlock<0x10, 4, true>,    // consignes
+	 *       I2cRegisterBlock<0x20, 16>>;        // mesures
+	 **/
+	template <typename... Blocks>
+	struct I2cRegisterMap {
+		static constexpr size_t Size = [] {
+			size_t size = 0;
+			((size = (size_t(Blocks::First) + Blocks::Count > size) ? size_t(Blocks::First) + Blocks::Count : size), ...);
+			return size;
+		}();
+		static_assert(sizeof...(Blocks) > 0 && Size > 0 && Size <= 256, "I2cRegisterMap : 1 à 256 registres");
+
+		static constexpr std::array<uint8_t, Size> Coverage = [] {
+			std::array<uint8_t, Size> coverage {};
+			((([&] { for (size_t i = Blocks::First; i < size_t(Blocks::First) + Blocks::Count; ++i) ++coverage[i]; })()), ...);
+			return coverage;
+		}();
+
+		static constexpr bool disjoint() {
+			for (uint8_t c : Coverage)
+				if (c > 1)
+					return false;
+			return true;
+		}
+		static_assert(disjoint(), "I2cRegisterMap : blocs qui se chevauchent");
+
+		static constexpr std::array<bool, Size> Writable = [] {
+			std::array<bool, Size> writable {};
+			((([&] { for (size_t i = Blocks::First; i < size_t(Blocks::First) + Blocks::Count; ++i) writable[i] = Blocks::Writable; })()), ...);
+			return writable;
+		}();
+	};
+
+	/*
+	 * @brief Écriture du maître acceptée : plage [first, first + count) contenant les registres modifiés
+	 * (une écriture qui traverse un registre en lecture seule le laisse intact).
+	 **/
+	struct I2cSlaveWrite {
+		uint8_t first;
+		uint16_t count; // Jusqu'à 256 : carte complète écrite d'un bloc
+	};
+
+	/*
+	 * @brief Compteurs de l'esclave (instantané).
+	 * rejected : octets écrits hors carte ou sur registre en lecture seule ; overreads : octets lus au-delà
+	 * de la carte (servis 0xFF, un par interruption) ; dropped : événements perdus, file pleine.
+	 **/
+	struct I2cSlaveStats {
+		uint32_t reads;
+		uint32_t writes;
+		uint32_t rejected;
+		uint32_t overreads;
+		uint32_t dropped;
+		uint32_t errors;
+	};
+
+	/*
+	 * @brief Esclave I2C servant une carte de registres depuis la RAM.
+	 * Protocole registre habituel : le premier octet écrit par le maître est le pointeur de registre, les
+	 * suivants sont écrits à partir de lui (auto-incrément) ; une lecture renvoie la carte à partir du pointeur.
+	 * La reconnaissance d'adresse arme le DMA directement sur la carte (lecture) ou sur un tampon de
+	 * réception (écriture) : pas d'interruption par octet, l'horloge n'est étirée que le temps de l'ISR ADDR.
+	 * À la fin d'une écriture (STOP ou START répété), les octets reçus sont appliqués aux registres
+	 * inscriptibles et publiés comme événement (file ISR -> thread), suivi de notify.
+	 *
+	 *   using Host = I2cSlave<I2c2SlaveConfig, Map>;
+	 *   WRAPPER_BIND_IRQ(I2C2_EV, I2cSlaveEventIrq<I2c2SlaveConfig, Map>)
+	 *   WRAPPER_BIND_IRQ(I2C2_ER, I2cSlaveErrorIrq<I2c2SlaveConfig, Map>)
+	 *   Host::init(5);
+	 *   Host::write(0x20, measures, sizeof(measures));   // publié au prochain accès du maître
+	 *   I2cSlaveWrite event;
+	 *   while (Host::poll(event)) apply_setpoints(event.first, event.count);
+	 *
+	 * @tparam config OwnAddress1 au format HAL (adresse 7 bits décalée de 1), étirement d'horloge autorisé
+	 * @tparam Map I2cRegisterMap<...>
+	 * @tparam EventCapacity Taille de la file d'événements (puissance de 2)
+	 * @note Le pointeur de registre n'avance pas en lecture : chaque lecture repart du dernier pointeur écrit.
+	 * Une valeur sur plusieurs octets mise à jour pendant une lecture en cours peut être vue à moitié.
+	 * La carte est lue par DMA : pas en CCM (placement par défaut des statiques : SRAM1).
+	 **/
+	template <I2cConfigPolicy config, typename Map, size_t EventCapacity = 16>
+	class I2cSlave {
+		static_assert(config::OwnAddress1 != 0 && config::AddressingMode == I2cAddressingMode::Mode7Bit,
+			"I2cSlave : adresse propre 7 bits requise (OwnAddress1)");
+		static_assert(!config::NoStretchMode, "I2cSlave : l'étirement d'horloge couvre l'armement du DMA");
+
+		using Dma = HalI2cSlaveDma<config::Port>;
+		enum class Transfer : uint8_t { None, Receive, Transmit };
+
+	public:
+		static constexpr size_t Size = Map::Size;
+
+		/*
+		 * @brief Broches, périphérique (HAL_I2C_Init), puis reprise par registres : DMA, EV/ER, ACK.
+		 **/
+		static void init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			I2cStatic<config> port;
+			port.init();
+			Dma::init(preemptPriority, subPriority);
+		}
+
+		// Appelé depuis l'ISR après chaque événement publié (ex. réveil d'un thread)
+		static void on_write(Callback<> notify) {
+			m_notify = notify;
+		}
+
+		// --- Côté application ---
+
+		static uint8_t get(uint8_t reg) {
+			return reg < Size ? m_registers[reg] : 0;
+		}
+
+		static void set(uint8_t reg, uint8_t value) {
+			if (reg < Size)
+				m_registers[reg] = value;
+		}
+
+		static void write(uint8_t reg, const void* data, size_t size) {
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size && reg + i < Size; ++i)
+				m_registers[reg + i] = bytes[i];
+		}
+
+		static void read(uint8_t reg, void* data, size_t size) {
+			uint8_t* bytes = static_cast<uint8_t*>(data);
+			for (size_t i = 0; i < size; ++i)
+				bytes[i] = get(static_cast<uint8_t>(reg + i));
+		}
+
+		// Prochaine écriture du maître, dans l'ordre d'arrivée
+		static bool poll(I2cSlaveWrite& event) {
+			return m_events.pop(event);
+		}
+
+		static I2cSlaveStats stats() {
+			return {
+				m_reads.load(std::memory_order_relaxed),
+				m_writes.load(std::memory_order_relaxed),
+				m_rejected.load(std::memory_order_relaxed),
+				m_overreads.load(std::memory_order_relaxed),
+				m_dropped.load(std::memory_order_relaxed),
+				m_errors.load(std::memory_order_relaxed),
+			};
+		}
+
+		// --- ISR, à lier avec I2cSlaveEventIrq / I2cSlaveErrorIrq ---
+
+		static void event_isr() {
+			I2C_TypeDef* i2c = Dma::I2c();
+			const uint32_t sr1 = i2c->SR1;
+
+			if (sr1 & I2C_SR1_ADDR) {
+				end_receive(); // START répété après l'écriture du pointeur
+				const uint32_t sr2 = i2c->SR2; // Lecture SR1 puis SR2 : ADDR effacé, l'horloge reste étirée jusqu'au DMA
+				if (sr2 & I2C_SR2_TRA) {
+					m_transfer = Transfer::Transmit;
+					const uint8_t pointer = m_pointer;
+					if (pointer < Size) {
+						Dma::start_tx(&m_registers[pointer], static_cast<uint16_t>(Size - pointer));
+					} else {
+						i2c->DR = 0xFFu; // Hors carte : premier octet direct, les suivants par BTF
+						increment(m_overreads);
+					}
+					increment(m_reads);
+				} else {
+					m_transfer = Transfer::Receive;
+					Dma::start_rx(m_rxBuffer, static_cast<uint16_t>(sizeof(m_rxBuffer)));
+				}
+			}
+
+			if (sr1 & I2C_SR1_STOPF) {
+				i2c->CR1 = i2c->CR1; // Lecture SR1 puis écriture CR1 : STOPF effacé
+				end_receive();
+				end_transmit();
+			}
+
+			// DMA épuisé, registre à décalage vide : le maître dépasse la carte ou le tampon
+			if (sr1 & I2C_SR1_BTF) {
+				if (m_transfer == Transfer::Transmit && !Dma::Tx::active()) {
+					i2c->DR = 0xFFu;
+					increment(m_overreads);
+				} else if (m_transfer == Transfer::Receive && !Dma::Rx::active()) {
+					(void)i2c->DR;
+					increment(m_rejected);
+				}
+			}
+		}
+
+		static void error_isr() {
+			const uint32_t sr1 = Dma::I2c()->SR1;
+			// NACK du maître sur le dernier octet lu : fin normale d'une lecture
+			if (sr1 & I2C_SR1_AF) {
+				Dma::clear_sr1(I2C_SR1_AF);
+				end_transmit();
+			}
+			const uint32_t errors = sr1 & (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
+			if (errors) {
+				Dma::clear_sr1(errors);
+				increment(m_errors);
+				end_receive();
+				end_transmit();
+			}
+		}
+
+	private:
+		static inline void increment(std::atomic<uint32_t>& counter, uint32_t amount = 1) {
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		static void end_transmit() {
+			if (m_transfer != Transfer::Transmit)
+				return;
+			m_transfer = Transfer::None;
+			Dma::Tx::stop();
+			Dma::flush_tx();
+		}
+
+		// Applique une écriture du maître : pointeur, puis données vers les registres inscriptibles
+		static void end_receive() {
+			if (m_transfer != Transfer::Receive)
+				return;
+			m_transfer = Transfer::None;
+			const size_t received = sizeof(m_rxBuffer) - Dma::Rx::stop();
+			if (received == 0)
+				return; // Sondage d'adresse seul
+
+			const uint8_t pointer = m_rxBuffer[0];
+			size_t first = Size;
+			size_t last = 0;
+			uint32_t rejected = 0;
+			for (size_t i = 1; i < received; ++i) {
+				const size_t reg = pointer + i - 1;
+				if (reg < Size && Map::Writable[reg]) {
+					m_registers[reg] = m_rxBuffer[i];
+					first = (reg < first) ? reg : first;
+					last = reg;
+				} else {
+					++rejected;
+				}
+			}
+			m_pointer = static_cast<uint8_t>(pointer + received - 1);
+			if (rejected)
+				increment(m_rejected, rejected);
+			if (first > last)
+				return; // Écriture du pointeur seul (avant une lecture) ou rien d'accepté
+
+			increment(m_writes);
+			if (!m_events.push({ static_cast<uint8_t>(first), static_cast<uint16_t>(last - first + 1) }))
+				increment(m_dropped);
+			m_notify();
+		}
+
+		inline static uint8_t m_registers[Size] = { };
+		inline static uint8_t m_rxBuffer[Size + 1] = { }; // Pointeur + une carte complète
+		inline static volatile uint8_t m_pointer = 0;
+		inline static volatile Transfer m_transfer = Transfer::None;
+		inline static SpscRing<I2cSlaveWrite, EventCapacity> m_events {};
+		inline static Callback<> m_notify {};
+
+		inline static std::atomic<uint32_t> m_reads { 0 };
+		inline static std::atomic<uint32_t> m_writes { 0 };
+		inline static std::atomic<uint32_t> m_rejected { 0 };
+		inline static std::atomic<uint32_t> m_overreads { 0 };
+		inline static std::atomic<uint32_t> m_dropped { 0 };
+		inline static std::atomic<uint32_t> m_errors { 0 };
+	};
+
+} // namespace Wrapper
@@ -11,12 +11,9 @@ using namespace Hal;
 
 namespace Wrapper {
 
-	template<I2cConfigPolicy config, typename Driver = HalI2cDriver>
+	template<I2cConfigPolicy config, I2cDriverConcept Driver = HalI2cDriver>
 		class I2cStatic {
 		public:
-			I2cStatic()
-				: handleIndex(HalI2cDriver::handleEmpty) {}
-
 			void init() {
 				// 1. Initialiser les broches GPIO SCL et SDA
 				// C'est ici que la "magie" de la composition opère
@@ -24,11 +21,13 @@ namespace Wrapper {
 				m_sda_pin.init();
             
 				// 2. Initialiser le périphérique I2C
-				int8_t handleindex = m_driver.template init<config>();
-                
-				if (handleindex != HalI2cDriver::handleEmpty) {
-					handleIndex = handleindex;
-				}
+				m_driver.template init<config>();
+			}
+
+			// Initialise uniquement le périphérique I2C.
+			// Broches et horloge doivent déjà être configurées (ex: par BoardInit).
+			void init_peripheral() {
+				m_driver.template init_peripheral<config>();
 			}
 
 			// --- Fonctions de communication bloquantes ---
@@ -51,6 +50,11 @@ namespace Wrapper {
 				return m_driver.mem_read(handleIndex, devAddress, memAddress, memAddSize, data, size, timeout);
 			}
 
+			// Sonde l'esclave (adresse seule) : HAL_OK s'il acquitte
+			HAL_StatusTypeDef is_device_ready(uint16_t devAddress, uint32_t trials = 1, uint32_t timeout = 2) {
+				return m_driver.is_device_ready(handleIndex, devAddress, trials, timeout);
+			}
+
 			// --- Fonctions de communication par interruption ---
 
 			HAL_StatusTypeDef master_transmit_it(uint16_t devAddress, const uint8_t* data, uint16_t size) {
@@ -71,19 +75,20 @@ namespace Wrapper {
 
 			// --- Gestion des Callbacks ---
 
-			void attach_callbacks(std::function<void()> tx_cb, std::function<void()> rx_cb, std::function<void()> error_cb) {
-				HalI2cDriver::activate_IRQ(config::Port);
-				HalI2cDriver::attach_callbacks(handleIndex, std::move(tx_cb), std::move(rx_cb), std::move(error_cb));
+			void attach_callbacks(Callback<> tx_cb, Callback<> rx_cb, Callback<> error_cb) {
+				Driver::activate_IRQ(config::Port);
+				Driver::attach_callbacks(handleIndex, tx_cb, rx_cb, error_cb);
 			}
 
 		private:
-			Driver m_driver;
-			int8_t handleIndex;
+			[[no_unique_address]] Driver m_driver;
+			// Handle résolu à la compilation : adresse constante dans le registre du driver
+			static constexpr int8_t handleIndex = Driver::handle_index(config::Port);
         
 			// Instanciation des wrappers GpioStatic pour SCL et SDA
 			// Le type de ces membres est déterminé par la "Policy"
-			typename config::SclPin::template GpioStatic<typename config::SclPin> m_scl_pin;
-			typename config::SdaPin::template GpioStatic<typename config::SdaPin> m_sda_pin;
+			GpioStatic<typename config::SclPin> m_scl_pin;
+			GpioStatic<typename config::SdaPin> m_sda_pin;
 		};
 
 } // namespace Wrapper
\ No newline at end of file
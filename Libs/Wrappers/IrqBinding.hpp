@@ -0,0 +1,274 @@
+#pragma once
+
+#include <type_traits>
+#include "GpioEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp"
+#include "GpioDriver.hpp"
+#include "TickTimerDriver.hpp"
+#ifdef HAL_UART_MODULE_ENABLED
+#include "UartConfigPolicy.hpp"
+#include "UartDriver.hpp"
+#include "UartTxQueue.hpp"
+#include "UartDeControl.hpp"
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+#include "SpiConfigPolicy.hpp"
+#include "SpiDriver.hpp"
+#include "SpiStreamDmaDriver.hpp"
+#include "SpiBus.hpp"
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+#include "I2cConfigPolicy.hpp"
+#include "I2cDriver.hpp"
+#include "I2cSlave.hpp"
+#endif
+
+using namespace Hal;
+using namespace WrapperBase;
+
+/*
+ * @brief Génère le handler d'interruption (symbole du vecteur) pour une liaison donnée.
+ * Le numéro d'IRQ déduit de la politique est vérifié à la compilation contre le vecteur choisi.
+ *
+ * Exemple :
+ *   void on_button();
+ *   WRAPPER_BIND_IRQ(EXTI0, Wrapper::GpioIrq<ButtonConfig, &on_button>)   // appel direct, inlinable
+ *   WRAPPER_BIND_IRQ(USART2, Wrapper::UartIrq<Uart2Config>)                // HAL + table de dispatch
+ *   WRAPPER_BIND_IRQ(EXTI9_5, Wrapper::GpioExtiDemux<5, 9>)                // vecteur EXTI partagé
+ **/
+#define WRAPPER_BIND_IRQ(Vector, ...)                                                             \
+	static_assert(__VA_ARGS__::Irq == Vector##_IRQn,                                              \
+		"WRAPPER_BIND_IRQ : la politique ne correspond pas au vecteur " #Vector);                 \
+	extern "C" void Vector##_IRQHandler(void) {                                                  \
+		__VA_ARGS__::isr();                                                                       \
+	}
+
+namespace Wrapper {
+
+	/*
+	 * @brief Liaison d'une ligne EXTI.
+	 * Avec Handler (fonction void()), l'ISR appelle directement le handler : pas de table, appel inlinable.
+	 * Sans Handler, l'ISR passe par la table de HalGpioDriver (callback attaché à l'exécution).
+	 * @note Sur EXTI9_5 / EXTI15_10, lier le vecteur avec GpioExtiDemux : une liaison seule laisserait
+	 * les autres lignes du vecteur en attente.
+	 **/
+	template <GpioConfigPolicy Pin, auto Handler = nullptr>
+	struct GpioIrq {
+		static_assert(Pin::Interrupt != GpioInterruptEdge::None, "GpioIrq : la broche doit être configurée en interruption");
+
+		static constexpr IRQn_Type Irq = HalGpioDriver::ExtiIrq(Pin::Pin);
+		static constexpr uint32_t LineMask = Pin::PinMask;
+		static constexpr bool Direct = !std::is_null_pointer_v<decltype(Handler)>;
+
+		static inline void isr() {
+			if (HalGpioDriver::acknowledge_pending(LineMask))
+				call();
+		}
+
+		// Appel du handler pour un masque de lignes déjà acquitté (utilisé par GpioExtiDemux)
+		static inline void dispatch(uint32_t pending) {
+			if (pending & LineMask)
+				call();
+		}
+
+	private:
+		static inline void call() {
+			if constexpr (Direct)
+				Handler();
+			else
+				HalGpioDriver::handle(Pin::Pin);
+		}
+	};
+
+	/*
+	 * @brief Démultiplexeur d'un vecteur EXTI partagé (EXTI9_5 : lignes 5..9, EXTI15_10 : lignes 10..15).
+	 * EXTI->PR est lu une seule fois et toutes les lignes en attente sont acquittées d'une seule écriture,
+	 * puis chaque ligne est servie dans la même entrée d'ISR :
+	 *  - les liaisons directes (GpioIrq<Pin, &handler>) passées en paramètre sont appelées sans table,
+	 *  - les autres lignes sont parcourues par CLZ dans la table de HalGpioDriver.
+	 *
+	 * Exemple :
+	 *   WRAPPER_BIND_IRQ(EXTI15_10, Wrapper::GpioExtiDemux<10, 15, GpioIrq<EncoderA, &on_encoder>>)
+	 **/
+	template <uint8_t FirstLine, uint8_t LastLine, typename... Bindings>
+	struct GpioExtiDemux {
+		static_assert(FirstLine <= LastLine && LastLine < HalGpioDriver::MaxPins, "GpioExtiDemux : plage de lignes invalide");
+
+		static constexpr IRQn_Type Irq = HalGpioDriver::ExtiIrq(FirstLine);
+		static_assert(HalGpioDriver::ExtiIrq(LastLine) == Irq, "GpioExtiDemux : les lignes doivent partager le même vecteur");
+		static_assert(((Bindings::Irq == Irq) && ...), "GpioExtiDemux : une liaison n'appartient pas à ce vecteur");
+
+		static constexpr uint32_t LineMask = ((1u << (LastLine + 1)) - 1u) & ~((1u << FirstLine) - 1u);
+		static constexpr uint32_t DirectMask = (0u | ... | (Bindings::Direct ? Bindings::LineMask : 0u));
+
+		static inline void isr() {
+			const uint32_t pending = HalGpioDriver::acknowledge_pending(LineMask);
+			if (!pending)
+				return;
+			(Bindings::dispatch(pending & DirectMask), ...);
+			HalGpioDriver::dispatch_lines(pending & ~DirectMask);
+		}
+	};
+
+	/*
+	 * @brief Liaison de l'interruption de mise à jour d'un timer (HalTickTimer) vers un handler appelé directement.
+	 **/
+	template <PwmTimerInstance timer, auto Handler>
+	struct TimerTickIrq {
+		static constexpr IRQn_Type Irq = HalTickTimer<timer>::Irq;
+
+		static inline void isr() {
+			if (HalTickTimer<timer>::acknowledge())
+				Handler();
+		}
+	};
+
+#ifdef HAL_UART_MODULE_ENABLED
+	/*
+	 * @brief Liaison du vecteur d'un port UART : la HAL traite l'IRQ puis rappelle la table de HalUartDriver.
+	 * Avec une broche DE (RS-485), TC est traité en premier pour relâcher la ligne au plus tôt.
+	 **/
+	template <UartConfigPolicy config>
+	struct UartIrq {
+		static constexpr IRQn_Type Irq = HalUartDriver::Irq(config::Port);
+
+		static inline void isr() {
+			if constexpr (UartDeControl<config>::Enabled)
+				UartDeControl<config>::on_irq();
+			HAL_UART_IRQHandler(HalUartDriver::handle(config::Port));
+		}
+	};
+
+	/*
+	 * @brief Liaison du stream DMA de réception continue d'un port UART (UartStatic::start_rx_stream).
+	 **/
+	template <UartConfigPolicy config>
+	struct UartRxDmaIrq {
+		static constexpr IRQn_Type Irq = HalUartDriver::RxDmaStream(config::Port).irq;
+
+		static inline void isr() {
+			HAL_DMA_IRQHandler(HalUartDriver::rx_dma_handle(config::Port));
+		}
+	};
+
+	/*
+	 * @brief Liaison du stream DMA d'émission en file d'un port UART (UartStatic::send).
+	 **/
+	template <UartConfigPolicy config>
+	struct UartTxDmaIrq : UartTxQueue<config::Port> {};
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+	/*
+	 * @brief Liaison du vecteur d'un port SPI.
+	 **/
+	template <SpiConfigPolicy config>
+	struct SpiIrq {
+		static constexpr IRQn_Type Irq = HalSpiDriver::Irq(config::Port);
+
+		static inline void isr() {
+			HAL_SPI_IRQHandler(HalSpiDriver::handle(config::Port));
+		}
+	};
+
+	/*
+	 * @brief Liaison du stream DMA de réception du flux continu d'un port SPI (SpiStatic::start_stream).
+	 **/
+	template <SpiConfigPolicy config>
+	struct SpiStreamDmaIrq : HalSpiStreamDma<config::Port> {
+		static_assert(config::TransferMode == SpiTransferMode::DmaStream, "SpiStreamDmaIrq : le port doit être en SpiTransferMode::DmaStream");
+	};
+
+	// Stream d'émission du flux continu : erreurs de transfert (sinon flux figé sans erreur)
+	template <SpiConfigPolicy config>
+	struct SpiStreamDmaTxIrq {
+		static_assert(config::TransferMode == SpiTransferMode::DmaStream, "SpiStreamDmaTxIrq : le port doit être en SpiTransferMode::DmaStream");
+		static constexpr IRQn_Type Irq = HalSpiStreamDma<config::Port>::TxIrq;
+
+		static inline void isr() {
+			HalSpiStreamDma<config::Port>::tx_isr();
+		}
+	};
+
+	/*
+	 * @brief Liaison des streams DMA de réception et d'émission d'un bus SPI partagé (SpiBus).
+	 **/
+	template <SpiConfigPolicy config>
+	struct SpiBusDmaIrq : SpiBus<config> {};
+
+	template <SpiConfigPolicy config>
+	struct SpiBusDmaTxIrq {
+		static constexpr IRQn_Type Irq = SpiBus<config>::TxIrq;
+
+		static inline void isr() {
+			SpiBus<config>::tx_isr();
+		}
+	};
+#endif
+
+#ifdef HAL_I2C_MODULE_ENABLED
+	/*
+	 * @brief Liaison des vecteurs événement (EV) et erreur (ER) d'un port I2C.
+	 **/
+	template <I2cConfigPolicy config>
+	struct I2cEventIrq {
+		static constexpr IRQn_Type Irq = HalI2cDriver::EventIrq(config::Port);
+
+		static inline void isr() {
+			HAL_I2C_EV_IRQHandler(HalI2cDriver::handle(config::Port));
+		}
+	};
+
+	template <I2cConfigPolicy config>
+	struct I2cErrorIrq {
+		static constexpr IRQn_Type Irq = HalI2cDriver::ErrorIrq(config::Port);
+
+		static inline void isr() {
+			HAL_I2C_ER_IRQHandler(HalI2cDriver::handle(config::Port));
+		}
+	};
+
+	/*
+	 * @brief Liaison des streams DMA d'émission et de réception d'un port I2C (I2cScheduler).
+	 **/
+	template <I2cConfigPolicy config>
+	struct I2cTxDmaIrq {
+		static constexpr IRQn_Type Irq = HalI2cDriver::TxDmaStream(config::Port).irq;
+
+		static inline void isr() {
+			HAL_DMA_IRQHandler(HalI2cDriver::tx_dma_handle(config::Port));
+		}
+	};
+
+	template <I2cConfigPolicy config>
+	struct I2cRxDmaIrq {
+		static constexpr IRQn_Type Irq = HalI2cDriver::RxDmaStream(config::Port).irq;
+
+		static inline void isr() {
+			HAL_DMA_IRQHandler(HalI2cDriver::rx_dma_handle(config::Port));
+		}
+	};
+
+	/*
+	 * @brief Liaison des vecteurs événement (EV) et erreur (ER) d'un port I2C en esclave (I2cSlave).
+	 **/
+	template <I2cConfigPolicy config, typename Map>
+	struct I2cSlaveEventIrq {
+		static constexpr IRQn_Type Irq = HalI2cDriver::EventIrq(config::Port);
+
+		static inline void isr() {
+			I2cSlave<config, Map>::event_isr();
+		}
+	};
+
+	template <I2cConfigPolicy config, typename Map>
+	struct I2cSlaveErrorIrq {
+		static constexpr IRQn_Type Irq = HalI2cDriver::ErrorIrq(config::Port);
+
+		static inline void isr() {
+			I2cSlave<config, Map>::error_isr();
+		}
+	};
+#endif
+
+} // namespace Wrapper
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "ModbusEnumsStructs.hpp"
+#include "Callback.hpp"
+
+using namespace Hal;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Maître Modbus : une transaction à la fois, non bloquante.
+	 * La requête part par DMA ; l'attente de réponse démarre quand le DMA a lu la trame (+ 2 caractères
+	 * encore dans l'USART) ; la réponse est validée dans l'ISR de fin de trame de la liaison, les
+	 * registres lus sont copiés dans le tableau de l'appelant, puis done(ModbusResult) est appelé
+	 * depuis l'ISR. Requête vers l'adresse 0 (diffusion, écritures) : done est appelé dès l'émission.
+	 *
+	 *   using Master = ModbusMaster<Bus>;
+	 *   Master::start();
+	 *   Master::read_holding(17, 100, 4, values, Callback<ModbusResult>::from<&on_done>());
+	 *
+	 * @tparam Link ModbusRtuLink
+	 **/
+	template <typename Link>
+	class ModbusMaster {
+	public:
+		static constexpr uint32_t DefaultTimeoutUs = 100000;
+
+		static HAL_StatusTypeDef start(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			m_busy.store(false, std::memory_order_relaxed);
+			return Link::start(Callback<std::span<const uint8_t>>::template from<&ModbusMaster::on_frame>(),
+				Callback<>::template from<&ModbusMaster::on_timeout>(),
+				Callback<>::template from<&ModbusMaster::on_sent>(),
+				preemptPriority, subPriority);
+		}
+
+		static bool busy() {
+			return m_busy.load(std::memory_order_acquire);
+		}
+
+		// 0x03 : count registres (1..125) vers out, qui doit rester valide jusqu'à done
+		static bool read_holding(uint8_t slave, uint16_t address, uint16_t count, uint16_t* out, Callback<ModbusResult> done, uint32_t timeoutUs = DefaultTimeoutUs) {
+			return read(ModbusFunction::ReadHoldingRegisters, slave, address, count, out, done, timeoutUs);
+		}
+
+		// 0x04
+		static bool read_input(uint8_t slave, uint16_t address, uint16_t count, uint16_t* out, Callback<ModbusResult> done, uint32_t timeoutUs = DefaultTimeoutUs) {
+			return read(ModbusFunction::ReadInputRegisters, slave, address, count, out, done, timeoutUs);
+		}
+
+		// 0x06
+		static bool write_single(uint8_t slave, uint16_t address, uint16_t value, Callback<ModbusResult> done, uint32_t timeoutUs = DefaultTimeoutUs) {
+			if (!acquire())
+				return false;
+			uint8_t* frame = Link::tx_buffer().data();
+			header(frame, slave, ModbusFunction::WriteSingleRegister, address, value);
+			return submit(slave, ModbusFunction::WriteSingleRegister, 6, nullptr, 0, done, timeoutUs);
+		}
+
+		// 0x10 : count registres (1..123)
+		static bool write_multiple(uint8_t slave, uint16_t address, const uint16_t* values, uint16_t count, Callback<ModbusResult> done, uint32_t timeoutUs = DefaultTimeoutUs) {
+			if (count == 0 || count > 123 || !acquire())
+				return false;
+			uint8_t* frame = Link::tx_buffer().data();
+			header(frame, slave, ModbusFunction::WriteMultipleRegisters, address, count);
+			frame[6] = static_cast<uint8_t>(count * 2u);
+			for (uint16_t i = 0; i < count; ++i)
+				put16(&frame[7 + 2 * i], values[i]);
+			return submit(slave, ModbusFunction::WriteMultipleRegisters, 7u + count * 2u, nullptr, 0, done, timeoutUs);
+		}
+
+	private:
+		static bool read(ModbusFunction function, uint8_t slave, uint16_t address, uint16_t count, uint16_t* out, Callback<ModbusResult> done, uint32_t timeoutUs) {
+			if (slave == 0 || count == 0 || count > 125 || !acquire())
+				return false;
+			header(Link::tx_buffer().data(), slave, function, address, count);
+			return submit(slave, function, 6, out, count, done, timeoutUs);
+		}
+
+		static bool acquire() {
+			if (m_busy.exchange(true, std::memory_order_acquire))
+				return false;
+			if (Link::busy()) {
+				m_busy.store(false, std::memory_order_release);
+				return false;
+			}
+			return true;
+		}
+
+		static bool submit(uint8_t slave, ModbusFunction function, size_t length, uint16_t* out, uint16_t count, Callback<ModbusResult> done, uint32_t timeoutUs) {
+			m_slave = slave;
+			m_function = static_cast<uint8_t>(function);
+			m_out = out;
+			m_count = count;
+			m_done = done;
+			m_timeoutUs = timeoutUs + 2u * Link::CharUs;
+			if (!Link::transmit(length)) {
+				m_busy.store(false, std::memory_order_release);
+				return false;
+			}
+			return true;
+		}
+
+		static void header(uint8_t* frame, uint8_t slave, ModbusFunction function, uint16_t address, uint16_t value) {
+			frame[0] = slave;
+			frame[1] = static_cast<uint8_t>(function);
+			put16(&frame[2], address);
+			put16(&frame[4], value);
+		}
+
+		static inline void put16(uint8_t* p, uint16_t value) {
+			p[0] = static_cast<uint8_t>(value >> 8);
+			p[1] = static_cast<uint8_t>(value);
+		}
+
+		static void finish(ModbusStatus status, ModbusException exception = ModbusException::None) {
+			const Callback<ModbusResult> done = m_done;
+			m_busy.store(false, std::memory_order_release);
+			done(ModbusResult { status, exception });
+		}
+
+		// ISR DMA : requête partie
+		static void on_sent() {
+			if (!busy())
+				return;
+			if (m_slave == 0)
+				finish(ModbusStatus::Ok);
+			else
+				Link::arm_timeout(m_timeoutUs);
+		}
+
+		static void on_timeout() {
+			if (busy())
+				finish(ModbusStatus::Timeout);
+		}
+
+		// ISR de fin de trame : réponse (adresse + PDU, CRC vérifié)
+		static void on_frame(std::span<const uint8_t> adu) {
+			if (!busy())
+				return;
+			if (adu.size() < 3 || adu[0] != m_slave || (adu[1] & 0x7Fu) != m_function) {
+				finish(ModbusStatus::BadResponse);
+				return;
+			}
+			if (adu[1] & 0x80u) {
+				finish(ModbusStatus::Exception, static_cast<ModbusException>(adu[2]));
+				return;
+			}
+			if (m_out != nullptr) {
+				if (adu[2] != m_count * 2u || adu.size() != 3u + m_count * 2u) {
+					finish(ModbusStatus::BadResponse);
+					return;
+				}
+				for (uint16_t i = 0; i < m_count; ++i)
+					m_out[i] = static_cast<uint16_t>((adu[3 + 2 * i] << 8) | adu[4 + 2 * i]);
+			}
+			finish(ModbusStatus::Ok);
+		}
+
+		inline static std::atomic<bool> m_busy { false };
+		inline static uint8_t m_slave = 0;
+		inline static uint8_t m_function = 0;
+		inline static uint16_t* m_out = nullptr;
+		inline static uint16_t m_count = 0;
+		inline static uint32_t m_timeoutUs = 0;
+		inline static Callback<ModbusResult> m_done {};
+	};
+
+} // namespace Wrapper
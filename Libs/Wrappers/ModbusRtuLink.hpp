@@ -0,0 +1,284 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include "ModbusEnumsStructs.hpp"
+#include "UartStatic.hpp"
+#include "TickTimerDriver.hpp"
+#include "Callback.hpp"
+
+using namespace Hal;
+
+namespace Wrapper {
+
+	/*
+	 * @brief CRC-16 Modbus (polynôme réfléchi 0xA001, init 0xFFFF), par table de 256 entrées en flash.
+	 * L'unité CRC du STM32F4 ne fait que du CRC-32 : calcul logiciel, ~5 cycles par octet.
+	 **/
+	struct ModbusCrc {
+		static constexpr std::array<uint16_t, 256> Table = [] {
+			std::array<uint16_t, 256> table {};
+			for (uint32_t i = 0; i < 256; ++i) {
+				uint16_t crc = static_cast<uint16_t>(i);
+				for (int bit = 0; bit < 8; ++bit)
+					crc = (crc & 1u) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001u) : static_cast<uint16_t>(crc >> 1);
+				table[i] = crc;
+			}
+			return table;
+		}();
+
+		static constexpr uint16_t compute(const uint8_t* data, size_t size) {
+			uint16_t crc = 0xFFFFu;
+			for (size_t i = 0; i < size; ++i)
+				crc = static_cast<uint16_t>((crc >> 8) ^ Table[(crc ^ data[i]) & 0xFFu]);
+			return crc;
+		}
+	};
+
+	/*
+	 * @brief Liaison Modbus RTU : délimitation des trames par le matériel, émission DMA.
+	 *
+	 * Fin de trame (t3.5) : le STM32F4 n'a pas de timeout récepteur (RTOR), on combine donc
+	 *  - la détection de ligne inactive de l'USART (IDLE, un caractère de silence), sans IRQ par octet ;
+	 *  - un timer en mode un coup, lancé à IDLE pour les t3.5 - 1 caractère restants.
+	 * À l'échéance, si le DMA n'a reçu aucun octet depuis IDLE, la trame est complète : CRC vérifié,
+	 * puis on_frame est appelé directement dans l'ISR du timer (temps de retournement minimal).
+	 * Si des octets sont arrivés entre-temps, la trame a été coupée par un silence d'au moins un
+	 * caractère : elle est rejetée en entier (gapErrors). La résolution d'IDLE étant d'un caractère,
+	 * un silence entre t1.0 et t1.5 (toléré par la norme) est aussi rejeté.
+	 * Au-delà de 19200 bauds, t1.5 / t3.5 valent 750 / 1750 µs (recommandation Modbus).
+	 *
+	 *   using Bus = ModbusRtuLink<Rs485Config, PwmTimerInstance::TIM_14>;
+	 *   WRAPPER_BIND_IRQ(USART2, UartIrq<Rs485Config>)
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream5, UartRxDmaIrq<Rs485Config>)
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream6, UartTxDmaIrq<Rs485Config>)
+	 *   WRAPPER_BIND_IRQ(TIM8_TRG_COM_TIM14, TimerTickIrq<PwmTimerInstance::TIM_14, &Bus::on_timer>)
+	 *
+	 * Toutes ces IRQ doivent avoir la même priorité préemptive (start() les configure ainsi) :
+	 * l'état de la liaison est partagé entre elles sans verrou.
+	 *
+	 * @tparam config UartStaticConfig avec RxDmaBufferSize >= 512 (deux trames complètes)
+	 * @tparam timer  Timer libre utilisé en mode un coup (HalTickTimer)
+	 **/
+	template <UartConfigPolicy config, PwmTimerInstance timer>
+	class ModbusRtuLink {
+		static_assert(config::RxDmaBufferSize >= 512, "ModbusRtuLink : RxDmaBufferSize doit contenir au moins deux trames (512)");
+
+		using Uart = UartStatic<config>;
+		using Timer = HalTickTimer<timer>;
+
+	public:
+		static constexpr size_t MaxAdu = 256; // Adresse + PDU + CRC
+
+		// Durée d'un caractère RTU : 11 bits (start, 8 données, parité ou 2e stop, stop)
+		static constexpr uint32_t CharUs = (11u * 1000000u + config::BaudRate - 1u) / config::BaudRate;
+		static constexpr uint32_t T15Us = (config::BaudRate > 19200u) ? 750u : (3u * CharUs + 1u) / 2u;
+		static constexpr uint32_t T35Us = (config::BaudRate > 19200u) ? 1750u : (7u * CharUs + 1u) / 2u;
+		// IDLE tombe un caractère après le dernier octet
+		static constexpr uint32_t IdleToT35Us = (T35Us > CharUs) ? T35Us - CharUs : 1u;
+		static_assert(Timer::Is32Bit || IdleToT35Us <= 0x10000u, "ModbusRtuLink : t3.5 trop long pour un timer 16 bits");
+
+		/*
+		 * @brief Démarre la liaison (le port UART doit être initialisé).
+		 * on_frame : trame valide, adresse + PDU sans CRC (ISR du timer, donnée valide pendant l'appel)
+		 * on_timeout : échéance d'arm_timeout() sans trame valide reçue entre-temps
+		 * on_sent : trame entièrement lue par le DMA (ISR DMA)
+		 **/
+		static HAL_StatusTypeDef start(Callback<std::span<const uint8_t>> on_frame, Callback<> on_timeout = {}, Callback<> on_sent = {},
+			uint32_t preemptPriority = 0, uint32_t subPriority = 0)
+		{
+			m_onFrame = on_frame;
+			m_onTimeout = on_timeout;
+			m_onSent = on_sent;
+			m_frameTimer = false;
+			m_timeoutActive = false;
+			m_gapCorrupted = false;
+			m_txBusy.store(false, std::memory_order_relaxed);
+
+			Timer::init_one_shot(preemptPriority, subPriority);
+			Uart uart;
+			uart.start_tx_queue(preemptPriority, subPriority);
+			return uart.start_rx_stream(Callback<>::template from<&ModbusRtuLink::on_rx_event>(), preemptPriority, subPriority);
+		}
+
+		/*
+		 * @brief Tampon d'émission, pour construire une réponse sur place (sans copie) avant transmit().
+		 * Laisser 2 octets pour le CRC. Ne pas écrire pendant qu'une émission est en cours (busy()).
+		 **/
+		static std::span<uint8_t> tx_buffer() {
+			return { m_txBuffer.data(), MaxAdu - 2 };
+		}
+
+		/*
+		 * @brief Ajoute le CRC aux length premiers octets de tx_buffer() et les émet par DMA.
+		 * @return false si une émission est déjà en cours ou si length est invalide
+		 **/
+		static bool transmit(size_t length) {
+			if (length == 0 || length > MaxAdu - 2 || m_txBusy.exchange(true, std::memory_order_acquire))
+				return false;
+			const uint16_t crc = ModbusCrc::compute(m_txBuffer.data(), length);
+			m_txBuffer[length] = static_cast<uint8_t>(crc);
+			m_txBuffer[length + 1] = static_cast<uint8_t>(crc >> 8);
+			m_txFrame.data = m_txBuffer.data();
+			m_txFrame.size = static_cast<uint16_t>(length + 2);
+			m_txFrame.next = nullptr;
+			m_txFrame.release = Callback<UartTxDescriptor*>::template from<&ModbusRtuLink::on_tx_done>();
+			Uart uart;
+			uart.send(m_txFrame);
+			return true;
+		}
+
+		// Copie adu (adresse + PDU, sans CRC) dans le tampon d'émission puis l'émet
+		static bool send(std::span<const uint8_t> adu) {
+			if (adu.size() > MaxAdu - 2 || busy())
+				return false;
+			std::memcpy(m_txBuffer.data(), adu.data(), adu.size());
+			return transmit(adu.size());
+		}
+
+		static bool busy() {
+			return m_txBusy.load(std::memory_order_acquire);
+		}
+
+		/*
+		 * @brief Lance une attente de réponse de timeoutUs ; annulée par la prochaine trame reçue.
+		 * Les délais au-delà de la capacité du timer sont découpés.
+		 **/
+		static void arm_timeout(uint32_t timeoutUs) {
+			m_timeoutActive = true;
+			m_timeoutRemaining = timeoutUs;
+			if (!m_frameTimer)
+				arm_timeout_chunk();
+		}
+
+		static void cancel_timeout() {
+			m_timeoutActive = false;
+			if (!m_frameTimer)
+				Timer::disarm();
+		}
+
+		/*
+		 * @brief ISR du timer, à lier avec TimerTickIrq<timer, &ModbusRtuLink::on_timer>.
+		 **/
+		static void on_timer() {
+			if (!m_frameTimer) {
+				if (!m_timeoutActive)
+					return;
+				if (m_timeoutRemaining > 0) {
+					arm_timeout_chunk();
+					return;
+				}
+				m_timeoutActive = false;
+				m_onTimeout();
+				return;
+			}
+
+			m_frameTimer = false;
+			if (rx_position() != m_idlePosition) {
+				// Octets reçus après IDLE : silence > t1.0 au milieu d'une trame, rejetée à la fin de celle-ci
+				if (!m_gapCorrupted)
+					++m_stats.gapErrors;
+				m_gapCorrupted = true;
+				return;
+			}
+
+			const size_t size = collect();
+			const bool corrupted = m_gapCorrupted;
+			m_gapCorrupted = false;
+			if (corrupted || size == 0) {
+				frame_rejected();
+				return;
+			}
+			if (size < 4 || ModbusCrc::compute(m_rxFrame.data(), size) != 0) {
+				++m_stats.crcErrors; // Le CRC d'une trame valide, CRC compris, vaut 0
+				frame_rejected();
+				return;
+			}
+			++m_stats.frames;
+			m_timeoutActive = false;
+			m_onFrame(std::span<const uint8_t>(m_rxFrame.data(), size - 2));
+		}
+
+		static ModbusLinkStats stats() {
+			return m_stats;
+		}
+
+	private:
+		static constexpr uint32_t TimerMaxUs = Timer::Is32Bit ? 0xFFFFFFFFu : 0x10000u;
+
+		// ISR UART : seule la ligne inactive lance la mesure de t3.5
+		static void on_rx_event() {
+			if (HAL_UARTEx_GetRxEventType(HalUartDriver::handle(config::Port)) != HAL_UART_RXEVENT_IDLE)
+				return;
+			m_idlePosition = rx_position();
+			m_frameTimer = true;
+			Timer::arm(IdleToT35Us);
+		}
+
+		static void on_tx_done(UartTxDescriptor*) {
+			m_txBusy.store(false, std::memory_order_release);
+			m_onSent();
+		}
+
+		// Position d'écriture DMA courante (NDTR), y compris les octets pas encore publiés par un événement
+		static inline uint32_t rx_position() {
+			return HalUartDriver::rx_dma_handle(config::Port)->Instance->NDTR;
+		}
+
+		// Copie la trame (tout ce qui a été reçu) et libère le tampon DMA ; 0 si elle dépasse MaxAdu
+		static size_t collect() {
+			Uart uart;
+			size_t size = 0;
+			bool overflow = false;
+			for (auto chunk = uart.rx_peek(); !chunk.empty(); chunk = uart.rx_peek()) {
+				const size_t room = MaxAdu - size;
+				const size_t count = (chunk.size() < room) ? chunk.size() : room;
+				std::memcpy(m_rxFrame.data() + size, chunk.data(), count);
+				size += count;
+				overflow = overflow || (count < chunk.size());
+				uart.rx_consume(chunk.size());
+			}
+			if (overflow) {
+				++m_stats.overflows;
+				return 0;
+			}
+			return size;
+		}
+
+		// Une réponse attendue mais invalide termine l'attente : le maître n'a pas de réponse exploitable
+		static void frame_rejected() {
+			if (m_timeoutActive) {
+				m_timeoutActive = false;
+				m_onTimeout();
+			}
+		}
+
+		static void arm_timeout_chunk() {
+			const uint32_t chunk = (m_timeoutRemaining < TimerMaxUs) ? m_timeoutRemaining : TimerMaxUs;
+			m_timeoutRemaining -= chunk;
+			Timer::arm(chunk ? chunk : 1u);
+		}
+
+		inline static Callback<std::span<const uint8_t>> m_onFrame {};
+		inline static Callback<> m_onTimeout {};
+		inline static Callback<> m_onSent {};
+
+		// État partagé entre les ISR UART, DMA et timer (même priorité préemptive)
+		inline static bool m_frameTimer = false;     // Timer armé pour t3.5 (sinon : attente de réponse)
+		inline static bool m_gapCorrupted = false;
+		inline static bool m_timeoutActive = false;
+		inline static uint32_t m_timeoutRemaining = 0;
+		inline static uint32_t m_idlePosition = 0;
+		inline static ModbusLinkStats m_stats {};
+
+		alignas(4) inline static std::array<uint8_t, MaxAdu> m_rxFrame {};
+		alignas(4) inline static std::array<uint8_t, MaxAdu> m_txBuffer {};
+		inline static UartTxDescriptor m_txFrame {};
+		inline static std::atomic<bool> m_txBusy { false };
+	};
+
+} // namespace Wrapper
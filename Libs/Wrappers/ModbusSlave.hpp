@@ -0,0 +1,298 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "ModbusEnumsStructs.hpp"
+#include "Callback.hpp"
+
+using namespace Hal;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Tables de données d'un esclave, déclarées à la compilation : plage d'adresses contiguë
+	 * [Start, Start + Count) et stockage statique. Count = 0 : table absente, ses codes fonction
+	 * répondent IllegalFunction.
+	 * L'application lit / écrit directement values / bits ; un mot 16 bits est écrit atomiquement,
+	 * la cohérence d'un groupe de registres n'est pas garantie vis-à-vis d'une requête en cours.
+	 **/
+	template <uint16_t Start, uint16_t Count>
+	struct ModbusRegisters {
+		static constexpr uint16_t First = Start;
+		static constexpr uint16_t Size = Count;
+
+		static constexpr bool contains(uint16_t address, uint16_t count) {
+			return count != 0 && address >= Start && static_cast<uint32_t>(address - Start) + count <= Count;
+		}
+
+		inline static std::array<uint16_t, Count> values {};
+	};
+
+	template <uint16_t Start, uint16_t Count>
+	struct ModbusBits {
+		static constexpr uint16_t First = Start;
+		static constexpr uint16_t Size = Count;
+
+		static constexpr bool contains(uint16_t address, uint16_t count) {
+			return count != 0 && address >= Start && static_cast<uint32_t>(address - Start) + count <= Count;
+		}
+
+		static inline bool get(uint16_t index) {
+			return (bits[index >> 3] >> (index & 7u)) & 1u;
+		}
+
+		static inline void set(uint16_t index, bool value) {
+			const uint8_t mask = static_cast<uint8_t>(1u << (index & 7u));
+			bits[index >> 3] = value ? static_cast<uint8_t>(bits[index >> 3] | mask) : static_cast<uint8_t>(bits[index >> 3] & ~mask);
+		}
+
+		inline static std::array<uint8_t, (Count + 7u) / 8u> bits {};
+	};
+
+	using ModbusNoRegisters = ModbusRegisters<0, 0>;
+	using ModbusNoBits = ModbusBits<0, 0>;
+
+	/*
+	 * @brief Carte de registres d'un esclave.
+	 *
+	 *   using Map = ModbusRegisterMap<ModbusBits<0, 16>, ModbusNoBits, ModbusRegisters<100, 32>, ModbusRegisters<0, 8>>;
+	 *   Map::Holding::values[0] = setpoint;
+	 **/
+	template <typename CoilTable, typename DiscreteTable, typename HoldingTable, typename InputTable>
+	struct ModbusRegisterMap {
+		using Coils = CoilTable;
+		using DiscreteInputs = DiscreteTable;
+		using Holding = HoldingTable;
+		using Input = InputTable;
+	};
+
+	/*
+	 * @brief Esclave Modbus : répond depuis l'ISR de fin de trame de la liaison (ModbusRtuLink), la
+	 * réponse est construite directement dans le tampon d'émission.
+	 * Aiguillage : table de 128 pointeurs de fonction indexée par le code fonction, construite à la
+	 * compilation d'après les tables présentes dans Map. Aucune recherche à l'exécution.
+	 * Adresse 0 (diffusion) : les écritures sont exécutées, sans réponse.
+	 *
+	 *   using Slave = ModbusSlave<Bus, Map, 17>;
+	 *   Slave::start(Callback<ModbusTable, uint16_t, uint16_t>::from<&on_write>());
+	 *
+	 * @tparam Link    ModbusRtuLink
+	 * @tparam Map     ModbusRegisterMap
+	 * @tparam Address Adresse de l'esclave (1..247)
+	 **/
+	template <typename Link, typename Map, uint8_t Address>
+	class ModbusSlave {
+		static_assert(Address >= 1 && Address <= 247, "ModbusSlave : adresse hors 1..247");
+
+		using Coils = typename Map::Coils;
+		using Discrete = typename Map::DiscreteInputs;
+		using Holding = typename Map::Holding;
+		using Input = typename Map::Input;
+
+		// Taille de la réponse (adresse + PDU), ou 0 pour une exception (code dans m_exception)
+		using Handler = size_t (*)(std::span<const uint8_t> request, std::span<uint8_t> response);
+
+	public:
+		/*
+		 * @brief Démarre la liaison en esclave. on_write(table, adresse, nombre) est appelé depuis l'ISR
+		 * après chaque écriture du maître (bobines ou registres de maintien).
+		 **/
+		static HAL_StatusTypeDef start(Callback<ModbusTable, uint16_t, uint16_t> on_write = {}, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			m_onWrite = on_write;
+			return Link::start(Callback<std::span<const uint8_t>>::template from<&ModbusSlave::on_frame>(), {}, {}, preemptPriority, subPriority);
+		}
+
+		// Requêtes traitées (y compris celles terminées en exception) et exceptions renvoyées
+		static uint32_t requests() {
+			return m_requests;
+		}
+
+		static uint32_t exceptions() {
+			return m_exceptions;
+		}
+
+		/*
+		 * @brief Traite une trame (adresse + PDU, CRC déjà vérifié). Appelé par la liaison.
+		 **/
+		static void on_frame(std::span<const uint8_t> adu) {
+			const uint8_t address = adu[0];
+			if ((address != Address && address != 0) || adu.size() < 2)
+				return;
+			const bool broadcast = (address == 0);
+			if (Link::busy())
+				return; // Réponse précédente encore en cours d'émission : le maître réessaiera
+
+			++m_requests;
+			const uint8_t function = adu[1];
+			const std::span<uint8_t> response = Link::tx_buffer();
+			response[0] = Address;
+			response[1] = function;
+
+			m_exception = ModbusException::IllegalFunction;
+			const Handler handler = (function < Dispatch.size()) ? Dispatch[function] : nullptr;
+			size_t length = handler ? handler(adu.subspan(2), response) : 0;
+			if (broadcast)
+				return;
+			if (length == 0) {
+				++m_exceptions;
+				response[1] = static_cast<uint8_t>(function | 0x80u);
+				response[2] = static_cast<uint8_t>(m_exception);
+				length = 3;
+			}
+			Link::transmit(length);
+		}
+
+	private:
+		static constexpr uint16_t be16(const uint8_t* p) {
+			return static_cast<uint16_t>((p[0] << 8) | p[1]);
+		}
+
+		static inline void put16(uint8_t* p, uint16_t value) {
+			p[0] = static_cast<uint8_t>(value >> 8);
+			p[1] = static_cast<uint8_t>(value);
+		}
+
+		static size_t fail(ModbusException exception) {
+			m_exception = exception;
+			return 0;
+		}
+
+		// 0x01 / 0x02
+		template <typename Table, uint16_t MaxCount>
+		static size_t read_bits(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			if (pdu.size() != 4)
+				return fail(ModbusException::IllegalDataValue);
+			const uint16_t address = be16(&pdu[0]);
+			const uint16_t count = be16(&pdu[2]);
+			if (count == 0 || count > MaxCount)
+				return fail(ModbusException::IllegalDataValue);
+			if (!Table::contains(address, count))
+				return fail(ModbusException::IllegalDataAddress);
+			const uint8_t bytes = static_cast<uint8_t>((count + 7u) / 8u);
+			response[2] = bytes;
+			for (uint8_t i = 0; i < bytes; ++i)
+				response[3 + i] = 0;
+			const uint16_t first = static_cast<uint16_t>(address - Table::First);
+			for (uint16_t i = 0; i < count; ++i)
+				if (Table::get(static_cast<uint16_t>(first + i)))
+					response[3 + (i >> 3)] = static_cast<uint8_t>(response[3 + (i >> 3)] | (1u << (i & 7u)));
+			return 3u + bytes;
+		}
+
+		// 0x03 / 0x04
+		template <typename Table>
+		static size_t read_registers(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			if (pdu.size() != 4)
+				return fail(ModbusException::IllegalDataValue);
+			const uint16_t address = be16(&pdu[0]);
+			const uint16_t count = be16(&pdu[2]);
+			if (count == 0 || count > 125)
+				return fail(ModbusException::IllegalDataValue);
+			if (!Table::contains(address, count))
+				return fail(ModbusException::IllegalDataAddress);
+			response[2] = static_cast<uint8_t>(count * 2u);
+			const uint16_t* values = Table::values.data() + (address - Table::First);
+			for (uint16_t i = 0; i < count; ++i)
+				put16(&response[3 + 2 * i], values[i]);
+			return 3u + count * 2u;
+		}
+
+		// 0x05
+		static size_t write_single_coil(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			if (pdu.size() != 4)
+				return fail(ModbusException::IllegalDataValue);
+			const uint16_t address = be16(&pdu[0]);
+			const uint16_t value = be16(&pdu[2]);
+			if (value != 0xFF00u && value != 0x0000u)
+				return fail(ModbusException::IllegalDataValue);
+			if (!Coils::contains(address, 1))
+				return fail(ModbusException::IllegalDataAddress);
+			Coils::set(static_cast<uint16_t>(address - Coils::First), value == 0xFF00u);
+			m_onWrite(ModbusTable::Coils, address, 1);
+			return echo(pdu, response);
+		}
+
+		// 0x06
+		static size_t write_single_register(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			if (pdu.size() != 4)
+				return fail(ModbusException::IllegalDataValue);
+			const uint16_t address = be16(&pdu[0]);
+			if (!Holding::contains(address, 1))
+				return fail(ModbusException::IllegalDataAddress);
+			Holding::values[address - Holding::First] = be16(&pdu[2]);
+			m_onWrite(ModbusTable::HoldingRegisters, address, 1);
+			return echo(pdu, response);
+		}
+
+		// 0x0F
+		static size_t write_multiple_coils(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			if (pdu.size() < 5)
+				return fail(ModbusException::IllegalDataValue);
+			const uint16_t address = be16(&pdu[0]);
+			const uint16_t count = be16(&pdu[2]);
+			const uint8_t bytes = pdu[4];
+			if (count == 0 || count > 0x7B0u || bytes != (count + 7u) / 8u || pdu.size() != 5u + bytes)
+				return fail(ModbusException::IllegalDataValue);
+			if (!Coils::contains(address, count))
+				return fail(ModbusException::IllegalDataAddress);
+			const uint16_t first = static_cast<uint16_t>(address - Coils::First);
+			for (uint16_t i = 0; i < count; ++i)
+				Coils::set(static_cast<uint16_t>(first + i), (pdu[5 + (i >> 3)] >> (i & 7u)) & 1u);
+			m_onWrite(ModbusTable::Coils, address, count);
+			return echo(pdu.first(4), response);
+		}
+
+		// 0x10
+		static size_t write_multiple_registers(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			if (pdu.size() < 5)
+				return fail(ModbusException::IllegalDataValue);
+			const uint16_t address = be16(&pdu[0]);
+			const uint16_t count = be16(&pdu[2]);
+			const uint8_t bytes = pdu[4];
+			if (count == 0 || count > 123 || bytes != count * 2u || pdu.size() != 5u + bytes)
+				return fail(ModbusException::IllegalDataValue);
+			if (!Holding::contains(address, count))
+				return fail(ModbusException::IllegalDataAddress);
+			uint16_t* values = Holding::values.data() + (address - Holding::First);
+			for (uint16_t i = 0; i < count; ++i)
+				values[i] = be16(&pdu[5 + 2 * i]);
+			m_onWrite(ModbusTable::HoldingRegisters, address, count);
+			return echo(pdu.first(4), response);
+		}
+
+		// Réponse = adresse, fonction, 4 premiers octets de la requête
+		static size_t echo(std::span<const uint8_t> pdu, std::span<uint8_t> response) {
+			for (size_t i = 0; i < 4; ++i)
+				response[2 + i] = pdu[i];
+			return 6;
+		}
+
+		static constexpr std::array<Handler, 128> Dispatch = [] {
+			std::array<Handler, 128> table {};
+			if constexpr (Coils::Size > 0) {
+				table[static_cast<uint8_t>(ModbusFunction::ReadCoils)] = &read_bits<Coils, 2000>;
+				table[static_cast<uint8_t>(ModbusFunction::WriteSingleCoil)] = &write_single_coil;
+				table[static_cast<uint8_t>(ModbusFunction::WriteMultipleCoils)] = &write_multiple_coils;
+			}
+			if constexpr (Discrete::Size > 0)
+				table[static_cast<uint8_t>(ModbusFunction::ReadDiscreteInputs)] = &read_bits<Discrete, 2000>;
+			if constexpr (Holding::Size > 0) {
+				table[static_cast<uint8_t>(ModbusFunction::ReadHoldingRegisters)] = &read_registers<Holding>;
+				table[static_cast<uint8_t>(ModbusFunction::WriteSingleRegister)] = &write_single_register;
+				table[static_cast<uint8_t>(ModbusFunction::WriteMultipleRegisters)] = &write_multiple_registers;
+			}
+			if constexpr (Input::Size > 0)
+				table[static_cast<uint8_t>(ModbusFunction::ReadInputRegisters)] = &read_registers<Input>;
+			return table;
+		}();
+
+		inline static Callback<ModbusTable, uint16_t, uint16_t> m_onWrite {};
+		inline static ModbusException m_exception = ModbusException::None;
+		inline static uint32_t m_requests = 0;
+		inline static uint32_t m_exceptions = 0;
+	};
+
+} // namespace Wrapper
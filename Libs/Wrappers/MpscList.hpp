@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+
+namespace Wrapper {
+
+	/*
+	 * @brief Liste intrusive sans verrou, plusieurs producteurs / un seul consommateur (threads -> ISR).
+	 * push() est un seul compare-exchange (LDREX/STREX) : utilisable depuis n'importe quel thread ou ISR.
+	 * Le consommateur retire tout d'un coup (exchange) puis remet la chaîne dans l'ordre d'arrivée :
+	 * pas de retrait élément par élément, donc pas de problème ABA ni d'état intermédiaire incohérent.
+	 *
+	 * @tparam Node Type d'élément
+	 * @tparam Link Pointeur de membre vers le champ de chaînage (réservé à la liste tant que l'élément y est)
+	 **/
+	template <typename Node, Node* Node::*Link>
+	class MpscList {
+		static_assert(std::atomic<Node*>::is_always_lock_free, "MpscList : atomiques pointeur requis");
+
+	public:
+		// --- Côté producteurs ---
+		void push(Node* node) {
+			Node* head = m_head.load(std::memory_order_relaxed);
+			do {
+				node->*Link = head;
+			} while (!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		// --- Côté consommateur ---
+		// Retire tous les éléments, le plus ancien en tête (chaînés par Link, dernier à nullptr)
+		Node* take_all() {
+			Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+			Node* ordered = nullptr;
+			while (node) {
+				Node* next = node->*Link;
+				node->*Link = ordered;
+				ordered = node;
+				node = next;
+			}
+			return ordered;
+		}
+
+		bool empty() const {
+			return m_head.load(std::memory_order_acquire) == nullptr;
+		}
+
+	private:
+		std::atomic<Node*> m_head { nullptr };
+	};
+
+} // namespace Wrapper
@@ -14,7 +14,7 @@ using namespace WrapperBase;
 
 namespace Wrapper {
 
-	template<PwmConfigPolicy config, typename Driver = HalPwmDriver, typename GpioDriver = HalGpioDriver>
+	template<PwmConfigPolicy config, PwmDriverConcept Driver = HalPwmDriver, GpioDriverConcept GpioDriver = HalGpioDriver>
 		class PwmStatic {
 		public:
 			PwmStatic() = default;
@@ -27,12 +27,20 @@ namespace Wrapper {
 				// 1. Initialiser la broche GPIO
 				// Nous créons une instance temporaire de GpioStatic avec la politique
 				// GPIO fournie dans notre configuration PWM.
-				GpioStatic<config::GpioPolicy, GpioDriver> gpio_pin;
+				GpioStatic<typename config::GpioPolicy, GpioDriver> gpio_pin;
 				gpio_pin.init();
 
 				// 2. Initialiser le driver PWM (Timer + Canal)
 				driver.template init<config>();
 			}
+
+			/**
+			 * @brief Initialise uniquement le timer et le canal PWM.
+			 * Broche et horloge doivent déjà être configurées (ex: par BoardInit).
+			 */
+			void init_peripheral() {
+				driver.template init_peripheral<config>();
+			}
         
 			/**
 			 * @brief Démarre la génération du signal PWM sur le canal.
@@ -101,7 +109,7 @@ namespace Wrapper {
 			}
 
 		private:
-			Driver driver;
+			[[no_unique_address]] Driver driver;
 		};
 
 } //namespace Wrapper
\ No newline at end of file
@@ -0,0 +1,334 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "SpiEnumsStructs.hpp"
+#include "SpiConfigPolicy.hpp"
+#include "SpiDriver.hpp"
+#include "SpiDmaDriver.hpp"
+#include "GpioStatic.hpp"
+#include "Callback.hpp"
+#include "MpscList.hpp"
+#include "Semaphore.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Réglages d'un périphérique résolus à la compilation (SpiDevice<Dev>::Info) :
+	 * valeur de CR1 et écriture BSRR du chip select.
+	 **/
+	struct SpiDeviceInfo {
+		uint32_t cr1;
+		uint32_t csBsrr; // Adresse de GPIOx->BSRR
+		uint32_t csMask;
+	};
+
+	/*
+	 * @brief Segment d'une transaction : frames trames échangées par DMA, sans copie.
+	 * tx nul : 0xFF émis ; rx nul : réception ignorée. Trames de 8 ou 16 bits selon le périphérique.
+	 **/
+	struct SpiSegment {
+		const void* tx = nullptr;
+		void* rx = nullptr;
+		uint16_t frames = 0;
+		SpiSegment* next = nullptr;
+	};
+
+	/*
+	 * @brief Transaction : CS activé, segments enchaînés, CS relâché, puis done(transaction) depuis l'ISR.
+	 * La transaction, ses segments et leurs tampons appartiennent au bus entre submit() et done (pending).
+	 **/
+	struct SpiTransaction {
+		const SpiDeviceInfo* device = nullptr;
+		SpiSegment* segments = nullptr;
+		Callback<SpiTransaction*> done {};
+		volatile bool ok = false;      // Renseigné avant done : faux après une erreur de transfert DMA
+		volatile bool pending = false; // Vrai de submit() jusqu'à done
+
+		SpiTransaction* queueLink = nullptr; // Réservé à la file
+	};
+
+	/*
+	 * @brief Compteurs du bus (instantané).
+	 * reconfigurations : écritures de CR1, seulement quand deux transactions successives changent de réglages.
+	 **/
+	struct SpiBusStats {
+		uint32_t depth;
+		uint32_t maxDepth;
+		uint32_t transactions;
+		uint32_t reconfigurations;
+		uint32_t errors;
+	};
+
+	/*
+	 * @brief Périphérique d'un bus partagé : réglages propres et chip select.
+	 **/
+	template <SpiDeviceConfigPolicy Dev>
+	struct SpiDevice {
+		static constexpr SpiDeviceInfo Info {
+			SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI
+				| HalSpiDriver::MapPrescaler(Dev::Prescaler)
+				| HalSpiDriver::MapClockPolarity(Dev::ClockPolarity)
+				| HalSpiDriver::MapClockPhase(Dev::ClockPhase)
+				| HalSpiDriver::MapFirstBit(Dev::FirstBit)
+				| HalSpiDriver::MapDataSize(Dev::DataSize),
+			HalGpioDriver::MapPortBase(Dev::CsPin::Port) + offsetof(GPIO_TypeDef, BSRR),
+			Dev::CsPin::PinMask,
+		};
+
+		// Chip select en sortie, relâché (haut)
+		static void init() {
+			GpioStatic<typename Dev::CsPin> cs;
+			cs.init();
+			cs.set_high();
+		}
+	};
+
+	/*
+	 * @brief Bus SPI maître partagé par plusieurs périphériques, chacun avec ses réglages et son CS.
+	 * Les transactions sont mises en file sans verrou (depuis plusieurs threads) et enchaînées par l'ISR
+	 * du stream DMA de réception : segment suivant, CS, transaction suivante, sans retour au thread.
+	 * CR1 n'est réécrit que si le périphérique suivant a d'autres réglages ; HAL_SPI_Init n'est jamais appelé.
+	 *
+	 *   using Bus = SpiBus<Spi1Config>;
+	 *   using Flash = SpiDevice<SpiDeviceConfig<FlashCs, ..., SpiBaudRatePrescaler::Prescaler2>>;
+	 *   WRAPPER_BIND_IRQ(DMA2_Stream0, SpiBusDmaIrq<Spi1Config>)
+	 *   WRAPPER_BIND_IRQ(DMA2_Stream3, SpiBusDmaTxIrq<Spi1Config>)
+	 *   Bus::init(); Flash::init();
+	 *
+	 *   uint8_t cmd[4] = { 0x03, a2, a1, a0 };
+	 *   SpiSegment data { nullptr, page, 256 };
+	 *   SpiSegment head { cmd, nullptr, 4, &data };
+	 *   SpiTransaction read { &Flash::Info, &head };
+	 *   Bus::transfer(read, done_semaphore);   // bloque le thread jusqu'à la fin de la transaction
+	 *
+	 * @tparam config Port et broches SCK/MISO/MOSI ; maître, full-duplex, NSS logiciel, mode Standard.
+	 * Les réglages d'horloge de config ne servent qu'au repos, avant la première transaction.
+	 * @note Le port est piloté par registres : ne pas utiliser SpiStatic sur le même port.
+	 **/
+	template <SpiConfigPolicy config>
+	class SpiBus {
+		static_assert(config::Mode == SpiMode::Master && config::Direction == SpiDirection::FullDuplex,
+			"SpiBus : port maître full-duplex requis");
+		static_assert(config::Nss == SpiNssMode::Software && std::is_void_v<typename config::NssPin>,
+			"SpiBus : chaque périphérique porte son CS (SpiDeviceConfig), NSS doit être logiciel");
+		static_assert(config::TransferMode == SpiTransferMode::Standard,
+			"SpiBus : le flux continu (DmaStream) réserve le port, incompatible avec un bus partagé");
+
+		using Dma = HalSpiBlockDma<config::Port>;
+
+	public:
+		static constexpr IRQn_Type Irq = Dma::Irq;
+		static constexpr IRQn_Type TxIrq = Dma::TxIrq;
+
+		/*
+		 * @brief Broches, horloges SPI / DMA, CR1 de repos. Priorité : celle de l'ISR qui réveille les threads
+		 * (FreeRTOS : numériquement >= configMAX_SYSCALL_INTERRUPT_PRIORITY).
+		 **/
+		static void init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			GpioStatic<typename config::SckPin>().init();
+			GpioStatic<typename config::MisoPin>().init();
+			GpioStatic<typename config::MosiPin>().init();
+			m_cr1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI
+				| HalSpiDriver::MapPrescaler(config::Prescaler)
+				| HalSpiDriver::MapClockPolarity(config::ClockPolarity)
+				| HalSpiDriver::MapClockPhase(config::ClockPhase)
+				| HalSpiDriver::MapFirstBit(config::FirstBit)
+				| HalSpiDriver::MapDataSize(config::DataSize);
+			Dma::init(m_cr1, preemptPriority, subPriority);
+		}
+
+		/*
+		 * @brief Met une transaction en file. Appelable depuis n'importe quel thread (ou ISR de priorité
+		 * inférieure ou égale au stream DMA). Ne bloque jamais ; done est appelé depuis l'ISR.
+		 **/
+		static void submit(SpiTransaction& transaction) {
+			transaction.ok = false;
+			transaction.pending = true;
+			const uint32_t depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+			uint32_t max = m_maxDepth.load(std::memory_order_relaxed);
+			while (depth > max && !m_maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {}
+
+			m_inbox.push(&transaction);
+			if (!m_busy.exchange(true, std::memory_order_acquire))
+				advance(nullptr);
+		}
+
+		/*
+		 * @brief Exécute une transaction et bloque le thread appelant jusqu'à sa fin, au plus timeoutMs par attente.
+		 * done de la transaction est remplacé par le réveil de semaphore (binaire, initialement pris,
+		 * un par thread appelant). Une transaction encore au bus après un délai écoulé est d'abord attendue
+		 * (wait), jamais soumise deux fois.
+		 * @return false sur erreur de transfert ou délai écoulé ; après un délai écoulé la transaction reste
+		 * au bus (pending) : ne pas la modifier ni réutiliser ses tampons avant que wait() renvoie true.
+		 **/
+		static bool transfer(SpiTransaction& transaction, Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = UINT32_MAX) {
+			if (!wait(transaction, semaphore, timeoutMs))
+				return false;
+			transaction.done = Callback<SpiTransaction*>(&wake, &semaphore);
+			submit(transaction);
+			return semaphore.take(timeoutMs) && wait(transaction, semaphore, timeoutMs) && transaction.ok;
+		}
+
+		/*
+		 * @brief Attend la fin d'une transaction lancée par transfer() sur semaphore, au plus timeoutMs par
+		 * réveil. Un réveil resté dans le sémaphore après un délai écoulé est consommé sans être pris pour
+		 * la fin de la transaction en cours : seul pending fait foi.
+		 * @return true si la transaction n'est plus au bus (ses tampons sont rendus)
+		 **/
+		static bool wait(const SpiTransaction& transaction, Rtos::Abstract::ISemaphore& semaphore, uint32_t timeoutMs = UINT32_MAX) {
+			while (transaction.pending)
+				if (!semaphore.take(timeoutMs))
+					return false;
+			return true;
+		}
+
+		static SpiBusStats stats() {
+			return {
+				m_depth.load(std::memory_order_relaxed),
+				m_maxDepth.load(std::memory_order_relaxed),
+				m_transactions.load(std::memory_order_relaxed),
+				m_reconfigurations.load(std::memory_order_relaxed),
+				m_errors.load(std::memory_order_relaxed),
+			};
+		}
+
+		static bool idle() {
+			return !m_busy.load(std::memory_order_acquire);
+		}
+
+		/*
+		 * @brief ISR du stream DMA de réception, à lier avec WRAPPER_BIND_IRQ(DMAx_Streamy, SpiBusDmaIrq<config>).
+		 * La fin de réception d'un segment implique que sa dernière trame est sortie : CS peut remonter.
+		 **/
+		static void isr() {
+			const uint32_t rxFlags = Dma::Rx::flags();
+			Dma::Rx::clear_flags(rxFlags);
+			if (!(rxFlags & (Dma::Rx::TransferError | Dma::Rx::TransferComplete)) || m_current == nullptr)
+				return;
+
+			if (rxFlags & Dma::Rx::TransferError) {
+				fail();
+				return;
+			}
+			if (start_segment(m_segment->next))
+				return;
+			finish(m_current, true);
+			advance(nullptr);
+		}
+
+		/*
+		 * @brief ISR du stream DMA d'émission (erreur de transfert seulement), à lier avec
+		 * WRAPPER_BIND_IRQ(DMAx_Streamz, SpiBusDmaTxIrq<config>). Un stream d'émission en erreur n'écrit
+		 * plus DR : SCK s'arrête, la réception ne finirait jamais et la file resterait bloquée.
+		 **/
+		static void tx_isr() {
+			const uint32_t txFlags = Dma::Tx::flags();
+			Dma::Tx::clear_flags(txFlags);
+			if ((txFlags & Dma::Tx::TransferError) && m_current != nullptr)
+				fail();
+		}
+
+	private:
+		// Transaction en cours abandonnée (ok à false), puis la suivante
+		static void fail() {
+			Dma::abort();
+			m_errors.store(m_errors.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			finish(m_current, false);
+			advance(nullptr);
+		}
+
+		static void wake(void* semaphore, SpiTransaction*) {
+			static_cast<Rtos::Abstract::ISemaphore*>(semaphore)->give_from_isr();
+		}
+
+		static inline void select(const SpiDeviceInfo& device) {
+			*reinterpret_cast<volatile uint32_t*>(device.csBsrr) = device.csMask << 16;
+		}
+
+		static inline void deselect(const SpiDeviceInfo& device) {
+			*reinterpret_cast<volatile uint32_t*>(device.csBsrr) = device.csMask;
+		}
+
+		// Lance le premier segment non vide à partir de segment ; false s'il n'y en a plus
+		static bool start_segment(SpiSegment* segment) {
+			while (segment != nullptr && segment->frames == 0)
+				segment = segment->next;
+			m_segment = segment;
+			if (segment == nullptr)
+				return false;
+			Dma::start(segment->tx, segment->rx, segment->frames, (m_cr1 & SPI_CR1_DFF) != 0);
+			return true;
+		}
+
+		static void finish(SpiTransaction* transaction, bool ok) {
+			deselect(*transaction->device);
+			m_current = nullptr;
+			const Callback<SpiTransaction*> done = transaction->done; // Lu avant : le propriétaire reprend la main
+			transaction->ok = ok;
+			transaction->pending = false;
+			m_transactions.store(m_transactions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			m_depth.fetch_sub(1, std::memory_order_relaxed);
+			done(transaction);
+		}
+
+		/*
+		 * @brief Démarre la prochaine transaction non vide. Même protocole que UartTxQueue::advance :
+		 * appelé uniquement par le détenteur de m_busy, qui le relâche quand la file est vide puis revérifie.
+		 **/
+		static void advance(SpiTransaction* next) {
+			for (;;) {
+				while (next == nullptr) {
+					next = take_transaction();
+					if (next)
+						break;
+					m_busy.store(false, std::memory_order_seq_cst);
+					if (m_inbox.empty() || m_busy.exchange(true, std::memory_order_acquire))
+						return;
+				}
+				const SpiDeviceInfo& device = *next->device;
+				if (device.cr1 != m_cr1) {
+					m_cr1 = device.cr1;
+					Dma::configure(m_cr1);
+					m_reconfigurations.store(m_reconfigurations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+				m_current = next;
+				select(device);
+				if (start_segment(next->segments))
+					return;
+				finish(next, true);
+				next = nullptr;
+			}
+		}
+
+		static SpiTransaction* take_transaction() {
+			if (m_pending == nullptr)
+				m_pending = m_inbox.take_all();
+			SpiTransaction* transaction = m_pending;
+			if (transaction)
+				m_pending = transaction->queueLink;
+			return transaction;
+		}
+
+		inline static MpscList<SpiTransaction, &SpiTransaction::queueLink> m_inbox {};
+		inline static std::atomic<bool> m_busy { false };
+		// État du consommateur (détenteur de m_busy uniquement)
+		inline static SpiTransaction* m_pending = nullptr;
+		inline static SpiTransaction* m_current = nullptr;
+		inline static SpiSegment* m_segment = nullptr;
+		inline static uint32_t m_cr1 = 0;
+
+		inline static std::atomic<uint32_t> m_depth { 0 };
+		inline static std::atomic<uint32_t> m_maxDepth { 0 };
+		inline static std::atomic<uint32_t> m_transactions { 0 };
+		inline static std::atomic<uint32_t> m_reconfigurations { 0 };
+		inline static std::atomic<uint32_t> m_errors { 0 };
+	};
+
+} // namespace Wrapper
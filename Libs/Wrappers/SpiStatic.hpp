@@ -1,12 +1,15 @@
 // SpiStatic.hpp
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <span>
 #include <type_traits> // Pour std::conditional_t et std::is_same_v
 #include <cstddef>     // Pour std::nullptr_t
 #include "SpiEnumsStructs.hpp"
 #include "ISpiDriver.hpp"
 #include "SpiDriver.hpp"
+#include "SpiStreamDmaDriver.hpp"
 #include "GpioStatic.hpp" // Crucial : pour initialiser les broches
 #include "SpiConfigPolicy.hpp"
 
@@ -14,13 +17,38 @@ using namespace Hal;
 
 namespace Wrapper {
 
-    template<SpiConfigPolicy config, typename Driver = HalSpiDriver>
+    /*
+     * @brief SPI statique.
+     * Accès courts (registres d'un capteur, 1 à 4 octets) : exchange() parle directement à DR/SR, sans
+     * l'état, le verrou ni la gestion de timeout de HAL_SPI_TransmitReceive (voir SpiBenchmark).
+     *
+     * Flux continu (config::TransferMode == SpiTransferMode::DmaStream) : émission et réception full-duplex
+     * sans interruption de l'horloge, par DMA circulaire sur deux demi-tampons statiques (ping-pong).
+     * Pendant que le DMA échange une moitié, l'application traite l'autre :
+     *
+     *   using Adc = SpiStaticConfig<Sck, Miso, Mosi, void, SpiPort::SPI_1, ..., SpiBaudRatePrescaler::Prescaler4,
+     *                               SpiFirstBit::MSBFirst, SpiTransferMode::DmaStream, 256>;
+     *   WRAPPER_BIND_IRQ(DMA2_Stream0, SpiStreamDmaIrq<Adc>)
+     *   WRAPPER_BIND_IRQ(DMA2_Stream3, SpiStreamDmaTxIrq<Adc>)
+     *   void on_half(size_t half) {
+     *       process(spi.stream_rx(half));   // 256 trames reçues
+     *       refill(spi.stream_tx(half));    // 256 trames émises au prochain tour
+     *   }
+     *   spi.start_stream(Callback<size_t>::from<&on_half>());
+     *
+     * on_half doit finir en moins d'une demi-période (256 octets à 21 MHz : ~97 µs), sinon la moitié
+     * suivante est comptée dans stream_overruns(). Tant que le flux tourne, les appels bloquants / IT
+     * répondent HAL_BUSY.
+     **/
+    template<SpiConfigPolicy config, SpiDriverConcept Driver = HalSpiDriver>
     class SpiStatic {
+        static constexpr bool Streaming = (config::TransferMode == SpiTransferMode::DmaStream);
+        using StreamDma = HalSpiStreamDma<config::Port>;
+
     public:
-        SpiStatic()
-            : handleIndex(HalSpiDriver::handleEmpty)
-            , m_nss_pin(nullptr) // Initialise le membre conditionnel
-            {}
+        // Trame SPI : 8 ou 16 bits selon config::DataSize
+        using Frame = std::conditional_t<config::DataSize == SpiDataSize::Data16Bit, uint16_t, uint8_t>;
+        static constexpr size_t StreamHalfFrames = config::StreamHalfFrames;
 
         void init() {
             // 1. Initialiser les broches GPIO SCK, MISO, MOSI
@@ -34,11 +62,13 @@ namespace Wrapper {
             }
             
             // 3. Initialiser le périphérique SPI
-            int8_t handleindex = m_driver.template init<config>();
-                
-            if (handleindex != HalSpiDriver::handleEmpty) {
-                handleIndex = handleindex;
-            }
+            m_driver.template init<config>();
+        }
+
+        // Initialise uniquement le périphérique SPI.
+        // Broches et horloge doivent déjà être configurées (ex: par BoardInit).
+        void init_peripheral() {
+            m_driver.template init_peripheral<config>();
         }
 
         // --- Fonctions de communication bloquantes ---
@@ -52,6 +82,13 @@ namespace Wrapper {
             return m_driver.transmit_receive(handleIndex, txData, rxData, size, timeout);
         }
 
+        // --- Chemin rapide par registres (accès courts, sans HAL) ---
+        // count trames ; voir HalSpiDriver::exchange (HAL_BUSY pendant un transfert IT/DMA ou un flux)
+        HAL_StatusTypeDef exchange(const Frame* txData, Frame* rxData, size_t count)
+            requires (std::is_same_v<Driver, HalSpiDriver> && config::Mode == SpiMode::Master && config::Direction == SpiDirection::FullDuplex) {
+            return HalSpiDriver::template exchange<config::Port>(txData, rxData, count);
+        }
+
         // --- Fonctions de communication par interruption ---
         HAL_StatusTypeDef transmit_it(const uint8_t* data, uint16_t size) {
             return m_driver.transmit_it(handleIndex, data, size);
@@ -64,31 +101,76 @@ namespace Wrapper {
         }
 
         // --- Gestion des Callbacks ---
-        void attach_callbacks(std::function<void()> tx_cb,
-                              std::function<void()> rx_cb,
-                              std::function<void()> txrx_cb,
-                              std::function<void()> error_cb) {
-            HalSpiDriver::activate_IRQ(config::Port);
-            HalSpiDriver::attach_callbacks(handleIndex, std::move(tx_cb), std::move(rx_cb), std::move(txrx_cb), std::move(error_cb));
+        void attach_callbacks(Callback<> tx_cb,
+                              Callback<> rx_cb,
+                              Callback<> txrx_cb,
+                              Callback<> error_cb) {
+            Driver::activate_IRQ(config::Port);
+            Driver::attach_callbacks(handleIndex, tx_cb, rx_cb, txrx_cb, error_cb);
+        }
+
+        // --- Flux DMA continu (SpiTransferMode::DmaStream) ---
+
+        /*
+         * @brief Lance le flux. Les deux moitiés de stream_tx() partent telles quelles au premier tour.
+         * on_half(moitié) est appelé depuis l'ISR du stream de réception ; on_error après un arrêt sur
+         * erreur de transfert DMA.
+         **/
+        HAL_StatusTypeDef start_stream(Callback<size_t> on_half, Callback<> on_error = {}, uint32_t preemptPriority = 0, uint32_t subPriority = 0)
+            requires Streaming {
+            return StreamDma::start(m_streamRx.data(), m_streamTx.data(), static_cast<uint16_t>(StreamHalfFrames),
+                config::DataSize == SpiDataSize::Data16Bit, on_half, on_error, preemptPriority, subPriority);
+        }
+
+        void stop_stream() requires Streaming {
+            StreamDma::stop();
+        }
+
+        // Moitié half (0 ou 1) reçue, valide jusqu'au tour suivant
+        std::span<const Frame, StreamHalfFrames> stream_rx(size_t half) const requires Streaming {
+            return std::span<const Frame, StreamHalfFrames>(m_streamRx.data() + (half & 1u) * StreamHalfFrames, StreamHalfFrames);
+        }
+
+        // Moitié half à émettre au prochain tour (réécrire depuis on_half(half))
+        std::span<Frame, StreamHalfFrames> stream_tx(size_t half) requires Streaming {
+            return std::span<Frame, StreamHalfFrames>(m_streamTx.data() + (half & 1u) * StreamHalfFrames, StreamHalfFrames);
+        }
+
+        bool stream_active() const requires Streaming {
+            return StreamDma::active();
+        }
+
+        uint32_t stream_overruns() const requires Streaming {
+            return StreamDma::overruns();
+        }
+
+        uint32_t stream_errors() const requires Streaming {
+            return StreamDma::errors();
         }
 
     private:
-        Driver m_driver;
-        int8_t handleIndex;
+        [[no_unique_address]] Driver m_driver;
+        // Handle résolu à la compilation : adresse constante dans le registre du driver
+        static constexpr int8_t handleIndex = Driver::handle_index(config::Port);
         
         // Instanciation des wrappers GpioStatic pour SCK, MISO, MOSI
-        typename config::SckPin::template GpioStatic<typename config::SckPin> m_sck_pin;
-        typename config::MisoPin::template GpioStatic<typename config::MisoPin> m_miso_pin;
-        typename config::MosiPin::template GpioStatic<typename config::MosiPin> m_mosi_pin;
+        GpioStatic<typename config::SckPin> m_sck_pin;
+        GpioStatic<typename config::MisoPin> m_miso_pin;
+        GpioStatic<typename config::MosiPin> m_mosi_pin;
 
         // Instanciation conditionnelle du wrapper GpioStatic pour NSS
         // Si config::NssPin est 'void', m_nss_pin sera de type std::nullptr_t
         // Sinon, il sera du type GpioStatic<config::NssPin>
-        std::conditional_t<
-            !std::is_same_v<typename config::NssPin, void>,
-            typename config::NssPin::template GpioStatic<typename config::NssPin>,
-            std::nullptr_t
-        > m_nss_pin;
+        template <typename Pin>
+        struct NssPinWrapper { using type = GpioStatic<Pin>; };
+        template <typename Pin> requires std::is_void_v<Pin>
+        struct NssPinWrapper<Pin> { using type = std::nullptr_t; };
+
+        typename NssPinWrapper<typename config::NssPin>::type m_nss_pin {};
+
+        // Tampons du flux : statiques (adresse fixe pour le DMA), deux moitiés chacun
+        alignas(4) inline static std::array<Frame, 2 * StreamHalfFrames> m_streamRx {};
+        alignas(4) inline static std::array<Frame, 2 * StreamHalfFrames> m_streamTx {};
     };
 
 } // namespace Wrapper
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Wrapper {
+
+	/*
+	 * @brief File circulaire sans verrou, un seul producteur / un seul consommateur (ex: ISR -> thread).
+	 * Indices 32 bits libres (jamais remis à zéro) : plein/vide se distinguent sans case perdue.
+	 * Chaque côté n'écrit que son propre indice ; acquire/release ordonnent les données et les indices.
+	 * Capacity doit être une puissance de 2 (le modulo devient un masque).
+	 **/
+	template <typename T, size_t Capacity>
+	class SpscRing {
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing : Capacity doit être une puissance de 2");
+		static_assert(std::atomic<uint32_t>::is_always_lock_free, "SpscRing : atomiques 32 bits requis");
+
+	public:
+		static constexpr size_t Mask = Capacity - 1;
+
+		// --- Côté producteur ---
+		bool push(const T& item) {
+			const uint32_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+				return false;
+			m_buffer[head & Mask] = item;
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// --- Côté consommateur ---
+		bool pop(T& item) {
+			const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+			if (m_head.load(std::memory_order_acquire) == tail)
+				return false;
+			item = m_buffer[tail & Mask];
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Retire jusqu'à maxCount éléments en une fois : un seul load de head, un seul store de tail.
+		size_t pop_batch(T* out, size_t maxCount) {
+			const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+			const uint32_t available = m_head.load(std::memory_order_acquire) - tail;
+			const size_t count = (available < maxCount) ? available : maxCount;
+			for (size_t i = 0; i < count; ++i)
+				out[i] = m_buffer[(tail + i) & Mask];
+			m_tail.store(tail + count, std::memory_order_release);
+			return count;
+		}
+
+		size_t size() const {
+			return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+		}
+
+		bool empty() const {
+			return size() == 0;
+		}
+
+		static constexpr size_t capacity() {
+			return Capacity;
+		}
+
+	private:
+		std::array<T, Capacity> m_buffer {};
+		std::atomic<uint32_t> m_head { 0 };
+		std::atomic<uint32_t> m_tail { 0 };
+	};
+
+} // namespace Wrapper
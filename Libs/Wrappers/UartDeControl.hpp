@@ -0,0 +1,86 @@
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "UartEnumsStructs.hpp"
+#include "UartConfigPolicy.hpp"
+#include "GpioStatic.hpp"
+#include "BitBand.hpp"
+#include "UartDeSequence.hpp"
+
+using namespace Hal;
+using namespace WrapperBase;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Broche DE (driver enable) d'un transceiver RS-485 en half-duplex.
+	 * Le STM32F4 n'a pas de DE matériel dans l'USART : DE est levé juste avant le premier octet et
+	 * retombé dans l'ISR USART sur TC (dernier bit de stop sorti du registre à décalage). Le retard de
+	 * retournement se limite à la latence d'entrée en ISR, sans attente logicielle ni troncature du
+	 * dernier octet.
+	 *
+	 * Séquence (émission en file, UartTxQueue) :
+	 *   drive()   : TCIE coupé, DE haut, puis TC effacé au départ de chaque bloc DMA (HalUartTxDma::start)
+	 *   release() : file vide, TCIE armé ; si TC est déjà levé, l'IRQ part immédiatement
+	 *   on_irq()  : TC + TCIE + libération attendue -> TCIE coupé, DE bas (appelé par UartIrq<config>)
+	 * TCIE est écrit par bit-band : pas de read-modify-write de CR1 concurrent avec la HAL.
+	 * La séquence elle-même (UartDeSequence) est sans matériel, vérifiée sur hôte par tools/uart_de_check.cpp.
+	 **/
+	template <UartConfigPolicy config>
+	struct UartDeControl {
+		static constexpr bool Enabled = !std::is_void_v<typename config::DePin>;
+
+		static constexpr uint32_t UsartBase = [] {
+			switch (config::Port) {
+				case UartPort::USART_1: return USART1_BASE;
+				case UartPort::USART_2: return USART2_BASE;
+				case UartPort::USART_3: return USART3_BASE;
+				case UartPort::UART_4:  return UART4_BASE;
+				case UartPort::UART_5:  return UART5_BASE;
+				case UartPort::USART_6: return USART6_BASE;
+			}
+			return USART1_BASE;
+		}();
+
+		static void init() requires Enabled {
+			static_assert(config::DePin::Mode == GpioPinMode::Output, "UartDeControl : la broche DE doit être en sortie");
+			GpioStatic<typename config::DePin> pin;
+			pin.init();
+			pin.set_low();
+			Sequence::drop();
+		}
+
+		static inline void drive() requires Enabled { Sequence::drive(); }
+		static inline void release() requires Enabled { Sequence::release(); }
+		static inline void drop() requires Enabled { Sequence::drop(); }
+
+		// En tête de l'ISR USART, avant HAL_UART_IRQHandler (qui ne voit plus TCIE)
+		static inline void on_irq() requires Enabled { Sequence::on_irq(); }
+
+		// Vrai entre la fin de la file et TC : DE encore levé pour le dernier octet
+		static inline bool release_pending() requires Enabled { return Sequence::release_pending(); }
+
+	private:
+		// Accès matériel de la séquence : TCIE par bit-band (pas de read-modify-write de CR1), DE par GPIO
+		struct Line {
+			static inline volatile uint32_t& tcie_bit() {
+				return BitBand::template periph<UsartBase + offsetof(USART_TypeDef, CR1), BitBand::BitIndex(USART_CR1_TCIE)>();
+			}
+			static inline void set_tcie(bool enabled) { tcie_bit() = enabled ? 1u : 0u; }
+			static inline bool tcie() { return tcie_bit() != 0u; }
+			static inline bool tc() { return (reinterpret_cast<USART_TypeDef*>(UsartBase)->SR & USART_SR_TC) != 0u; }
+			static inline void set_de(bool high) {
+				if (high)
+					GpioStatic<typename config::DePin>().set_high();
+				else
+					GpioStatic<typename config::DePin>().set_low();
+			}
+		};
+
+		using Sequence = UartDeSequence<Line>;
+	};
+
+} // namespace Wrapper
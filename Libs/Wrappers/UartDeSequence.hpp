@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Wrapper {
+
+	/*
+	 * @brief Séquence de la broche DE RS-485, sans accès matériel : partagée par UartDeControl (registres
+	 * USART, GPIO) et par le contrôle hôte sur USART simulé (tools/uart_de_check.cpp).
+	 * @tparam Line Accès statiques : set_de(bool), set_tcie(bool), tcie(), tc()
+	 **/
+	template <typename Line>
+	struct UartDeSequence {
+		// Avant l'émission : TCIE coupé (TC d'une rafale précédente ignoré), DE levé
+		static inline void drive() {
+			m_releasePending = false;
+			Line::set_tcie(false);
+			Line::set_de(true);
+		}
+
+		// Plus rien à émettre : DE retombera sur TC
+		static inline void release() {
+			m_releasePending = true;
+			Line::set_tcie(true);
+		}
+
+		// Après une émission bloquante (TC déjà attendu)
+		static inline void drop() {
+			m_releasePending = false;
+			Line::set_de(false);
+		}
+
+		// ISR USART : TC + TCIE + libération attendue -> TCIE coupé, DE bas
+		static inline void on_irq() {
+			if (m_releasePending && Line::tc() && Line::tcie()) {
+				Line::set_tcie(false);
+				Line::set_de(false);
+				m_releasePending = false;
+			}
+		}
+
+		static inline bool release_pending() {
+			return m_releasePending;
+		}
+
+	private:
+		inline static volatile bool m_releasePending = false;
+	};
+
+} // namespace Wrapper
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include "Cobs.hpp"
+#include "CrcDriver.hpp"
+#include "CriticalSection.hpp"
+#include "Callback.hpp"
+
+using namespace Hal;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Compteurs de la couche paquet (cumulés).
+	 * framingErrors : COBS invalide, trame trop courte ou trop longue ; crcErrors : trame bien formée
+	 * mais CRC faux.
+	 **/
+	struct PacketLinkStats {
+		uint32_t frames;
+		uint32_t framingErrors;
+		uint32_t crcErrors;
+	};
+
+	/*
+	 * @brief Couche paquet au-dessus de la réception continue d'UartStatic (RxDmaBufferSize > 0).
+	 * Trame sur la ligne : COBS(charge utile | CRC-32 petit-boutiste) puis 0x00.
+	 * Le CRC est celui de l'unité matérielle (HalCrcDriver::compute sur la charge utile). L'unité n'a
+	 * qu'un registre d'accumulation : chaque calcul se fait interruptions masquées (~2 µs pour 256 octets),
+	 * poll() et send() / encode() peuvent donc tourner dans des tâches différentes.
+	 *
+	 * Réception par lots : poll() parcourt les octets reçus directement dans le tampon DMA, décode
+	 * chaque trame en place et la passe au visiteur, sans copie. Seule une trame à cheval sur la fin
+	 * du tampon circulaire est recopiée (dans un tampon de MaxPayload + 5 octets).
+	 *
+	 *   using Link = UartStaticConfig<Tx, Rx, UartPort::USART_2, 921600, ..., 1024>;
+	 *   UartPacketLink<UartStatic<Link>> link;
+	 *   link.start(Callback<>::from<&wake_parser>());
+	 *   // Tâche de traitement, réveillée par wake_parser
+	 *   link.poll([](std::span<const uint8_t> payload) { handle(payload); });
+	 *
+	 * La charge utile n'est valide que pendant l'appel du visiteur (elle est dans le tampon DMA).
+	 * Le tampon de réception doit contenir au moins une trame complète et la latence du consommateur.
+	 *
+	 * @tparam Uart       UartStatic<config> avec réception continue
+	 * @tparam MaxPayload Taille maximale d'une charge utile
+	 **/
+	template <typename Uart, size_t MaxPayload = 256>
+	class UartPacketLink {
+		static constexpr size_t CrcSize = 4;
+		static constexpr size_t MaxEncoded = Cobs::max_encoded_size(MaxPayload + CrcSize);
+
+	public:
+		static constexpr size_t MaxFrameSize = MaxEncoded + 1; // Délimiteur compris
+
+		/*
+		 * @brief Active l'unité CRC et démarre la réception continue (voir UartStatic::start_rx_stream).
+		 **/
+		HAL_StatusTypeDef start(Callback<> notify = {}, uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			HalCrcDriver::init();
+			m_partial = 0;
+			m_discarding = false;
+			return m_uart.start_rx_stream(notify, preemptPriority, subPriority);
+		}
+
+		/*
+		 * @brief Traite les trames complètes reçues : on_frame(std::span<const uint8_t>) pour chacune.
+		 * Une trame incomplète reste dans le tampon DMA jusqu'à l'appel suivant.
+		 * @return nombre de trames valides passées au visiteur
+		 **/
+		template <typename OnFrame>
+		size_t poll(OnFrame&& on_frame, size_t maxFrames = SIZE_MAX) {
+			size_t frames = 0;
+			while (frames < maxFrames) {
+				const std::span<uint8_t> chunk = m_uart.rx_peek();
+				if (chunk.empty())
+					break;
+
+				uint8_t* delimiter = static_cast<uint8_t*>(std::memchr(chunk.data(), 0, chunk.size()));
+				if (delimiter == nullptr) {
+					// Suite encore en cours de réception : on attend sur place, sauf si la trame est à cheval
+					// sur la fin du tampon (la suite est au début) ou déjà trop longue
+					if (m_partial == 0 && !m_discarding && m_uart.rx_available() == chunk.size() && chunk.size() <= MaxEncoded)
+						break;
+					stash(chunk);
+					m_uart.rx_consume(chunk.size());
+					continue;
+				}
+
+				const size_t length = static_cast<size_t>(delimiter - chunk.data());
+				std::span<uint8_t> frame = chunk.first(length);
+				if (m_partial != 0 || m_discarding) {
+					stash(frame);
+					frame = { m_stash.data(), m_partial };
+				}
+				const bool discard = m_discarding;
+				m_partial = 0;
+				m_discarding = false;
+
+				if (!discard && !frame.empty() && deliver(frame, on_frame))
+					++frames;
+				m_uart.rx_consume(length + 1);
+			}
+			return frames;
+		}
+
+		/*
+		 * @brief Encode et émet une trame (bloquant, via UartStatic::transmit).
+		 * Un seul thread émetteur à la fois (tampon d'encodage partagé).
+		 **/
+		HAL_StatusTypeDef send(std::span<const uint8_t> payload, uint32_t timeout = HAL_MAX_DELAY) {
+			const size_t size = encode(payload, m_txBuffer);
+			if (size == Cobs::Error)
+				return HAL_ERROR;
+			return m_uart.transmit(m_txBuffer.data(), static_cast<uint16_t>(size), timeout);
+		}
+
+		/*
+		 * @brief Construit une trame complète (délimiteur compris) dans out, pour un autre moyen d'émission
+		 * (ex: UartTxDescriptor). @return taille de la trame, Cobs::Error si payload ou out est trop grand / petit.
+		 **/
+		static size_t encode(std::span<const uint8_t> payload, std::span<uint8_t> out) {
+			if (payload.size() > MaxPayload || out.size() < 2)
+				return Cobs::Error;
+			const uint32_t crc = checksum(payload);
+			const uint8_t crcBytes[CrcSize] = {
+				static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8),
+				static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 24),
+			};
+			Cobs::Encoder encoder(out.first(out.size() - 1));
+			encoder.append(payload);
+			encoder.append(crcBytes);
+			const size_t size = encoder.finish();
+			if (size == Cobs::Error)
+				return Cobs::Error;
+			out[size] = 0;
+			return size + 1;
+		}
+
+		PacketLinkStats stats() const {
+			return { m_frames, m_framingErrors, m_crcErrors };
+		}
+
+	private:
+		// reset / accumulate / value d'un calcul ne doivent pas s'entrelacer avec ceux d'une autre tâche
+		static uint32_t checksum(std::span<const uint8_t> payload) {
+			Hal::CriticalSection lock;
+			return HalCrcDriver::compute(payload.data(), payload.size());
+		}
+
+		// Recopie la partie d'une trame coupée par la fin du tampon ; une trame trop longue est abandonnée
+		void stash(std::span<const uint8_t> bytes) {
+			if (m_discarding)
+				return;
+			if (m_partial + bytes.size() > MaxEncoded) {
+				++m_framingErrors;
+				m_discarding = true;
+				m_partial = 0;
+				return;
+			}
+			std::memcpy(m_stash.data() + m_partial, bytes.data(), bytes.size());
+			m_partial += bytes.size();
+		}
+
+		template <typename OnFrame>
+		bool deliver(std::span<uint8_t> frame, OnFrame& on_frame) {
+			const size_t size = Cobs::decode(frame);
+			if (size == Cobs::Error || size < CrcSize || size > MaxPayload + CrcSize) {
+				++m_framingErrors;
+				return false;
+			}
+			const std::span<const uint8_t> payload = frame.first(size - CrcSize);
+			const uint8_t* crcBytes = frame.data() + payload.size();
+			const uint32_t received = static_cast<uint32_t>(crcBytes[0]) | (static_cast<uint32_t>(crcBytes[1]) << 8)
+				| (static_cast<uint32_t>(crcBytes[2]) << 16) | (static_cast<uint32_t>(crcBytes[3]) << 24);
+			if (checksum(payload) != received) {
+				++m_crcErrors;
+				return false;
+			}
+			++m_frames;
+			on_frame(payload);
+			return true;
+		}
+
+		Uart m_uart;
+
+		// Reconstitution d'une trame coupée par la fin du tampon circulaire
+		std::array<uint8_t, MaxEncoded> m_stash {};
+		size_t m_partial = 0;
+		bool m_discarding = false;
+
+		inline static std::array<uint8_t, MaxFrameSize> m_txBuffer {};
+
+		uint32_t m_frames = 0;
+		uint32_t m_framingErrors = 0;
+		uint32_t m_crcErrors = 0;
+	};
+
+} // namespace Wrapper
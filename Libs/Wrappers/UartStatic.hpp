@@ -1,44 +1,95 @@
 // UartStatic.hpp
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include "UartEnumsStructs.hpp"
 #include "IUartDriver.hpp"
 #include "UartDriver.hpp"
 #include "GpioStatic.hpp" // Pour initialiser les broches
 #include "UartConfigPolicy.hpp"
+#include "UartTxQueue.hpp"
+#include "UartDeControl.hpp"
 
 using namespace Hal;
 
 namespace Wrapper {
-	template<UartConfigPolicy config, typename Driver = HalUartDriver>
+	/*
+	 * @brief UART statique.
+	 * Réception continue (config::RxDmaBufferSize > 0) : le DMA écrit en boucle dans un tampon statique,
+	 * les événements mi-tampon / fin de tampon / ligne inactive publient la position d'écriture, et le
+	 * consommateur lit les nouveaux octets en place, sans copie :
+	 *
+	 *   using Link = UartStaticConfig<Tx, Rx, UartPort::USART_2, 921600, ..., 512>;
+	 *   WRAPPER_BIND_IRQ(USART2, UartIrq<Link>)
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream5, UartRxDmaIrq<Link>)
+	 *   uart.start_rx_stream(Callback<>::from<&wake_parser>());
+	 *   for (auto chunk = uart.rx_peek(); !chunk.empty(); chunk = uart.rx_peek()) {
+	 *       parse(chunk);
+	 *       uart.rx_consume(chunk.size());
+	 *   }
+	 *
+	 * Le tampon doit couvrir la latence du consommateur : à 921600 bauds, 512 octets = 5,5 ms.
+	 *
+	 * Émission en file (UartTxQueue) : trames en chaînes de descripteurs, émises par DMA sans copie,
+	 * send() appelable depuis plusieurs threads :
+	 *
+	 *   WRAPPER_BIND_IRQ(DMA1_Stream6, UartTxDmaIrq<Link>)
+	 *   uart.start_tx_queue();
+	 *   header.next = &payload; payload.next = &crc;
+	 *   uart.send(header);
+	 *
+	 * RS-485 half-duplex (config::DePin non void) : DE est levé avant le premier octet et retombé dans
+	 * l'ISR USART sur TC (UartDeControl). Lier le vecteur USART avec UartIrq<config>, émettre par send()
+	 * ou transmit().
+	 **/
+	template<UartConfigPolicy config, UartDriverConcept Driver = HalUartDriver>
 		class UartStatic {
-		public:
-			UartStatic()
-				: handleIndex(HalUartDriver::handleEmpty) {}
+			static constexpr size_t RxBufferSize = config::RxDmaBufferSize;
+			using De = UartDeControl<config>;
+			static_assert(RxBufferSize == 0 || ((RxBufferSize & (RxBufferSize - 1)) == 0 && RxBufferSize <= 32768),
+				"UartStatic : RxDmaBufferSize doit être une puissance de 2 (32768 max, NDTR 16 bits)");
 
+		public:
 			void init() {
 
 				// Initialiser les broches GPIO
 				m_tx_pin.init();
 				m_rx_pin.init();
+				if constexpr (De::Enabled)
+					De::init();
 				
-				int8_t handleindex = m_driver.template init<config>();
-					
-				if (handleindex != HalUartDriver::handleEmpty) {
-					handleIndex = handleindex;
-				}
+				m_driver.template init<config>();
+			}
+
+			/*
+			 * @brief Initialise uniquement le périphérique UART.
+			 * Broches et horloge doivent déjà être configurées (ex: par BoardInit).
+			 **/
+			void init_peripheral() {
+				m_driver.template init_peripheral<config>();
 			}
 
 			HAL_StatusTypeDef transmit(const uint8_t* data, uint16_t size, uint32_t timeout = HAL_MAX_DELAY) {
-				return m_driver.transmit(handleIndex, data, size, timeout);
+				if constexpr (De::Enabled) {
+					De::drive();
+					const HAL_StatusTypeDef status = m_driver.transmit(handleIndex, data, size, timeout);
+					De::drop();
+					return status;
+				}
+				else
+					return m_driver.transmit(handleIndex, data, size, timeout);
 			}
 
 			HAL_StatusTypeDef receive(uint8_t* data, uint16_t size, uint32_t timeout = HAL_MAX_DELAY) {
 				return m_driver.receive(handleIndex, data, size, timeout);
 			}
     
-			HAL_StatusTypeDef transmit_it(const uint8_t* data, uint16_t size) {
+			// Sans broche DE : en RS-485, émettre par transmit() ou send()
+			HAL_StatusTypeDef transmit_it(const uint8_t* data, uint16_t size) requires (!De::Enabled) {
 				return m_driver.transmit_it(handleIndex, data, size);
 			}
 
@@ -46,19 +97,147 @@ namespace Wrapper {
 				return m_driver.receive_it(handleIndex, data, size);
 			}
 
-			void attach_callbacks(std::function<void()> tx_cb, std::function<void()> rx_cb) {
-				HalUartDriver::activate_IRQ(config::Port);
-				HalUartDriver::attach_callbacks(handleIndex, std::move(tx_cb), std::move(rx_cb));
+			void attach_callbacks(Callback<> tx_cb, Callback<> rx_cb) {
+				Driver::activate_IRQ(config::Port);
+				Driver::attach_callbacks(handleIndex, tx_cb, rx_cb);
+			}
+
+			/*
+			 * @brief Active l'émission DMA en file. Après cet appel, n'utiliser que send() pour émettre.
+			 * Avec une broche DE, l'IRQ USART (UartIrq<config>, à lier) est aussi activée : DE retombe sur TC.
+			 **/
+			void start_tx_queue(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+				if constexpr (De::Enabled) {
+					UartTxQueue<config::Port>::attach_line_control(Callback<>::template from<&De::drive>(), Callback<>::template from<&De::release>());
+					HAL_NVIC_SetPriority(HalUartDriver::Irq(config::Port), preemptPriority, subPriority);
+					HAL_NVIC_EnableIRQ(HalUartDriver::Irq(config::Port));
+				}
+				UartTxQueue<config::Port>::init(preemptPriority, subPriority);
+			}
+
+			void send(UartTxDescriptor& frame) {
+				UartTxQueue<config::Port>::send(frame);
+			}
+
+			UartTxStats tx_stats() const {
+				return UartTxQueue<config::Port>::stats();
+			}
+
+			/*
+			 * @brief Démarre la réception continue. notify est appelé depuis l'ISR à chaque événement de
+			 * réception : nouveaux octets disponibles ou ligne inactive (ex: réveil d'une tâche).
+			 * Remet le flux à zéro : les octets non lus sont perdus.
+			 **/
+			HAL_StatusTypeDef start_rx_stream(Callback<> notify = {}, uint32_t preemptPriority = 0, uint32_t subPriority = 0)
+				requires (RxBufferSize > 0)
+			{
+				m_rxActive.store(false, std::memory_order_relaxed);
+				m_rxNotify = notify;
+				m_rxDmaPos = 0;
+				m_rxTail = 0;
+				m_rxHead.store(0, std::memory_order_release);
+
+				const HAL_StatusTypeDef status = Driver::start_rx_dma(config::Port, m_rxBuffer.data(), static_cast<uint16_t>(RxBufferSize),
+					Callback<uint16_t>::template from<&UartStatic::on_rx_event>(),
+					Callback<>::template from<&UartStatic::on_rx_error>(),
+					preemptPriority, subPriority);
+				m_rxActive.store(status == HAL_OK, std::memory_order_release);
+				return status;
+			}
+
+			HAL_StatusTypeDef stop_rx_stream() requires (RxBufferSize > 0) {
+				m_rxActive.store(false, std::memory_order_release);
+				return Driver::stop_rx_dma(config::Port);
+			}
+
+			/*
+			 * @brief Plus grand bloc contigu de nouveaux octets, lu directement dans le tampon DMA.
+			 * Le bloc s'arrête à la fin du tampon : un second appel après rx_consume() donne la suite.
+			 * Si le DMA a recouvert des octets non lus, ils sont abandonnés et rx_overruns() est incrémenté.
+			 * Le bloc est modifiable jusqu'à rx_consume() (décodage en place, ex: UartPacketLink).
+			 **/
+			std::span<uint8_t> rx_peek() requires (RxBufferSize > 0) {
+				const uint32_t head = m_rxHead.load(std::memory_order_acquire);
+				const uint32_t available = head - m_rxTail;
+				if (available > RxBufferSize) {
+					m_rxOverruns.fetch_add(1, std::memory_order_relaxed);
+					m_rxTail = head;
+					return {};
+				}
+				const uint32_t index = m_rxTail & RxMask;
+				const size_t contiguous = (available < RxBufferSize - index) ? available : RxBufferSize - index;
+				return { m_rxBuffer.data() + index, contiguous };
+			}
+
+			/*
+			 * @brief Libère count octets lus via rx_peek().
+			 * @return false si le DMA a pu réécrire ces octets pendant leur traitement (consommateur trop lent).
+			 **/
+			bool rx_consume(size_t count) requires (RxBufferSize > 0) {
+				const uint32_t available = m_rxHead.load(std::memory_order_acquire) - m_rxTail;
+				const bool intact = available <= RxBufferSize;
+				m_rxTail += (count < available) ? static_cast<uint32_t>(count) : available;
+				if (!intact)
+					m_rxOverruns.fetch_add(1, std::memory_order_relaxed);
+				return intact;
+			}
+
+			size_t rx_available() const requires (RxBufferSize > 0) {
+				return m_rxHead.load(std::memory_order_acquire) - m_rxTail;
+			}
+
+			// Octets non lus recouverts par le DMA
+			uint32_t rx_overruns() const requires (RxBufferSize > 0) {
+				return m_rxOverruns.load(std::memory_order_relaxed);
+			}
+
+			// Arrêts du flux sur erreur de transfert DMA (ex: tampon en CCM) ; relancer par start_rx_stream()
+			uint32_t rx_errors() const requires (RxBufferSize > 0) {
+				return m_rxErrors.load(std::memory_order_relaxed);
+			}
+
+			bool rx_stream_active() const requires (RxBufferSize > 0) {
+				return m_rxActive.load(std::memory_order_acquire);
 			}
 
 
 		private:
-			Driver m_driver;
+			static constexpr uint32_t RxMask = RxBufferSize ? static_cast<uint32_t>(RxBufferSize - 1) : 0u;
+
+			// ISR (HalUartDriver::handle_rx_event) : position d'écriture DMA, RxBufferSize en fin de tampon
+			static void on_rx_event(uint16_t position) {
+				const uint32_t pos = position & RxMask;
+				const uint32_t delta = (pos - m_rxDmaPos) & RxMask;
+				m_rxDmaPos = pos;
+				if (delta != 0)
+					m_rxHead.store(m_rxHead.load(std::memory_order_relaxed) + delta, std::memory_order_release);
+				// Notifié même sans nouvel octet : une ligne inactive juste après fin de tampon marque une fin de trame
+				m_rxNotify();
+			}
 
-			int8_t handleIndex;
+			static void on_rx_error() {
+				m_rxErrors.fetch_add(1, std::memory_order_relaxed);
+				m_rxActive.store(false, std::memory_order_release);
+				m_rxNotify();
+			}
+
+			[[no_unique_address]] Driver m_driver;
+
+			// Handle résolu à la compilation : adresse constante dans le registre du driver
+			static constexpr int8_t handleIndex = Driver::handle_index(config::Port);
 			
-			typename config::TxPin::template GpioStatic<typename config::TxPin> m_tx_pin;
-			typename config::RxPin::template GpioStatic<typename config::RxPin> m_rx_pin;
+			GpioStatic<typename config::TxPin> m_tx_pin;
+			GpioStatic<typename config::RxPin> m_rx_pin;
+
+			// État du flux de réception, partagé avec l'ISR. Tampon en .bss (SRAM1), jamais en CCM.
+			alignas(4) inline static std::array<uint8_t, RxBufferSize> m_rxBuffer {};
+			inline static std::atomic<uint32_t> m_rxHead { 0 };
+			inline static uint32_t m_rxTail = 0;
+			inline static uint32_t m_rxDmaPos = 0;
+			inline static std::atomic<uint32_t> m_rxOverruns { 0 };
+			inline static std::atomic<uint32_t> m_rxErrors { 0 };
+			inline static std::atomic<bool> m_rxActive { false };
+			inline static Callback<> m_rxNotify {};
 		};
 	
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "UartEnumsStructs.hpp"
+#include "UartTxDmaDriver.hpp"
+#include "Callback.hpp"
+#include "MpscList.hpp"
+
+using namespace Hal;
+
+namespace Wrapper {
+
+	/*
+	 * @brief Descripteur d'un bloc à émettre, sans copie.
+	 * Une trame est une chaîne de descripteurs (next) émis à la suite : ex. en-tête -> charge utile -> CRC.
+	 * release est appelé depuis l'ISR dès que le DMA a lu le bloc : son propriétaire peut le réutiliser.
+	 * Le descripteur et le bloc appartiennent au moteur entre send() et release.
+	 **/
+	struct UartTxDescriptor {
+		const uint8_t* data = nullptr;
+		uint16_t size = 0;
+		UartTxDescriptor* next = nullptr;
+		Callback<UartTxDescriptor*> release {};
+
+		UartTxDescriptor* queueLink = nullptr; // Réservé à la file
+	};
+
+	/*
+	 * @brief Compteurs du moteur d'émission (instantané).
+	 * depth : trames en file ou en cours ; bytes / frames : cumulés, débit = delta / durée de la fenêtre.
+	 **/
+	struct UartTxStats {
+		uint32_t depth;
+		uint32_t maxDepth;
+		uint32_t frames;
+		uint32_t bytes;
+		uint32_t errors;
+	};
+
+	/*
+	 * @brief Moteur d'émission DMA d'un port : file de trames alimentée par plusieurs threads sans verrou.
+	 * send() pousse la trame (un compare-exchange) ; si le moteur est au repos, l'appelant le démarre.
+	 * Ensuite l'ISR DMA enchaîne seul les blocs et les trames, et rend chaque bloc à son propriétaire.
+	 * Un seul contexte à la fois déroule la file : celui qui a pris m_busy.
+	 **/
+	template <UartPort port>
+	class UartTxQueue {
+		using Dma = HalUartTxDma<port>;
+
+	public:
+		static constexpr IRQn_Type Irq = Dma::Irq;
+
+		static void init(uint32_t preemptPriority = 0, uint32_t subPriority = 0) {
+			Dma::init(preemptPriority, subPriority);
+		}
+
+		/*
+		 * @brief Commande de ligne (ex: DE RS-485, UartDeControl) : drive avant le premier bloc d'une
+		 * rafale, release quand la file est vide. Appelés par le détenteur de m_busy, thread ou ISR DMA.
+		 * À attacher avant le premier send().
+		 **/
+		static void attach_line_control(Callback<> drive, Callback<> release) {
+			m_onDrive = drive;
+			m_onRelease = release;
+		}
+
+		/*
+		 * @brief Met une trame en file. Appelable depuis n'importe quel thread (ou ISR de priorité
+		 * inférieure ou égale au stream DMA). Ne bloque jamais.
+		 **/
+		static void send(UartTxDescriptor& frame) {
+			const uint32_t depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+			uint32_t max = m_maxDepth.load(std::memory_order_relaxed);
+			while (depth > max && !m_maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {}
+
+			m_inbox.push(&frame);
+			if (!m_busy.exchange(true, std::memory_order_acquire))
+				advance(nullptr);
+		}
+
+		static UartTxStats stats() {
+			return {
+				m_depth.load(std::memory_order_relaxed),
+				m_maxDepth.load(std::memory_order_relaxed),
+				m_frames.load(std::memory_order_relaxed),
+				m_bytes.load(std::memory_order_relaxed),
+				m_errors.load(std::memory_order_relaxed),
+			};
+		}
+
+		static uint32_t depth() {
+			return m_depth.load(std::memory_order_relaxed);
+		}
+
+		static bool idle() {
+			return !m_busy.load(std::memory_order_acquire);
+		}
+
+		/*
+		 * @brief ISR du stream DMA, à lier avec WRAPPER_BIND_IRQ(DMAx_Streamy, UartTxDmaIrq<config>).
+		 **/
+		static void isr() {
+			const uint32_t flags = Dma::flags() & Dma::AllFlags;
+			Dma::clear_flags(flags);
+			if (!(flags & (Dma::TransferComplete | Dma::TransferError)) || m_current == nullptr)
+				return;
+
+			UartTxDescriptor* done = m_current;
+			if (flags & Dma::TransferError)
+				m_errors.store(m_errors.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			else
+				m_bytes.store(m_bytes.load(std::memory_order_relaxed) + done->size, std::memory_order_relaxed);
+			advance(complete(done));
+		}
+
+	private:
+		/*
+		 * @brief Rend le bloc à son propriétaire. @return le bloc suivant de la trame, nullptr en fin de trame.
+		 **/
+		static UartTxDescriptor* complete(UartTxDescriptor* done) {
+			UartTxDescriptor* next = done->next; // Lu avant release : le propriétaire peut réutiliser done
+			done->release(done);
+			if (next == nullptr) {
+				m_frames.store(m_frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				m_depth.fetch_sub(1, std::memory_order_relaxed);
+			}
+			return next;
+		}
+
+		/*
+		 * @brief Démarre le prochain bloc non vide, en prenant la trame suivante si besoin.
+		 * Appelé uniquement par le détenteur de m_busy ; le relâche quand il n'y a plus rien à émettre,
+		 * puis revérifie la file pour ne pas perdre une trame poussée entre-temps.
+		 **/
+		static void advance(UartTxDescriptor* next) {
+			for (;;) {
+				while (next == nullptr) {
+					next = take_frame();
+					if (next)
+						break;
+					m_current = nullptr;
+					if (m_lineDriven) {
+						m_lineDriven = false;
+						m_onRelease();
+					}
+					m_busy.store(false, std::memory_order_seq_cst);
+					if (m_inbox.empty() || m_busy.exchange(true, std::memory_order_acquire))
+						return;
+				}
+				if (next->size == 0) {
+					next = complete(next);
+					continue;
+				}
+				m_current = next;
+				if (!m_lineDriven) {
+					m_lineDriven = true;
+					m_onDrive();
+				}
+				Dma::start(next->data, next->size);
+				return;
+			}
+		}
+
+		static UartTxDescriptor* take_frame() {
+			if (m_pending == nullptr)
+				m_pending = m_inbox.take_all();
+			UartTxDescriptor* frame = m_pending;
+			if (frame)
+				m_pending = frame->queueLink;
+			return frame;
+		}
+
+		inline static MpscList<UartTxDescriptor, &UartTxDescriptor::queueLink> m_inbox {};
+		inline static std::atomic<bool> m_busy { false };
+		// État du consommateur (détenteur de m_busy uniquement)
+		inline static UartTxDescriptor* m_pending = nullptr;
+		inline static UartTxDescriptor* m_current = nullptr;
+		inline static bool m_lineDriven = false;
+		inline static Callback<> m_onDrive {};
+		inline static Callback<> m_onRelease {};
+
+		inline static std::atomic<uint32_t> m_depth { 0 };
+		inline static std::atomic<uint32_t> m_maxDepth { 0 };
+		inline static std::atomic<uint32_t> m_frames { 0 };
+		inline static std::atomic<uint32_t> m_bytes { 0 };
+		inline static std::atomic<uint32_t> m_errors { 0 };
+	};
+
+} // namespace Wrapper
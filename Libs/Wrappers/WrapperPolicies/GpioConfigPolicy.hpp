@@ -17,4 +17,15 @@ namespace WrapperBase {
 			{ decltype(T::CanRead) {} }->std::same_as<bool> ;
 			{ decltype(T::CanToggle) {} }->std::same_as<bool> ;
 		};
-}
\ No newline at end of file
+
+	/*
+	 * @brief Politique d'accès aux registres d'une broche (GpioBsrrAccess, GpioBitBandAccess).
+	 **/
+	template<typename T>
+		concept GpioAccessPolicy = requires {
+			T::template set<GpioPort::GPIO_A, 1>();
+			T::template reset<GpioPort::GPIO_A, 1>();
+			T::template toggle<GpioPort::GPIO_A, 1>();
+			{ T::template read<GpioPort::GPIO_A, 1>() }->std::same_as<GpioPinState> ;
+		};
+}
@@ -30,6 +30,26 @@ namespace WrapperBase {
 			  { decltype(T::Nss) { } }->std::same_as<Wrapper::SpiNssMode> ;
 			  { decltype(T::Prescaler) { } }->std::same_as<Wrapper::SpiBaudRatePrescaler> ;
 			  { decltype(T::FirstBit) { } }->std::same_as<Wrapper::SpiFirstBit> ;
+			  { decltype(T::TransferMode) { } }->std::same_as<Wrapper::SpiTransferMode> ;
+			  { decltype(T::StreamHalfFrames) { } }->std::same_as<size_t> ;
+
+			  // Flux DMA : full-duplex, deux demi-tampons dans un NDTR 16 bits
+			  requires(T::TransferMode != Wrapper::SpiTransferMode::DmaStream ||
+			          (T::Direction == Wrapper::SpiDirection::FullDuplex &&
+			           T::StreamHalfFrames > 0 && T::StreamHalfFrames <= 32767)) ;
+		};
+
+	template<typename T>
+		concept SpiDeviceConfigPolicy = requires(T policy) {
+			// Chip select : broche GPIO en sortie
+			requires GpioConfigPolicy<typename T::CsPin> ;
+			requires T::CsPin::Mode == GpioPinMode::Output ;
+
+			{ decltype(T::ClockPolarity) { } }->std::same_as<Wrapper::SpiClockPolarity> ;
+			{ decltype(T::ClockPhase) { } }->std::same_as<Wrapper::SpiClockPhase> ;
+			{ decltype(T::Prescaler) { } }->std::same_as<Wrapper::SpiBaudRatePrescaler> ;
+			{ decltype(T::FirstBit) { } }->std::same_as<Wrapper::SpiFirstBit> ;
+			{ decltype(T::DataSize) { } }->std::same_as<Wrapper::SpiDataSize> ;
 		};
 
 } // namespace WrapperBase
\ No newline at end of file
@@ -1,20 +1,27 @@
 #pragma once
 
 #include "UartEnumsStructs.hpp"
+#include "GpioConfigPolicy.hpp" // Pour valider les types de Pin
 #include <concepts>
+#include <type_traits>
 
 namespace WrapperBase {
 	template<typename T>
 		concept UartConfigPolicy = requires(T policy) {
-			{ decltype(T::TxPin) {} }->std::same_as<GpioStaticConfig>;
-			{ decltype(T::RxPin) {} }->std::same_as<GpioStaticConfig>;
-			{ decltype(T::Port) { } }->std::same_as<UartPort>;
+			// Vérifie que TxPin et RxPin sont des GpioStaticConfig valides
+			requires GpioConfigPolicy<typename T::TxPin> ;
+			requires GpioConfigPolicy<typename T::RxPin> ;
+			// Broche DE optionnelle (RS-485)
+			requires std::is_void_v<typename T::DePin> || GpioConfigPolicy<typename T::DePin> ;
+
+			{ decltype(T::Port) { } }->std::same_as<Wrapper::UartPort>;
 			{ decltype(T::BaudRate) {} }->std::same_as<uint32_t>;
-			{ decltype(T::WordLength) {} }->std::same_as<UartWordLength>;
-			{ decltype(T::StopBits) {} }->std::same_as<UartStopBits>;
-			{ decltype(T::Parity) {} }->std::same_as<UartParity>;
-			{ decltype(T::Mode) {} }->std::same_as<UartMode>;
-			{ decltype(T::HwControl) {} }->std::same_as<UartHwControl>;
-			{ decltype(T::UartOversampling) {} }->std::same_as<Oversampling>;
+			{ decltype(T::WordLength) {} }->std::same_as<Wrapper::UartWordLength>;
+			{ decltype(T::StopBits) {} }->std::same_as<Wrapper::UartStopBits>;
+			{ decltype(T::Parity) {} }->std::same_as<Wrapper::UartParity>;
+			{ decltype(T::Mode) {} }->std::same_as<Wrapper::UartMode>;
+			{ decltype(T::HwControl) {} }->std::same_as<Wrapper::UartHwControl>;
+			{ decltype(T::Oversampling) {} }->std::same_as<Wrapper::UartOversampling>;
+			{ decltype(T::RxDmaBufferSize) {} }->std::same_as<size_t>;
 		};
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Wrapper {
+
+	/*
+	 * @brief Codes fonction Modbus pris en charge.
+	 **/
+	enum class ModbusFunction : uint8_t {
+		ReadCoils              = 0x01,
+		ReadDiscreteInputs     = 0x02,
+		ReadHoldingRegisters   = 0x03,
+		ReadInputRegisters     = 0x04,
+		WriteSingleCoil        = 0x05,
+		WriteSingleRegister    = 0x06,
+		WriteMultipleCoils     = 0x0F,
+		WriteMultipleRegisters = 0x10,
+	};
+
+	/*
+	 * @brief Codes d'exception Modbus (réponse : code fonction | 0x80, puis ce code).
+	 **/
+	enum class ModbusException : uint8_t {
+		None                = 0x00,
+		IllegalFunction     = 0x01,
+		IllegalDataAddress  = 0x02,
+		IllegalDataValue    = 0x03,
+		ServerDeviceFailure = 0x04,
+	};
+
+	/*
+	 * @brief Table de données d'un esclave, pour la notification d'écriture.
+	 **/
+	enum class ModbusTable : uint8_t {
+		Coils,
+		DiscreteInputs,
+		HoldingRegisters,
+		InputRegisters,
+	};
+
+	/*
+	 * @brief Issue d'une transaction maître.
+	 **/
+	enum class ModbusStatus : uint8_t {
+		Ok,
+		Exception,    // L'esclave a répondu par une exception (voir ModbusResult::exception)
+		Timeout,
+		BadResponse,  // Réponse d'un autre esclave, d'une autre fonction ou de taille incohérente
+	};
+
+	struct ModbusResult {
+		ModbusStatus status;
+		ModbusException exception;
+	};
+
+	/*
+	 * @brief Compteurs de la liaison RTU (cumulés).
+	 * gapErrors : trame interrompue par un silence de plus d'un caractère (t1.5, voir ModbusRtuLink).
+	 **/
+	struct ModbusLinkStats {
+		uint32_t frames;
+		uint32_t crcErrors;
+		uint32_t gapErrors;
+		uint32_t overflows;
+	};
+
+} // namespace Wrapper
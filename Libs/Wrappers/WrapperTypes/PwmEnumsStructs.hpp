@@ -10,19 +10,21 @@ namespace WrapperBase {
 	/// @brief Énumération des instances de Timer disponibles.
 	/// (Liste pour STM32F407)
 	/// </summary>
+	/// Les noms suivent la convention des autres ports (USART_1, SPI_1...) :
+	/// "TIM1" seul entrerait en collision avec la macro CMSIS du même nom.
 	enum class PwmTimerInstance {
-		TIM1,
-		TIM2,
-		TIM3,
-		TIM4,
-		TIM5,
-		TIM8,
-		TIM9,
-		TIM10,
-		TIM11,
-		TIM12,
-		TIM13,
-		TIM14
+		TIM_1,
+		TIM_2,
+		TIM_3,
+		TIM_4,
+		TIM_5,
+		TIM_8,
+		TIM_9,
+		TIM_10,
+		TIM_11,
+		TIM_12,
+		TIM_13,
+		TIM_14
 	};
 
 	/// <summary>
@@ -58,7 +60,7 @@ namespace WrapperBase {
 	 * @tparam T_GpioPolicy Une politique de configuration GPIO (doit être GpioConfigPolicy)
 	 * Cette policy DOIT configurer la broche en Mode::AlternateFunction
 	 * et avec le bon GpioAF (ex: GpioAlternateFunctionType::AF1_TIM2)
-	 * @tparam timer Instance du timer (ex: PwmTimerInstance::TIM2)
+	 * @tparam timer Instance du timer (ex: PwmTimerInstance::TIM_2)
 	 * @tparam channel Canal du timer (ex: PwmTimerChannel::Channel1)
 	 * @tparam prescaler Valeur du prescaler (PSC)
 	 * @tparam period Valeur de l'auto-reload (ARR) (définit la fréquence)
@@ -1,6 +1,7 @@
 // SpiEnumsStructs.hpp
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include "stm32f4xx_hal.h"
 #include "GpioEnumsStructs.hpp" // Pour la composition
@@ -72,6 +73,12 @@ namespace Wrapper {
 		LSBFirst
 	};
 
+	/// @brief Mode de transfert du port.
+	enum class SpiTransferMode {
+		Standard,  // Transferts bloquants / IT à la demande (HAL)
+		DmaStream  // Full-duplex continu par DMA circulaire sur deux demi-tampons (SpiStatic::start_stream)
+	};
+
 	/**
 	 * @brief Structure de configuration statique pour un périphérique SPI.
 	 * @tparam SckPinConfig  Broche GPIO pour SCK (Horloge)
@@ -79,6 +86,8 @@ namespace Wrapper {
 	 * @tparam MosiPinConfig Broche GPIO pour MOSI (Master Out Slave In)
 	 * @tparam NssPinConfig  Broche GPIO pour NSS (Hardware Mode)
 	 * Mettre 'void' si SpiNssMode::Software est utilisé.
+	 * @tparam transferMode DmaStream : flux continu, le port est réservé au flux tant qu'il tourne.
+	 * @tparam streamHalfFrames Trames (8 ou 16 bits selon dataSize) par demi-tampon en DmaStream.
 	 * @note Les broches GPIO doivent être en Mode AlternateFunction avec le bon AF mapping.
 	 */
 	template <
@@ -94,7 +103,9 @@ namespace Wrapper {
 	    SpiClockPhase cpha = SpiClockPhase::Edge1,
 	    SpiNssMode nss = SpiNssMode::Software,
 	    SpiBaudRatePrescaler prescaler = SpiBaudRatePrescaler::Prescaler16,
-	    SpiFirstBit firstBit = SpiFirstBit::MSBFirst
+	    SpiFirstBit firstBit = SpiFirstBit::MSBFirst,
+	    SpiTransferMode transferMode = SpiTransferMode::Standard,
+	    size_t streamHalfFrames = 0
 	>
 		struct SpiStaticConfig {
 			using SckPin  = SckPinConfig;
@@ -111,6 +122,32 @@ namespace Wrapper {
 			static constexpr SpiNssMode Nss = nss;
 			static constexpr SpiBaudRatePrescaler Prescaler = prescaler;
 			static constexpr SpiFirstBit FirstBit = firstBit;
+			static constexpr SpiTransferMode TransferMode = transferMode;
+			static constexpr size_t StreamHalfFrames = streamHalfFrames;
+		};
+
+	/**
+	 * @brief Configuration statique d'un périphérique sur un bus SPI partagé (SpiBus).
+	 * @tparam CsPinConfig Broche GPIO de chip select, en sortie, active à l'état bas.
+	 * Les réglages sont propres au périphérique : le bus ne reprogramme CR1 que s'ils diffèrent
+	 * de ceux de la transaction précédente.
+	 **/
+	template <
+	    typename CsPinConfig,
+	    SpiClockPolarity cpol = SpiClockPolarity::Low,
+	    SpiClockPhase cpha = SpiClockPhase::Edge1,
+	    SpiBaudRatePrescaler prescaler = SpiBaudRatePrescaler::Prescaler16,
+	    SpiFirstBit firstBit = SpiFirstBit::MSBFirst,
+	    SpiDataSize dataSize = SpiDataSize::Data8Bit
+	>
+		struct SpiDeviceConfig {
+			using CsPin = CsPinConfig;
+
+			static constexpr SpiClockPolarity ClockPolarity = cpol;
+			static constexpr SpiClockPhase ClockPhase = cpha;
+			static constexpr SpiBaudRatePrescaler Prescaler = prescaler;
+			static constexpr SpiFirstBit FirstBit = firstBit;
+			static constexpr SpiDataSize DataSize = dataSize;
 		};
 
 } // namespace Wrapper
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include "stm32f4xx_hal.h"
 #include "GpioEnumsStructs.hpp" // Important pour la composition
@@ -75,6 +76,9 @@ namespace Wrapper {
 	 * @brief Structure de configuration statique pour un périphérique UART.
 	 * @tparam TxPinConfig Configuration statique de la broche GPIO pour Tx.
 	 * @tparam RxPinConfig Configuration statique de la broche GPIO pour Rx.
+	 * @tparam rxDmaBufferSize Taille du tampon de réception DMA circulaire (0 : pas de réception continue).
+	 * @tparam DePinConfig Broche DE (driver enable) d'un transceiver RS-485, active à l'état haut,
+	 *         en sortie push-pull ; void : pas de RS-485.
 	 * @note Les configurations GPIO doivent être en mode AlternateFunction avec le bon AF mapping.
 	 **/
 	template <
@@ -87,11 +91,14 @@ namespace Wrapper {
 	    UartParity parity = UartParity::None,
 	    UartMode mode = UartMode::TxRx,
 	    UartHwControl hwControl = UartHwControl::None,
-		UartOversampling oversampling = UartOversampling::OverSampling_16
+		UartOversampling oversampling = UartOversampling::OverSampling_16,
+		size_t rxDmaBufferSize = 0,
+		typename DePinConfig = void
 	>
 		struct UartStaticConfig {
 			using TxPin = TxPinConfig;
 			using RxPin = RxPinConfig;
+			using DePin = DePinConfig;
 
 			static constexpr UartPort Port = port;
 			static constexpr uint32_t BaudRate = baudrate;
@@ -100,7 +107,8 @@ namespace Wrapper {
 			static constexpr UartParity Parity = parity;
 			static constexpr UartMode Mode = mode;
 			static constexpr UartHwControl HwControl = hwControl;
-			static constexpr UartOversampling Oversampling = UartOversampling::OverSampling_16;
+			static constexpr UartOversampling Oversampling = oversampling;
+			static constexpr size_t RxDmaBufferSize = rxDmaBufferSize;
         
 		};
 
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+"""Décodeur du journal binaire (Libs/Logging/Log.hpp).
+
+Lit le flux brut émis par la cible (fichier capturé, port série ou stdin) et reconstruit le texte à
+partir des descripteurs de sites de log présents dans l'ELF (section .logfmt, ou .rodata pour les
+sites placés dans des templates).
+
+    log_decode.py build/KhaNeSystems.elf capture.bin
+    log_decode.py build/KhaNeSystems.elf /dev/ttyACM0 --baud 921600 --clock-hz 168000000
+
+Enregistrement : [adresse du descripteur][CYCCNT][arguments...], mots de 32 bits petit-boutistes.
+Descripteur : "niveau\\0fichier\\0ligne\\0format\\0".
+Un mot qui n'est pas l'adresse d'un descripteur connu fait avancer la lecture d'un octet (resynchronisation).
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+LEVELS = {"D": "DEBUG", "I": "INFO ", "W": "WARN ", "E": "ERROR"}
+
+SHF_ALLOC = 0x2
+
+# Spécification printf : drapeaux, largeur, précision, modificateur de longueur, conversion
+SPEC = re.compile(r"%([-+ #0]*)(\d+)?(\.\d+)?(hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgGaA%])")
+
+
+class Elf:
+    """Lecteur ELF minimal : sections et lecture d'octets par adresse."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} : pas un fichier ELF")
+        is64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x3A)
+            header = endian + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x2E)
+            header = endian + "IIIIIIIIII"
+
+        raw = []
+        for i in range(shnum):
+            name, kind, flags, addr, offset, size = struct.unpack_from(header, data, shoff + i * shentsize)[:6]
+            raw.append((name, kind, flags, addr, offset, size))
+        strtab = raw[shstrndx]
+
+        self.sections = []
+        for name, kind, flags, addr, offset, size in raw:
+            end = data.index(b"\0", strtab[4] + name)
+            label = data[strtab[4] + name:end].decode("ascii", "replace")
+            loaded = kind != 8  # SHT_NOBITS : pas de contenu dans le fichier
+            if loaded and size and ((flags & SHF_ALLOC) or label.startswith(".logfmt")):
+                self.sections.append((label, addr, data[offset:offset + size]))
+        # .logfmt en premier : commence à l'adresse 0 et ne doit pas être masquée par une autre section
+        self.sections.sort(key=lambda s: not s[0].startswith(".logfmt"))
+
+    def find(self, address):
+        for label, base, content in self.sections:
+            if base <= address < base + len(content):
+                return label, content, address - base
+        return None
+
+    def string(self, address, limit=512):
+        found = self.find(address)
+        if found is None:
+            return None
+        _, content, offset = found
+        end = content.find(b"\0", offset, offset + limit)
+        if end < 0:
+            return None
+        return content[offset:end].decode("utf-8", "replace")
+
+
+class Site:
+    """Site de log : niveau, emplacement, format converti pour Python et lecteurs d'arguments."""
+
+    def __init__(self, level, file, line, fmt):
+        self.level = level
+        self.file = os.path.basename(file)
+        self.line = line
+        self.fmt = fmt
+        self.args = []  # (type, mots)
+        self.pyfmt = SPEC.sub(self._convert, fmt.replace("%%", "\x00")).replace("\x00", "%%")
+
+    def _convert(self, match):
+        flags, width, precision, length, conv = match.groups()
+        spec = "%" + (flags or "") + (width or "") + (precision or "")
+        if conv in "di":
+            self.args.append(("i64" if length in ("ll", "j") else "i32", 2 if length in ("ll", "j") else 1))
+            return spec + "d"
+        if conv in "ouxXc":
+            self.args.append(("u64" if length in ("ll", "j") else "u32", 2 if length in ("ll", "j") else 1))
+            return spec + conv
+        if conv == "p":
+            self.args.append(("u32", 1))
+            return "0x%08x"
+        if conv == "s":
+            self.args.append(("str", 1))
+            return spec + "s"
+        if conv in "aA":
+            self.args.append(("hex", 1))
+            return spec + "s"
+        self.args.append(("f32", 1))
+        return spec + conv
+
+    @property
+    def words(self):
+        return 2 + sum(count for _, count in self.args)
+
+
+class Decoder:
+    def __init__(self, elf, clock_hz):
+        self.elf = elf
+        self.clock_hz = clock_hz
+        self.sites = {}
+        self.buffer = bytearray()
+        self.last_cycles = None
+        self.elapsed = 0
+        self.skipped = 0
+
+    def site(self, address):
+        if address in self.sites:
+            return self.sites[address]
+        site = None
+        found = self.elf.find(address)
+        # Un descripteur suit toujours un NUL (ou commence sa section) : écarte les adresses au milieu d'une chaîne
+        if found is not None and (found[2] == 0 or found[1][found[2] - 1] == 0):
+            fields = []
+            cursor = address
+            for _ in range(4):
+                text = self.elf.string(cursor)
+                if text is None:
+                    break
+                fields.append(text)
+                cursor += len(text.encode("utf-8")) + 1
+            if len(fields) == 4 and fields[0] in LEVELS and fields[2].isdigit():
+                site = Site(fields[0], fields[1], int(fields[2]), fields[3])
+        self.sites[address] = site
+        return site
+
+    def feed(self, data):
+        self.buffer += data
+        lines = []
+        while len(self.buffer) >= 8:
+            address, = struct.unpack_from("<I", self.buffer, 0)
+            site = self.site(address)
+            if site is None:
+                del self.buffer[0]
+                self.skipped += 1
+                continue
+            if len(self.buffer) < site.words * 4:
+                break
+            words = struct.unpack_from(f"<{site.words}I", self.buffer, 0)
+            del self.buffer[:site.words * 4]
+            if self.skipped:
+                lines.append(f"<{self.skipped} octets ignorés>")
+                self.skipped = 0
+            lines.append(self.render(site, words[1], words[2:]))
+        return lines
+
+    def render(self, site, cycles, words):
+        # CYCCNT reboucle sur 32 bits : on cumule les écarts
+        if self.last_cycles is not None:
+            self.elapsed += (cycles - self.last_cycles) & 0xFFFFFFFF
+        self.last_cycles = cycles
+        values = []
+        index = 0
+        for kind, count in site.args:
+            if count == 2:
+                raw = words[index] | (words[index + 1] << 32)
+                values.append(raw - (1 << 64) if kind == "i64" and raw >> 63 else raw)
+            else:
+                raw = words[index]
+                if kind == "i32":
+                    values.append(raw - (1 << 32) if raw >> 31 else raw)
+                elif kind == "f32":
+                    values.append(struct.unpack("<f", struct.pack("<I", raw))[0])
+                elif kind == "hex":
+                    values.append(struct.unpack("<f", struct.pack("<I", raw))[0].hex())
+                elif kind == "str":
+                    text = self.elf.string(raw)
+                    values.append(text if text is not None else f"<0x{raw:08x}>")
+                else:
+                    values.append(raw)
+            index += count
+        try:
+            text = site.pyfmt % tuple(values)
+        except (TypeError, ValueError) as error:
+            text = f"{site.fmt} {values} <{error}>"
+        return f"[{self.elapsed / self.clock_hz:12.6f}] {LEVELS[site.level]} {site.file}:{site.line}  {text}"
+
+
+def open_input(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+        return serial.Serial(path, baud, timeout=0.1)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Décode le journal binaire émis par la cible.")
+    parser.add_argument("elf", help="ELF de l'application (même build que la cible)")
+    parser.add_argument("input", help="capture binaire, port série (/dev/tty..., COMx) ou - pour stdin")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--clock-hz", type=float, default=168e6, help="fréquence de CYCCNT (HCLK)")
+    args = parser.parse_args()
+
+    decoder = Decoder(Elf(args.elf), args.clock_hz)
+    stream = open_input(args.input, args.baud)
+    try:
+        while True:
+            chunk = stream.read(4096)
+            if not chunk:
+                if hasattr(stream, "in_waiting"):
+                    continue  # Port série : attente de données
+                break
+            for line in decoder.feed(chunk):
+                print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,243 @@
+/*
+ * Contrôle hôte de la broche DE RS-485 (Libs/Wrappers/UartDeSequence.hpp) sur un USART simulé.
+ *
+ *     g++ -std=c++20 -I Libs/Wrappers tools/uart_de_check.cpp -o uart_de_check && ./uart_de_check
+ *
+ * L'USART simulé reproduit ce dont dépend le retournement (RM0090 30.6.1) : DR et registre à décalage,
+ * TXE, TC levé quand le dernier bit de stop est sorti et DR vide, TC effacé seulement par écriture de 0
+ * (les écritures DMA dans DR ne l'effacent pas), IRQ sur TC & TCIE après une latence d'entrée.
+ * La file reproduit le contrat de UartTxQueue : drive() avant le premier bloc d'une rafale, TC effacé au
+ * départ de chaque bloc (HalUartTxDma::start), release() quand le DMA a lu le dernier octet et que la
+ * file est vide.
+ *
+ * Vérifié pour chaque impulsion DE : levée avant le premier bit de start, aucun octet hors impulsion,
+ * retombée après le bit de stop du dernier octet et au plus une latence d'IRQ plus tard.
+ * Le témoin négatif (TC non effacé au départ des blocs) doit être détecté comme retombée anticipée.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+#include "UartDeSequence.hpp"
+
+namespace {
+
+	constexpr uint64_t StepNs = 100;
+
+	struct UsartSim {
+		uint64_t bitNs = 8681;        // 115200 bauds
+		uint64_t irqLatencyNs = 600;  // ~100 cycles à 168 MHz
+		bool clearTcOnStart = true;
+
+		uint64_t now = 0;
+		bool tdrFull = false;
+		bool shifting = false;
+		uint64_t shiftEnd = 0;
+		bool tc = true;               // Levé après l'activation de TE (trame d'inactivité)
+		bool tcie = false;
+		bool de = false;
+		uint64_t irqSince = UINT64_MAX;
+
+		struct Byte { uint64_t start; uint64_t stopEnd; bool deAtStart; };
+		std::vector<Byte> bytes;
+		std::vector<uint64_t> rises;
+		std::vector<uint64_t> falls;
+
+		void set_de(bool high) {
+			if (high != de)
+				(high ? rises : falls).push_back(now);
+			de = high;
+		}
+	};
+
+	UsartSim* g_usart = nullptr;
+
+	struct SimLine {
+		static void set_de(bool high) { g_usart->set_de(high); }
+		static void set_tcie(bool enabled) { g_usart->tcie = enabled; }
+		static bool tcie() { return g_usart->tcie; }
+		static bool tc() { return g_usart->tc; }
+	};
+
+	using Sequence = Wrapper::UartDeSequence<SimLine>;
+
+	// File d'émission : blocs DMA, rafale tant que la file n'est pas vide
+	struct QueueSim {
+		UsartSim& usart;
+		std::vector<uint16_t> blocks {};
+		size_t next = 0;
+		uint16_t remaining = 0;       // Octets du bloc en cours pas encore lus par le DMA
+		bool lineDriven = false;
+
+		void send(std::initializer_list<uint16_t> frame) {
+			const bool idle = (remaining == 0 && next == blocks.size());
+			blocks.insert(blocks.end(), frame);
+			if (idle)
+				advance();
+		}
+
+		void advance() {
+			if (next == blocks.size()) {
+				if (lineDriven) {
+					lineDriven = false;
+					Sequence::release();
+				}
+				return;
+			}
+			if (!lineDriven) {
+				lineDriven = true;
+				Sequence::drive();
+			}
+			if (usart.clearTcOnStart)
+				usart.tc = false;
+			remaining = blocks[next++];
+		}
+
+		// Requête DMA sur TXE ; TC du stream quand le dernier octet est écrit dans DR
+		void dma() {
+			if (remaining == 0 || usart.tdrFull)
+				return;
+			usart.tdrFull = true;
+			if (--remaining == 0)
+				advance();
+		}
+	};
+
+	void step(UsartSim& usart, QueueSim& queue) {
+		usart.now += StepNs;
+		if (usart.shifting && usart.now >= usart.shiftEnd) {
+			usart.shifting = false;
+			usart.bytes.back().stopEnd = usart.now;
+			if (!usart.tdrFull)
+				usart.tc = true;
+		}
+		if (!usart.shifting && usart.tdrFull) {
+			usart.tdrFull = false;
+			usart.shifting = true;
+			usart.shiftEnd = usart.now + 10 * usart.bitNs;
+			usart.bytes.push_back({ usart.now, 0, usart.de });
+		}
+		queue.dma();
+		if (usart.tc && usart.tcie) {
+			if (usart.irqSince == UINT64_MAX)
+				usart.irqSince = usart.now;
+			if (usart.now - usart.irqSince >= usart.irqLatencyNs) {
+				Sequence::on_irq();
+				usart.irqSince = UINT64_MAX;
+			}
+		} else {
+			usart.irqSince = UINT64_MAX;
+		}
+	}
+
+	void run_for(UsartSim& usart, QueueSim& queue, uint64_t ns) {
+		for (const uint64_t end = usart.now + ns; usart.now < end;)
+			step(usart, queue);
+	}
+
+	// Impulsions DE contre les octets émis ; message sur stdout pour chaque violation
+	bool verify(const char* name, const UsartSim& usart, size_t expectedPulses) {
+		bool ok = true;
+		auto fail = [&](const char* what, uint64_t at) {
+			std::printf("  %s : %s (t = %.1f us)\n", name, what, double(at) / 1000.0);
+			ok = false;
+		};
+		if (usart.rises.size() != expectedPulses || usart.falls.size() != expectedPulses) {
+			std::printf("  %s : %zu impulsions DE, %zu attendues\n", name, usart.falls.size(), expectedPulses);
+			return false;
+		}
+		uint64_t worstTurnaround = 0;
+		for (size_t pulse = 0; pulse < expectedPulses; ++pulse) {
+			const uint64_t rise = usart.rises[pulse];
+			const uint64_t fall = usart.falls[pulse];
+			uint64_t lastStopEnd = 0;
+			for (const auto& byte : usart.bytes) {
+				if (byte.start < rise || byte.start > fall)
+					continue;
+				if (!byte.deAtStart)
+					fail("bit de start sans DE", byte.start);
+				if (byte.stopEnd == 0 || byte.stopEnd > fall)
+					fail("DE retombé avant la fin du bit de stop", fall);
+				lastStopEnd = byte.stopEnd > lastStopEnd ? byte.stopEnd : lastStopEnd;
+			}
+			if (lastStopEnd == 0) {
+				fail("impulsion DE sans octet", rise);
+				continue;
+			}
+			if (fall < lastStopEnd)
+				continue; // Déjà signalé
+			const uint64_t turnaround = fall - lastStopEnd;
+			if (turnaround > usart.irqLatencyNs + StepNs)
+				fail("DE retombé trop tard après TC", fall);
+			worstTurnaround = turnaround > worstTurnaround ? turnaround : worstTurnaround;
+		}
+		for (const auto& byte : usart.bytes)
+			if (!byte.deAtStart)
+				fail("octet émis hors impulsion DE", byte.start);
+		std::printf("%-34s %s  %zu octets, %zu impulsion(s), retournement max %.2f us\n", name, ok ? "OK   " : "ECHEC",
+			usart.bytes.size(), expectedPulses, double(worstTurnaround) / 1000.0);
+		return ok;
+	}
+
+	struct Scenario {
+		UsartSim usart {};
+		QueueSim queue { usart };
+		Scenario() {
+			g_usart = &usart;
+			Sequence::drop();
+		}
+	};
+
+} // namespace
+
+int main() {
+	bool ok = true;
+
+	{
+		Scenario s;
+		s.queue.send({ 4, 32, 2 }); // En-tête, charge, CRC : une trame en trois blocs
+		run_for(s.usart, s.queue, 5'000'000);
+		ok &= verify("trame en trois blocs", s.usart, 1);
+	}
+	{
+		Scenario s;
+		s.queue.send({ 8 });
+		s.queue.send({ 1 });
+		s.queue.send({ 16, 2 }); // Poussées pendant l'émission : une seule rafale
+		run_for(s.usart, s.queue, 5'000'000);
+		ok &= verify("trames enchaînées", s.usart, 1);
+	}
+	{
+		Scenario s;
+		s.queue.send({ 6 });
+		// Dernier octet lu par le DMA, libération en attente : nouvelle trame avant TC
+		while (!Sequence::release_pending())
+			step(s.usart, s.queue);
+		run_for(s.usart, s.queue, 4 * s.usart.bitNs);
+		s.queue.send({ 3 });
+		run_for(s.usart, s.queue, 5'000'000);
+		ok &= verify("trame pendant la libération", s.usart, 1);
+	}
+	{
+		Scenario s;
+		s.queue.send({ 5 });
+		run_for(s.usart, s.queue, 2'000'000);
+		s.queue.send({ 1 });
+		run_for(s.usart, s.queue, 2'000'000);
+		ok &= verify("deux rafales séparées", s.usart, 2);
+	}
+	{
+		// Témoin : sans effacement de TC au départ des blocs, le TC resté levé fait retomber DE trop tôt
+		Scenario s;
+		s.usart.clearTcOnStart = false;
+		s.queue.send({ 4, 32, 2 });
+		run_for(s.usart, s.queue, 5'000'000);
+		std::printf("témoin négatif (TC non effacé) :\n");
+		const bool detected = !verify("  TC non effacé", s.usart, 1);
+		std::printf("%-34s %s\n", "témoin négatif détecté", detected ? "OK   " : "ECHEC");
+		ok &= detected;
+	}
+
+	return ok ? 0 : 1;
+}